@@ -25,6 +25,7 @@ namespace Hypertable.Test
     using System.Collections.Generic;
     using System.Text;
     using System.Threading;
+    using System.Threading.Tasks;
 
     using Hypertable;
 
@@ -370,6 +371,80 @@ namespace Hypertable.Test
             }
         }
 
+        [TestMethod]
+        public void ScanTableScanBlockAsync() {
+            if (!HasAsyncTableScanner) {
+                return;
+            }
+
+            var param = new object();
+            var c = 0;
+            using (var asyncResult = new AsyncResult()) {
+                table.BeginBlockScan(
+                    asyncResult,
+                    null,
+                    param,
+                    (ctx, block) =>
+                        {
+                            Assert.AreSame(param, ctx.Param);
+                            for (var n = 0; n < block.Count; ++n) {
+                                var value = block.GetValue(n);
+                                Assert.AreEqual(block.GetRow(n), Encoding.GetString(value.Array, value.Offset, value.Count));
+                                ++c;
+                            }
+
+                            return AsyncCallbackResult.Continue;
+                        });
+
+                asyncResult.Join();
+                Assert.IsNull(asyncResult.Error, asyncResult.Error != null ? asyncResult.Error.ToString() : string.Empty);
+                Assert.IsTrue(asyncResult.IsCompleted);
+                Assert.AreEqual(CountA + CountB + CountC, c);
+            }
+        }
+
+        [TestMethod]
+        public void ScanTableRowAsync() {
+            if (!HasAsyncTableScanner) {
+                return;
+            }
+
+            var rows = new HashSet<string>();
+            using (var scanner = new RowScanner(table.CreateScanner())) {
+                foreach (var row in scanner) {
+                    rows.Add(row.RowKey);
+                }
+            }
+
+            var param = new object();
+            var c = 0;
+            var scannedRows = new HashSet<string>();
+            using (var asyncResult = new AsyncResult()) {
+                table.BeginRowScan(
+                    asyncResult,
+                    null,
+                    param,
+                    (ctx, row) =>
+                        {
+                            Assert.AreSame(param, ctx.Param);
+                            Assert.IsTrue(scannedRows.Add(row.RowKey), row.RowKey);
+                            for (var n = 0; n < row.Count; ++n) {
+                                var value = row.GetValue(n);
+                                Assert.AreEqual(row.RowKey, Encoding.GetString(value.Array, value.Offset, value.Count));
+                                ++c;
+                            }
+
+                            return AsyncCallbackResult.Continue;
+                        });
+
+                asyncResult.Join();
+                Assert.IsNull(asyncResult.Error, asyncResult.Error != null ? asyncResult.Error.ToString() : string.Empty);
+                Assert.IsTrue(asyncResult.IsCompleted);
+                Assert.AreEqual(CountA + CountB + CountC, c);
+                Assert.AreEqual(rows.Count, scannedRows.Count);
+            }
+        }
+
         [TestMethod]
         public void ScanTableBlockingAsync() {
             if (!HasAsyncTableScanner) {
@@ -860,6 +935,72 @@ namespace Hypertable.Test
             }
         }
 
+#if NETCORE
+        [TestMethod]
+        public async Task ScanTableEnumerateAsync() {
+            if (!HasAsyncTableScanner) {
+                return;
+            }
+
+            var c = 0;
+            await foreach (var cell in table.ScanAsync(null, CancellationToken.None)) {
+                Assert.AreEqual(cell.Key.Row, Encoding.GetString(cell.Value));
+                ++c;
+            }
+
+            Assert.AreEqual(CountA + CountB + CountC, c);
+
+            c = 0;
+            var b = 0;
+            await foreach (var cells in table.ScanBatchesAsync(new ScanSpec().AddColumn("b"), CancellationToken.None)) {
+                Assert.IsTrue(cells.Count > 0);
+                foreach (var cell in cells) {
+                    Assert.AreEqual("b", cell.Key.ColumnFamily);
+                    ++c;
+                }
+
+                ++b;
+            }
+
+            Assert.AreEqual(CountB, c);
+            Assert.IsTrue(b > 0);
+
+            c = 0;
+            await foreach (var cell in table.ScanAsync(new ScanSpec { ConsumerTimeout = TimeSpan.FromSeconds(30) }, CancellationToken.None)) {
+                ++c;
+            }
+
+            Assert.AreEqual(CountA + CountB + CountC, c);
+
+            c = 0;
+            using (var cts = new CancellationTokenSource()) {
+                try {
+                    await foreach (var cell in table.ScanAsync(null, cts.Token)) {
+                        if (++c == CountC) {
+                            cts.Cancel();
+                        }
+                    }
+
+                    Assert.Fail();
+                }
+                catch (OperationCanceledException) {
+                }
+            }
+
+            Assert.AreEqual(CountC, c);
+
+            c = 0;
+            await foreach (var cell in table.ScanAsync(new ScanSpec { MaxRows = CountC }.AddColumn("a"), CancellationToken.None)) {
+                ++c;
+                if (c == CountC / 2) {
+                    break;
+                }
+            }
+
+            Assert.AreEqual(CountC / 2, c);
+        }
+
+#endif
         [TestMethod]
         public void ScanTableKeyOnlyAsync() {
             if (!HasAsyncTableScanner) {
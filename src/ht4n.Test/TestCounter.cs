@@ -67,6 +67,82 @@ namespace Hypertable.Test
             table = EnsureTable(typeof(TestCounter), Schema);
         }
 
+        [TestMethod]
+        public void AggregateCounter()
+        {
+            if (!HasCounterColumn)
+            {
+                return;
+            }
+
+            var keyA = new Key { ColumnFamily = "a", Row = "AGGREGATE" };
+            var keyB = new Key { ColumnFamily = "b", Row = "AGGREGATE" };
+
+            this.SetCounterValue(keyA, 0);
+            this.SetCounterValue(keyB, 0);
+
+            const int Count = 100000;
+            using (var mutator = table.CreateMutator())
+            {
+                using (var aggregator = new CounterAggregator(Context, mutator))
+                {
+                    System.Threading.Tasks.Parallel.For(0, Count, i =>
+                    {
+                        aggregator.Increment(keyA, 1);
+                        aggregator.Decrement(keyB, 2);
+                    });
+
+                    Assert.AreEqual(2, aggregator.Count);
+                    aggregator.Flush();
+
+                    this.GetCounterValue(keyA, Count);
+                    this.GetCounterValue(keyB, -2 * Count);
+
+                    // idle counters are evicted on the next flush
+                    Assert.AreEqual(2, aggregator.Count);
+                    aggregator.Flush();
+                    Assert.AreEqual(0, aggregator.Count);
+
+                    aggregator.Increment(keyA, 5);
+                    aggregator.ResetCounter(keyA, 10);
+                    aggregator.Increment(keyA, 3);
+                    aggregator.Increment(keyB, 2 * Count);
+                }
+            }
+
+            this.GetCounterValue(keyA, 13);
+            this.GetCounterValue(keyB, 0);
+        }
+
+        [TestMethod]
+        public void CoalesceCounter()
+        {
+            if (!HasCounterColumn)
+            {
+                return;
+            }
+
+            var key = new Key { ColumnFamily = "a", Row = "COALESCE" };
+            const int Count = 1000;
+            foreach (var mutatorSpec in new[] { new MutatorSpec(MutatorKind.Chunked) { Coalesce = true }, new MutatorSpec { Queued = true, Coalesce = true } })
+            {
+                var counter = this.SetCounterValue(key, 0);
+                using (var mutator = table.CreateMutator(mutatorSpec))
+                {
+                    for (var i = 0; i < Count; ++i)
+                    {
+                        counter.IncrementCounter(1);
+                        mutator.Set(counter.ToCell());
+                    }
+
+                    mutator.Flush();
+                    Assert.AreEqual(0L, mutator.Statistics.ElidedCells);
+                }
+
+                this.GetCounterValue(key, Count);
+            }
+        }
+
         [TestMethod]
         public void IncrementDecrementCounter()
         {
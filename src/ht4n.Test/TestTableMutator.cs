@@ -23,8 +23,12 @@ namespace Hypertable.Test
 {
     using System;
     using System.Collections.Generic;
+    using System.Diagnostics;
+    using System.Globalization;
+    using System.Linq;
     using System.Text;
     using System.Threading;
+    using System.Threading.Tasks;
 
     using Hypertable;
 
@@ -44,6 +48,8 @@ namespace Hypertable.Test
 
         private static readonly MutatorSpec ChunkedQueuedMutatorSpec = new MutatorSpec(MutatorKind.Chunked) { Queued = true, Capacity = 200 };
 
+        private static readonly MutatorSpec StripedMutatorSpec = new MutatorSpec(MutatorKind.Striped) { MaxCellCount = 64 };
+
         private static readonly UTF8Encoding Encoding = new UTF8Encoding();
 
         private static ITable table;
@@ -76,6 +82,86 @@ namespace Hypertable.Test
             }
         }
 
+        [TestMethod]
+        public void BulkLoad() {
+            var sb = new StringBuilder();
+            sb.Append("#row\tcolumn\tvalue\n");
+            for (var n = 0; n < Count; ++n) {
+                sb.AppendFormat(CultureInfo.InvariantCulture, "{0:D5}\ta\tvalue {0}\n", n);
+                sb.AppendFormat(CultureInfo.InvariantCulture, "{0:D5}\tb:{0}\tline\\nbreak\r\n", n);
+            }
+
+            sb.Append("malformed\n");
+            sb.Append("\ta\tno row\n");
+            sb.Append("row\t:q\tno column family\n");
+            sb.Append("\n");
+
+            BulkLoadStatistics statistics;
+            using (var stream = new System.IO.MemoryStream(Encoding.GetBytes(sb.ToString()))) {
+                statistics = table.BulkLoad(stream, new BulkLoadOptions { Workers = 4, Mutators = 2, BlockSize = 4096, MaxChunkSize = 1024 });
+            }
+
+            Assert.AreEqual(2 * Count + 3, statistics.Lines);
+            Assert.AreEqual(2 * Count, statistics.Cells);
+            Assert.AreEqual(3, statistics.ParseErrors);
+            Assert.AreEqual(sb.Length, statistics.Bytes);
+            Assert.AreEqual(2 * Count, this.GetCellCount());
+
+            // the header line declares the leading timestamp
+            var timestamped = "#timestamp\trow\tcolumn\tvalue\n2016-01-02 03:04:05.000000001\tts\tc:1\tvalue\n1451703845000000002\tts\tc:2\tvalue\nts\tc:3\tno timestamp\n";
+            using (var stream = new System.IO.MemoryStream(Encoding.GetBytes(timestamped))) {
+                statistics = table.BulkLoad(stream, null);
+            }
+
+            Assert.AreEqual(2, statistics.Cells);
+            Assert.AreEqual(1, statistics.ParseErrors);
+
+            // numeric rows are never taken for timestamps, tabs within unescaped values are retained
+            using (var stream = new System.IO.MemoryStream(Encoding.GetBytes("12345\tc:3\tvalue\twith tab\n"))) {
+                statistics = table.BulkLoad(stream, new BulkLoadOptions { NoEscape = true });
+            }
+
+            Assert.AreEqual(1, statistics.Cells);
+            Assert.AreEqual(0, statistics.ParseErrors);
+            Assert.AreEqual(2 * Count + 3, this.GetCellCount());
+
+            using (var scanner = table.CreateScanner(new ScanSpec().AddColumn("b"))) {
+                var c = 0;
+                Cell cell;
+                while (scanner.Next(out cell)) {
+                    Assert.AreEqual(cell.Key.Row, cell.Key.ColumnQualifier.PadLeft(5, '0'));
+                    Assert.AreEqual("line\nbreak", Encoding.GetString(cell.Value));
+                    ++c;
+                }
+
+                Assert.AreEqual(Count, c);
+            }
+
+            using (var scanner = table.CreateScanner(new ScanSpec().AddColumn("c"))) {
+                Cell cell;
+                Assert.IsTrue(scanner.Next(out cell));
+                Assert.AreEqual("12345", cell.Key.Row);
+                Assert.AreEqual("3", cell.Key.ColumnQualifier);
+                Assert.AreEqual("value\twith tab", Encoding.GetString(cell.Value));
+                Assert.IsTrue(scanner.Next(out cell));
+                Assert.AreEqual(1451703845000000001UL, cell.Key.Timestamp);
+                Assert.IsTrue(scanner.Next(out cell));
+                Assert.AreEqual(1451703845000000002UL, cell.Key.Timestamp);
+                Assert.IsFalse(scanner.Next(out cell));
+            }
+
+            Assert.AreEqual(0, table.BulkLoad(new System.IO.MemoryStream(), null).Cells);
+
+            using (var stream = new System.IO.MemoryStream(Encoding.GetBytes("malformed\nmalformed\n"))) {
+                try {
+                    table.BulkLoad(stream, new BulkLoadOptions { MaxParseErrors = 1 });
+                    Assert.Fail();
+                }
+                catch (System.IO.InvalidDataException) {
+                }
+            }
+        }
+
         [TestMethod]
         public void Delete() {
             this.Delete(null);
@@ -386,6 +472,52 @@ namespace Hypertable.Test
             this.Delete(ChunkedQueuedMutatorSpec);
         }
 
+        [TestMethod]
+        public void DeleteCollectionLarge() {
+            const int Rows = 20000;
+            var rowKeys = new List<string>();
+            using (var mutator = table.CreateMutator()) {
+                var key = new Key();
+                for (var n = 0; n < Rows; ++n) {
+                    key.Row = Guid.NewGuid().ToString();
+                    key.ColumnFamily = "a";
+                    key.ColumnQualifier = "1";
+                    mutator.Set(key, Encoding.GetBytes(key.Row));
+                    key.ColumnFamily = "b";
+                    key.ColumnQualifier = null;
+                    mutator.Set(key, Encoding.GetBytes(key.Row));
+                    rowKeys.Add(key.Row);
+                }
+            }
+
+            Assert.AreEqual(2 * Rows, this.GetCellCount());
+
+            // delete cells, column families and rows in batches exceeding the native delete batch size
+            var keys = new List<Key>();
+            for (var n = 0; n < Rows; ++n) {
+                switch (n % 3) {
+                    case 0:
+                        keys.Add(new Key(rowKeys[n]));
+                        break;
+                    case 1:
+                        keys.Add(new Key(rowKeys[n], "a", "1"));
+                        keys.Add(new Key(rowKeys[n], "b"));
+                        break;
+                    default:
+                        keys.Add(new Key(rowKeys[n], "a"));
+                        keys.Add(new Key(rowKeys[n], "b"));
+                        break;
+                }
+            }
+
+            using (var mutator = table.CreateMutator()) {
+                mutator.Delete(keys.Take(keys.Count / 2));
+                mutator.Delete(keys.Skip(keys.Count / 2).Select(key => new Cell(key, null)).ToList());
+            }
+
+            Assert.AreEqual(0, this.GetCellCount());
+        }
+
         [TestMethod]
         public void DeleteQueued() {
             this.Delete(MutatorSpec.CreateQueued());
@@ -690,6 +822,25 @@ namespace Hypertable.Test
             this.DeleteSet(MutatorSpec.CreateQueued());
         }
 
+#if NETCORE
+        [TestMethod]
+        public void EventCounters() {
+            using (var listener = new CounterListener("cells-written")) {
+                var key = new Key { ColumnFamily = "a" };
+                using (var mutator = table.CreateMutator(ChunkedMutatorSpec)) {
+                    for (var n = 0; n < Count; ++n) {
+                        key.Row = Guid.NewGuid().ToString();
+                        mutator.Set(key, Encoding.GetBytes(key.Row));
+                    }
+                }
+
+                Assert.IsTrue(listener.Received.Wait(TimeSpan.FromSeconds(10)));
+            }
+
+            Assert.AreEqual(Count, this.GetCellCount());
+        }
+
+#endif
         [TestMethod]
         public void Revisions() {
             this.Revisions(null);
@@ -781,6 +932,67 @@ namespace Hypertable.Test
             Assert.AreEqual(Count, this.GetCellCount());
         }
 
+        [TestMethod]
+        public void SetAsync() {
+            this.SetAsync(null);
+        }
+
+        public void SetAsync(MutatorSpec mutatorSpec) {
+            var key = new Key { ColumnFamily = "a" };
+            var cells = new List<Cell>();
+            for (var n = 0; n < Count; ++n) {
+                key.Row = Guid.NewGuid().ToString();
+                cells.Add(new Cell(key, Encoding.GetBytes(key.Row), true));
+            }
+
+            using (var mutator = table.CreateMutator(mutatorSpec)) {
+                var tasks = new List<Task>();
+                for (var n = 0; n < Count; n += 100) {
+                    tasks.Add(mutator.SetAsync(cells.GetRange(n, 100)));
+                }
+
+                Task.WaitAll(tasks.ToArray());
+                Assert.IsTrue(mutator.FlushAsync().Wait(TimeSpan.FromMinutes(1)));
+                Assert.AreEqual(Count, this.GetCellCount());
+            }
+
+            using (var mutator = table.CreateMutator(mutatorSpec)) {
+                using (var cts = new CancellationTokenSource()) {
+                    cts.Cancel();
+                    var task = mutator.FlushAsync(cts.Token);
+                    try {
+                        task.Wait();
+                        Assert.Fail();
+                    }
+                    catch (AggregateException e) {
+                        Assert.IsInstanceOfType(e.InnerException, typeof(TaskCanceledException));
+                    }
+
+                    Assert.IsTrue(task.IsCanceled);
+                }
+            }
+        }
+
+        [TestMethod]
+        public void SetAsyncChunked() {
+            this.SetAsync(ChunkedMutatorSpec);
+        }
+
+        [TestMethod]
+        public void SetAsyncQueued() {
+            this.SetAsync(MutatorSpec.CreateQueued());
+        }
+
+        [TestMethod]
+        public void SetAsyncQueuedConsumers() {
+            this.SetAsync(new MutatorSpec { Queued = true, Consumers = 4 });
+        }
+
+        [TestMethod]
+        public void SetAsyncStriped() {
+            this.SetAsync(StripedMutatorSpec);
+        }
+
         [TestMethod]
         public void SetChunked() {
             this.Set(new MutatorSpec(MutatorKind.Chunked) { FlushEachChunk = true, MaxCellCount = 100 });
@@ -811,16 +1023,171 @@ namespace Hypertable.Test
             Assert.AreEqual(Count, this.GetCellCount());
         }
 
+        [TestMethod]
+        public void SetCollectionBatches() {
+            const int Batches = 2000;
+            var key = new Key { ColumnFamily = "a" };
+            var batches = new List<List<Cell>>();
+            var total = 0;
+            for (var n = 0; n < 10; ++n) {
+                var cells = new List<Cell>();
+                var count = 100 + 40 * n;
+                for (var i = 0; i < count; ++i) {
+                    key.Row = Guid.NewGuid().ToString();
+                    cells.Add(new Cell(key, Encoding.GetBytes(key.Row), true));
+                }
+
+                batches.Add(cells);
+            }
+
+            foreach (var maxBufferedCells in new uint[] { 0, 300, MutatorSpec.MaxBufferedCellsDefault }) {
+                var stopwatch = Stopwatch.StartNew();
+                using (var mutator = table.CreateMutator(new MutatorSpec { MaxBufferedCells = maxBufferedCells })) {
+                    total = 0;
+                    for (var n = 0; n < Batches; ++n) {
+                        var cells = batches[n % batches.Count];
+                        mutator.Set(cells);
+                        total += cells.Count;
+                    }
+
+                    // the native cell buffer is reused unless disabled or exceeded by a batch
+                    if (maxBufferedCells == 0) {
+                        Assert.AreEqual((long)Batches, mutator.Statistics.CellBuffers);
+                    }
+                    else if (maxBufferedCells >= batches.Max(cells => cells.Count)) {
+                        Assert.AreEqual(1L, mutator.Statistics.CellBuffers);
+                    }
+                    else {
+                        Assert.IsTrue(mutator.Statistics.CellBuffers > 1 && mutator.Statistics.CellBuffers < Batches);
+                    }
+                }
+
+                Trace.WriteLine(string.Format(CultureInfo.InvariantCulture, "Set {0} cells in {1} batches (MaxBufferedCells={2}): {3}", total, Batches, maxBufferedCells, stopwatch.Elapsed));
+            }
+
+            var c = 0;
+            using (var scanner = table.CreateScanner(new ScanSpec { MaxVersions = 1 })) {
+                var cell = new Cell();
+                while (scanner.Move(cell)) {
+                    ++c;
+                }
+            }
+
+            Assert.AreEqual(batches.Sum(cells => cells.Count), c);
+        }
+
         [TestMethod]
         public void SetCollectionChunked() {
             this.SetCollection(ChunkedMutatorSpec);
         }
 
+        [TestMethod]
+        public void SetCollectionChunkedAdaptive() {
+            var key = new Key { ColumnFamily = "a" };
+            var cells = new List<Cell>();
+            for (var n = 0; n < Count; ++n) {
+                key.Row = Guid.NewGuid().ToString();
+                cells.Add(new Cell(key, Encoding.GetBytes(key.Row), true));
+            }
+
+            var mutatorSpec = new MutatorSpec(MutatorKind.Chunked) {
+                AdaptiveChunkSize = true,
+                MinChunkSize = 512,
+                MaxChunkSize = 4096,
+                TargetChunkLatency = TimeSpan.FromTicks(1)
+            };
+
+            using (var mutator = table.CreateMutator(mutatorSpec)) {
+                mutator.Set(cells);
+                mutator.Flush();
+
+                var statistics = mutator.Statistics;
+                Assert.IsTrue(statistics.Chunks > 1);
+                Assert.AreEqual(512u, statistics.ChunkSize);
+            }
+
+            Assert.AreEqual(Count, this.GetCellCount());
+        }
+
         [TestMethod]
         public void SetCollectionChunkedQueued() {
             this.SetCollection(ChunkedQueuedMutatorSpec);
         }
 
+        [TestMethod]
+        public void SetCollectionChunkedQueuedConsumers() {
+            this.SetCollection(new MutatorSpec(MutatorKind.Chunked) { Queued = true, Consumers = 4, Capacity = 1000 });
+        }
+
+        [TestMethod]
+        public void SetCollectionChunkedSorted() {
+            var mutatorSpec = new MutatorSpec(MutatorKind.Chunked) { SortChunks = true };
+            this.SetCollection(mutatorSpec);
+
+            Delete(table);
+            var key = new Key { ColumnFamily = "a" };
+            using (var mutator = table.CreateMutator(mutatorSpec)) {
+                for (var n = Count - 1; n >= 0; --n) {
+                    key.Row = n.ToString("D4");
+                    mutator.Set(key, Encoding.GetBytes(key.Row));
+                    if (n % 2 == 0) {
+                        mutator.Delete(key.Row);
+                    }
+                }
+            }
+
+            var rows = new List<string>();
+            using (var scanner = table.CreateScanner()) {
+                var cell = new Cell();
+                while (scanner.Move(cell)) {
+                    Assert.AreEqual(cell.Key.Row, Encoding.GetString(cell.Value));
+                    rows.Add(cell.Key.Row);
+                }
+            }
+
+            Assert.AreEqual(Count / 2, rows.Count);
+            Assert.IsTrue(rows.TrueForAll(row => int.Parse(row) % 2 == 1));
+        }
+
+        [TestMethod]
+        public void SetCollectionCoalescedChunked() {
+            this.SetCollectionCoalesced(new MutatorSpec(MutatorKind.Chunked) { Coalesce = true });
+        }
+
+        [TestMethod]
+        public void SetCollectionCoalescedQueued() {
+            this.SetCollectionCoalesced(new MutatorSpec { Queued = true, Coalesce = true });
+        }
+
+        public void SetCollectionCoalesced(MutatorSpec mutatorSpec) {
+            const int Rows = 10;
+            var cells = new List<Cell>();
+            for (var n = 0; n < Count; ++n) {
+                cells.Add(new Cell(new Key("Row" + (n % Rows), "a"), Encoding.GetBytes(n.ToString())));
+            }
+
+            cells.Add(new Cell(new Key("Row0"), CellFlag.DeleteRow));
+
+            using (var mutator = table.CreateMutator(mutatorSpec)) {
+                mutator.Set(cells);
+                mutator.Flush();
+                Assert.IsTrue(mutator.Statistics.ElidedCells > 0);
+            }
+
+            var values = new Dictionary<string, int>();
+            using (var scanner = table.CreateScanner(new ScanSpec { MaxVersions = 1 })) {
+                var cell = new Cell();
+                while (scanner.Move(cell)) {
+                    values.Add(cell.Key.Row, int.Parse(Encoding.GetString(cell.Value)));
+                }
+            }
+
+            Assert.AreEqual(Rows - 1, values.Count);
+            for (var r = 1; r < Rows; ++r) {
+                Assert.AreEqual(Count - Rows + r, values["Row" + r]);
+            }
+        }
+
         [TestMethod]
         public void SetCollectionCreateKey() {
             this.SetCollectionCreateKey(null);
@@ -1011,6 +1378,65 @@ namespace Hypertable.Test
             this.SetCollection(MutatorSpec.CreateQueued());
         }
 
+        [TestMethod]
+        public void SetCollectionQueuedBatches() {
+            var key = new Key { ColumnFamily = "a" };
+            var cells = new List<Cell>();
+            for (var n = 0; n < Count; ++n) {
+                key.Row = Guid.NewGuid().ToString();
+                cells.Add(new Cell(key, Encoding.GetBytes(key.Row), true));
+            }
+
+            using (var mutator = table.CreateMutator(new MutatorSpec { Queued = true, BatchSize = 100 })) {
+                foreach (var cell in cells) {
+                    mutator.Set(cell);
+                }
+
+                mutator.Flush();
+
+                var statistics = mutator.Statistics;
+                Assert.IsNotNull(statistics);
+                Assert.IsTrue(statistics.Batches > 0);
+                Assert.AreEqual(Count, statistics.BatchedCells);
+                Assert.IsTrue(statistics.MaxBatchSize <= 100);
+                Assert.AreEqual(0, statistics.QueueDepth);
+            }
+
+            Assert.AreEqual(Count, this.GetCellCount());
+        }
+
+        [TestMethod]
+        public void SetCollectionQueuedConsumers() {
+            this.SetCollection(new MutatorSpec { Queued = true, Consumers = 4 });
+        }
+
+        [TestMethod]
+        public void SetCollectionSpilled() {
+            var spillPath = System.IO.Path.GetTempFileName();
+            try {
+                var key = new Key { ColumnFamily = "a" };
+                using (var mutator = table.CreateMutator(new MutatorSpec { Queued = true, Capacity = 1000, SpillPath = spillPath, SpillThreshold = 10 })) {
+                    for (var n = 0; n < Count; ++n) {
+                        key.Row = Guid.NewGuid().ToString();
+                        mutator.Set(key, Encoding.GetBytes(key.Row));
+                    }
+
+                    mutator.Flush();
+                    Assert.AreEqual(0, new System.IO.FileInfo(spillPath).Length);
+                }
+
+                Assert.AreEqual(Count, this.GetCellCount());
+            }
+            finally {
+                System.IO.File.Delete(spillPath);
+            }
+        }
+
+        [TestMethod]
+        public void SetCollectionStriped() {
+            this.SetCollection(StripedMutatorSpec);
+        }
+
         [TestMethod]
         public void SetCollectionThreaded() {
             this.SetCollectionThreaded(null);
@@ -1073,6 +1499,16 @@ namespace Hypertable.Test
             this.SetCollectionThreaded(ChunkedQueuedMutatorSpec);
         }
 
+        [TestMethod]
+        public void SetCollectionThreadedQueuedConsumers() {
+            this.SetCollectionThreaded(new MutatorSpec { Queued = true, Consumers = 4 });
+        }
+
+        [TestMethod]
+        public void SetCollectionThreadedStriped() {
+            this.SetCollectionThreaded(StripedMutatorSpec);
+        }
+
         [TestMethod]
         public void SetCollectionThreadedQueued() {
             this.SetCollectionThreaded(MutatorSpec.CreateQueued());
@@ -1194,6 +1630,43 @@ namespace Hypertable.Test
             this.Set(MutatorSpec.CreateQueued());
         }
 
+        [TestMethod]
+        public void SetPendingBytes() {
+            this.SetPendingBytes(new MutatorSpec { Queued = true, MaxPendingBytes = 16 * 1024 });
+            Delete(table);
+            this.SetPendingBytes(new MutatorSpec(MutatorKind.Chunked) { MaxChunkSize = 4096, MaxPendingBytes = 16 * 1024 });
+        }
+
+        public void SetPendingBytes(MutatorSpec mutatorSpec) {
+            var value = new byte[1024];
+            using (var mutator = table.CreateMutator(mutatorSpec)) {
+                var maxPendingBytes = 0L;
+                var threads = new List<Thread>();
+                for (var t = 0; t < 4; ++t) {
+                    threads.Add(new Thread(
+                        () =>
+                            {
+                                for (var n = 0; n < Count / 4; ++n) {
+                                    mutator.Set(new Key { Row = Guid.NewGuid().ToString(), ColumnFamily = "a" }, value);
+                                    lock (threads) {
+                                        maxPendingBytes = Math.Max(maxPendingBytes, mutator.Statistics.PendingBytes);
+                                    }
+                                }
+                            }));
+                }
+
+                threads.ForEach(t => t.Start());
+                threads.ForEach(t => t.Join());
+                mutator.Flush();
+
+                Assert.IsTrue(maxPendingBytes <= mutatorSpec.MaxPendingBytes);
+                Assert.AreEqual(0, mutator.Statistics.PendingBytes);
+                Trace.WriteLine(mutator.Statistics);
+            }
+
+            Assert.AreEqual(Count, this.GetCellCount());
+        }
+
         [TestMethod]
         public void SetThreaded() {
             this.SetThreaded(null);
@@ -1243,11 +1716,108 @@ namespace Hypertable.Test
             this.SetThreaded(ChunkedQueuedMutatorSpec);
         }
 
+        [TestMethod]
+        public void SetThreadedChunkedSmallChunks() {
+            this.SetThreaded(new MutatorSpec(MutatorKind.Chunked) { MaxCellCount = 16, FlushEachChunk = true });
+            Assert.AreEqual(2 * Count, this.GetCellCount());
+        }
+
         [TestMethod]
         public void SetThreadedQueued() {
             this.SetThreaded(MutatorSpec.CreateQueued());
         }
 
+        [TestMethod]
+        public void SetThreadedStriped() {
+            this.SetThreaded(StripedMutatorSpec);
+            Assert.AreEqual(2 * Count, this.GetCellCount());
+        }
+
+        [TestMethod]
+        public void SetValueCodecs() {
+            this.SetValueCodecs(null);
+        }
+
+        [TestMethod]
+        public void SetValueCodecsChunked() {
+            this.SetValueCodecs(MutatorSpec.CreateChunked());
+        }
+
+        [TestMethod]
+        public void SetValueCodecsStriped() {
+            this.SetValueCodecs(StripedMutatorSpec);
+        }
+
+        public void SetValueCodecs(MutatorSpec mutatorSpec) {
+            var valueCodecs = new Dictionary<string, IValueCodec> { { "a", Lz4ValueCodec.Instance } };
+            mutatorSpec = mutatorSpec != null ? new MutatorSpec(mutatorSpec) : new MutatorSpec();
+            mutatorSpec.ValueCodecs = valueCodecs;
+
+            var values = new Dictionary<string, byte[]>();
+            var key = new Key { ColumnFamily = "a" };
+            using (var mutator = table.CreateMutator(mutatorSpec)) {
+                for (var n = 0; n < Count; ++n) {
+                    key.Row = n.ToString("D4");
+                    var value = n % 10 == 0
+                        ? Encoding.GetBytes(key.Row)
+                        : n % 10 == 5
+                            ? new byte[] { 0x00, (byte)'H', (byte)'Z', Lz4ValueCodec.Instance.Id, 0xff, 0xff, 0xff, 0x7f }.Concat(Encoding.GetBytes(key.Row)).ToArray() // raw value which looks encoded
+                            : Encoding.GetBytes(string.Concat(Enumerable.Repeat("{\"row\":\"" + key.Row + "\",\"value\":" + n + "}", 1 + n % 50)));
+                    values.Add(key.Row, value);
+                    mutator.Set(key, value);
+                }
+            }
+
+            long encodedLength = 0;
+            using (var scanner = table.CreateScanner()) {
+                var cell = new Cell();
+                while (scanner.Move(cell)) {
+                    encodedLength += cell.Value.Length;
+                }
+            }
+
+            Assert.IsTrue(encodedLength < values.Values.Sum(value => (long)value.Length));
+
+            var scanSpec = new ScanSpec { ValueCodecs = valueCodecs };
+            using (var scanner = table.CreateScanner(scanSpec)) {
+                var cell = new Cell();
+                var count = 0;
+                while (scanner.Move(cell)) {
+                    CollectionAssert.AreEqual(values[cell.Key.Row], cell.Value);
+                    ++count;
+                }
+
+                Assert.AreEqual(Count, count);
+            }
+
+            using (var scanner = table.CreateScanner(scanSpec)) {
+                var cell = new BufferedCell(16);
+                while (scanner.Move(cell)) {
+                    CollectionAssert.AreEqual(values[cell.Key.Row], cell.Value.Take(cell.ValueLength).ToArray());
+                }
+            }
+
+            using (var scanner = table.CreateScanner(scanSpec)) {
+                var cell = new PooledCell();
+                while (scanner.Move(cell)) {
+                    CollectionAssert.AreEqual(values[cell.Key.Row], cell.Value.Take(cell.ValueLength).ToArray());
+                    PooledCell.Return(cell.Value);
+                }
+            }
+
+            // raw value written without codecs, the decoded length in the bogus header exceeds the codec ratio
+            var raw = new byte[] { 0x00, (byte)'H', (byte)'Z', Lz4ValueCodec.Instance.Id, 0xff, 0xff, 0xff, 0x7f, 1, 2, 3, 4 };
+            using (var mutator = table.CreateMutator()) {
+                mutator.Set(new Key { Row = "raw", ColumnFamily = "a" }, raw);
+            }
+
+            using (var scanner = table.CreateScanner(new ScanSpec("raw") { ValueCodecs = valueCodecs })) {
+                var cell = new Cell();
+                Assert.IsTrue(scanner.Move(cell));
+                CollectionAssert.AreEqual(raw, cell.Value);
+            }
+        }
+
         [TestInitialize]
         public void TestInitialize() {
             TestBase.ContinueExecution();
@@ -1275,5 +1845,38 @@ namespace Hypertable.Test
         }
 
         #endregion
+
+#if NETCORE
+        #region Nested Types
+
+        private sealed class CounterListener : System.Diagnostics.Tracing.EventListener
+        {
+            private readonly string counterName;
+
+            public CounterListener(string counterName) {
+                this.counterName = counterName;
+            }
+
+            public ManualResetEventSlim Received { get; } = new ManualResetEventSlim();
+
+            protected override void OnEventSourceCreated(System.Diagnostics.Tracing.EventSource eventSource) {
+                if (eventSource.Name == "ht4n") {
+                    this.EnableEvents(eventSource, System.Diagnostics.Tracing.EventLevel.Verbose, System.Diagnostics.Tracing.EventKeywords.All, new Dictionary<string, string> { { "EventCounterIntervalSec", "1" } });
+                }
+            }
+
+            protected override void OnEventWritten(System.Diagnostics.Tracing.EventWrittenEventArgs eventData) {
+                if (eventData.EventName == "EventCounters" && eventData.Payload != null) {
+                    foreach (IDictionary<string, object> payload in eventData.Payload.OfType<IDictionary<string, object>>()) {
+                        if ((string)payload["Name"] == this.counterName && Convert.ToDouble(payload["Increment"], CultureInfo.InvariantCulture) > 0) {
+                            this.Received.Set();
+                        }
+                    }
+                }
+            }
+        }
+
+        #endregion
+#endif
     }
 }
\ No newline at end of file
@@ -23,8 +23,10 @@ namespace Hypertable.Test
 {
     using System;
     using System.Collections.Generic;
+    using System.Diagnostics;
     using System.Globalization;
     using System.Linq;
+    using System.Runtime.InteropServices;
     using System.Text;
     using System.Threading;
 
@@ -2250,6 +2252,119 @@ namespace Hypertable.Test
             }
         }
 
+        [TestMethod]
+        public void ScanTableMoveBatch() {
+            using (var scanner = table.CreateScanner()) {
+                var c = 0;
+                var cells = new BufferedCell[100];
+                int count;
+                while( scanner.MoveBatch(cells, out count) ) {
+                    Assert.IsTrue(count > 0 && count <= cells.Length);
+                    for( var n = 0; n < count; ++n ) {
+                        var cell = cells[n];
+                        Assert.AreEqual(cell.Key.Row, Encoding.GetString(cell.Value, 0, cell.ValueLength));
+                    }
+
+                    c += count;
+                }
+
+                Assert.AreEqual(0, count);
+                Assert.AreEqual(CountA + CountB + CountC, c);
+            }
+        }
+
+        [TestMethod]
+        public void ScanTableScanBlock() {
+            using (var scanner = table.CreateScanner()) {
+                var c = 0;
+                var block = new ScanBlock(100);
+                while( scanner.Move(block) ) {
+                    Assert.IsTrue(block.Count > 0 && block.Count <= block.Capacity);
+                    for( var n = 0; n < block.Count; ++n ) {
+                        var value = block.GetValue(n);
+                        Assert.AreEqual(block.GetRow(n), Encoding.GetString(value.Array, value.Offset, value.Count));
+                        Assert.AreEqual(block.GetRow(n), block.GetCell(n).Key.Row);
+                    }
+
+                    c += block.Count;
+                }
+
+                Assert.AreEqual(0, block.Count);
+                Assert.AreEqual(CountA + CountB + CountC, c);
+            }
+        }
+
+        [TestMethod]
+        public void ScanTableVisit() {
+            using (var scanner = table.CreateScanner()) {
+                var c = 0;
+                var value = new byte[256];
+                CellVisitor visitor = view => {
+                    Assert.IsTrue(view.RowLength > 0 && view.ValueLength > 0 && view.ValueLength <= value.Length);
+                    Marshal.Copy(view.Value, value, 0, view.ValueLength);
+                    Assert.AreEqual(view.GetRow(), Encoding.GetString(value, 0, view.ValueLength));
+                    Assert.AreEqual(Encoding.GetByteCount(view.GetRow()), view.RowLength);
+                    ++c;
+                    return true;
+                };
+
+                while( scanner.Visit(visitor) ) {
+                }
+
+                Assert.AreEqual(CountA + CountB + CountC, c);
+            }
+
+            using (var scanner = table.CreateScanner()) {
+                var c = 0;
+                int count;
+                while( scanner.VisitBatch(view => ++c > 0, 100, out count) ) {
+                    Assert.AreEqual(100, count);
+                }
+
+                Assert.IsTrue(count < 100);
+                Assert.AreEqual(CountA + CountB + CountC, c);
+            }
+
+            using (var scanner = table.CreateScanner()) {
+                var c = 0;
+                int count;
+                Assert.IsFalse(scanner.VisitBatch(view => ++c < 10, 100, out count));
+                Assert.AreEqual(10, count);
+                Assert.AreEqual(10, c);
+            }
+        }
+
+        [TestMethod]
+        public void ScanTableInternStrings() {
+            var columnFamilies = new Dictionary<string, string>();
+            using (var scanner = table.CreateScanner(new ScanSpec { Flags = ScannerFlags.InternStrings })) {
+                var c = 0;
+                Cell cell;
+                while (scanner.Next(out cell)) {
+                    string columnFamily;
+                    if (columnFamilies.TryGetValue(cell.Key.ColumnFamily, out columnFamily)) {
+                        Assert.AreSame(columnFamily, cell.Key.ColumnFamily);
+                    }
+                    else {
+                        columnFamilies.Add(cell.Key.ColumnFamily, cell.Key.ColumnFamily);
+                    }
+
+                    Assert.AreEqual(cell.Key.Row, Encoding.GetString(cell.Value));
+                    ++c;
+                }
+
+                Assert.AreEqual(CountA + CountB + CountC, c);
+            }
+
+            using (var scanner = table.CreateScanner(new ScanSpec().AddColumn("a"))) {
+                Cell cell1, cell2;
+                Assert.IsTrue(scanner.Next(out cell1));
+                Assert.IsTrue(scanner.Next(out cell2));
+                Assert.AreEqual(cell1.Key.ColumnFamily, cell2.Key.ColumnFamily);
+                Assert.AreNotSame(cell1.Key.ColumnFamily, cell2.Key.ColumnFamily);
+            }
+        }
+
         [TestMethod]
         public void ScanTableMaxCells() {
             string[] rows = { "A", "B", "C", "D" };
@@ -2389,6 +2504,104 @@ namespace Hypertable.Test
             }
         }
 
+        [TestMethod]
+        public void ScanTableParallel() {
+            var keys = new List<Key>();
+            using (var scanner = table.CreateScanner()) {
+                Cell cell;
+                while (scanner.Next(out cell)) {
+                    keys.Add(cell.Key);
+                }
+            }
+
+            using (var scanner = table.CreateParallelScanner(null, 4)) {
+                var c = 0;
+                var cell = new Cell();
+                while (scanner.Move(cell)) {
+                    Assert.AreEqual(cell.Key.Row, Encoding.GetString(cell.Value));
+                    Assert.AreEqual(keys[c].Row, cell.Key.Row);
+                    Assert.AreEqual(keys[c].ColumnFamily, cell.Key.ColumnFamily);
+                    ++c;
+                }
+
+                Assert.AreEqual(keys.Count, c);
+                Assert.IsTrue(scanner.Statistics.Partitions > 1);
+            }
+
+            using (var scanner = table.CreateParallelScanner(null, 4, false)) {
+                var c = 0;
+                var cell = new Cell();
+                while (scanner.Move(cell)) {
+                    Assert.AreEqual(cell.Key.Row, Encoding.GetString(cell.Value));
+                    ++c;
+                }
+
+                Assert.AreEqual(keys.Count, c);
+            }
+
+            var rows = keys.Select(k => k.Row).Distinct().ToList();
+            var rowInterval = new RowInterval(rows[10], true, rows[rows.Count - 10], false);
+            using (var scanner = table.CreateParallelScanner(new ScanSpec().AddRowInterval(rowInterval), 4)) {
+                var expected = keys.Where(k => string.CompareOrdinal(k.Row, rowInterval.StartRow) >= 0 && string.CompareOrdinal(k.Row, rowInterval.EndRow) < 0).ToList();
+                CollectionAssert.AreEqual(expected.Select(k => k.Row).ToList(), scanner.Select(cell => cell.Key.Row).ToList());
+                Assert.IsTrue(scanner.Statistics.Partitions > 1);
+            }
+
+            var someRows = new HashSet<string>(rows.Take(100));
+            using (var scanner = table.CreateParallelScanner(new ScanSpec().AddRow(someRows), 4)) {
+                Assert.AreEqual(keys.Count(k => someRows.Contains(k.Row)), scanner.Count());
+            }
+
+            using (var scanner = table.CreateParallelScanner(new ScanSpec { MaxRows = 10 }, 4)) {
+                CollectionAssert.AreEqual(rows.Take(10).ToList(), scanner.Select(cell => cell.Key.Row).Distinct().ToList());
+            }
+
+            using (var scanner = table.CreateParallelScanner(new ScanSpec { MaxRows = 10 }, 4, false)) {
+                Assert.AreEqual(10, scanner.Select(cell => cell.Key.Row).Distinct().Count());
+            }
+
+            using (var scanner = table.CreateParallelScanner(new ScanSpec { MaxCells = 100 }, 4, false)) {
+                Assert.AreEqual(100, scanner.Count());
+            }
+        }
+
+        [TestMethod]
+        public void ScanTablePrefetch() {
+            using (var scanner = table.CreateScanner(new ScanSpec { Flags = ScannerFlags.Prefetch })) {
+                var c = 0;
+                var cell = new Cell();
+                while( scanner.Move(cell) ) {
+                    Assert.AreEqual(cell.Key.Row, Encoding.GetString(cell.Value));
+                    ++c;
+                }
+
+                Assert.AreEqual(CountA + CountB + CountC, c);
+                Assert.IsTrue(scanner.Statistics.Chunks > 0);
+                Assert.AreEqual(c, scanner.Statistics.FetchedCells);
+                Assert.AreEqual(0, scanner.Statistics.BufferedChunks);
+                Assert.IsTrue(scanner.Statistics.BufferCapacity > 0);
+            }
+
+            using (var scanner = table.CreateScanner()) {
+                Assert.AreEqual(0, scanner.Statistics.Chunks);
+            }
+
+            // MaxRows applies to each row interval individually
+            var scanSpec = new ScanSpec { MaxRows = 5 }
+                .AddRowInterval(new RowInterval(null, true, "8", false))
+                .AddRowInterval(new RowInterval("8", true, null, false));
+            int expected;
+            using (var scanner = table.CreateScanner(scanSpec)) {
+                expected = scanner.Select(cell => cell.Key.Row).Distinct().Count();
+                Assert.AreEqual(10, expected);
+            }
+
+            scanSpec.Flags = ScannerFlags.Prefetch;
+            using (var scanner = table.CreateScanner(scanSpec)) {
+                Assert.AreEqual(expected, scanner.Select(cell => cell.Key.Row).Distinct().Count());
+            }
+        }
+
         [TestMethod]
         public void ScanTableRandomCells() {
             var random = new Random();
@@ -3119,6 +3332,63 @@ namespace Hypertable.Test
             }
         }
 
+        [TestMethod]
+        public void ScanTableRows() {
+            using (var scanner = new RowScanner(table.CreateScanner())) {
+                var r = 0;
+                var c = 0;
+                string lastRowKey = null;
+                Row row;
+                while (scanner.Next(out row)) {
+                    Assert.IsTrue(row.Count >= 1 && row.Count <= 3);
+                    Assert.IsTrue(lastRowKey == null || string.CompareOrdinal(lastRowKey, row.RowKey) < 0);
+                    Assert.AreEqual(Encoding.GetByteCount(row.RowKey), row.GetRowKeyBytes().Count);
+                    for (var n = 0; n < row.Count; ++n) {
+                        var value = row.GetValue(n);
+                        Assert.AreEqual(row.RowKey, Encoding.GetString(value.Array, value.Offset, value.Count));
+                        Assert.IsNull(row.GetColumnQualifier(n));
+                        ++c;
+                    }
+
+                    lastRowKey = row.RowKey;
+                    ++r;
+                }
+
+                Assert.AreEqual(CountA, r);
+                Assert.AreEqual(CountA + CountB + CountC, c);
+                Assert.IsFalse(scanner.Next(out row));
+            }
+
+            using (var scanner = new RowScanner(table.CreateScanner(new ScanSpec().AddColumn("b", "c")))) {
+                var r = 0;
+                var c = 0;
+                foreach (var row in scanner) {
+                    for (var n = 0; n < row.Count; ++n) {
+                        Assert.IsTrue(row.GetColumnFamily(n) == "b" || row.GetColumnFamily(n) == "c");
+                    }
+
+                    c += row.Count;
+                    ++r;
+                }
+
+                Assert.AreEqual(CountB, r);
+                Assert.AreEqual(CountB + CountC, c);
+            }
+
+            var scanner2 = new RowScanner(table.CreateScanner(new ScanSpec { Flags = ScannerFlags.Prefetch }));
+            using (scanner2) {
+                var r = 0;
+                foreach (var row in scanner2) {
+                    ++r;
+                }
+
+                Assert.AreEqual(CountA, r);
+            }
+
+            Assert.IsTrue(scanner2.IsDisposed);
+            Assert.IsTrue(scanner2.TableScanner.IsDisposed);
+        }
+
         [TestMethod]
         public void ScanTableThreaded() {
             var t1 = new Thread(
@@ -3585,6 +3855,97 @@ namespace Hypertable.Test
             }
         }
 
+        [TestMethod]
+        public void ScanTableTranscoding() {
+            var rows = new [] {
+                "a",
+                new string('a', 15),
+                new string('a', 16) + "\u00e4",
+                new string('b', 64),
+                new string('c', 65),
+                new string('d', 1000),
+                "\u00e4\u00f6\u00fc" + new string('e', 40) + "\u20ac",
+                new string('f', 31) + "\ud83d\ude00" + new string('f', 31),
+                string.Concat(Enumerable.Repeat("\u00e4\u20ac\ud83d\ude00x", 100))
+            };
+
+            var key = new Key { ColumnFamily = "d" };
+            using( var mutator = table.CreateMutator() ) {
+                foreach( var row in rows ) {
+                    key.Row = row;
+                    mutator.Set(key, Encoding.GetBytes(key.Row));
+                }
+            }
+
+            using( var scanner = table.CreateScanner(new ScanSpec().AddColumn("d")) ) {
+                var c = 0;
+                Cell cell;
+                while( scanner.Next(out cell) ) {
+                    Assert.AreEqual(cell.Key.Row, Encoding.GetString(cell.Value));
+                    Assert.IsTrue(rows.Contains(cell.Key.Row));
+                    ++c;
+                }
+
+                Assert.AreEqual(rows.Length, c);
+            }
+
+            const int Count = 1000;
+            foreach( var prefix in new[] { "row", "\u00e4\u20ac\ud83d\ude00" } ) {
+                var rowKeys = Enumerable.Range(0, Count).Select(n => prefix + n.ToString("D24", CultureInfo.InvariantCulture)).ToList();
+                using( var mutator = table.CreateMutator() ) {
+                    key = new Key { ColumnFamily = "e" };
+                    foreach( var row in rowKeys ) {
+                        key.Row = row;
+                        mutator.Set(key, null);
+                    }
+                }
+
+                using( var scanner = table.CreateScanner(new ScanSpec().AddColumn("e")) ) {
+                    var c = 0;
+                    Cell cell;
+                    while( scanner.Next(out cell) ) {
+                        Assert.IsTrue(cell.Key.Row.StartsWith(prefix, StringComparison.Ordinal));
+                        ++c;
+                    }
+
+                    Assert.AreEqual(Count, c);
+                }
+
+                DeleteColumnFamily(table, "e");
+            }
+        }
+
+        [TestMethod]
+        public void TranscodingBenchmark() {
+            // the transcoders are internal, compare them on the same buffers without any table round trip
+            var decode = (Func<byte[], int[], bool, string[]>)Delegate.CreateDelegate(
+                typeof(Func<byte[], int[], bool, string[]>),
+                typeof(Key).Assembly.GetType("Hypertable.Utf8Transcoding", true).GetMethod("Decode", System.Reflection.BindingFlags.Static | System.Reflection.BindingFlags.NonPublic));
+
+            const int Count = 100000;
+            const int Iterations = 10;
+            foreach( var prefix in new[] { "row", "\u00e4\u20ac\ud83d\ude00", new string('a', 100) } ) {
+                var strings = Enumerable.Range(0, Count).Select(n => prefix + n.ToString("D24", CultureInfo.InvariantCulture)).ToArray();
+                var lengths = strings.Select(s => Encoding.GetByteCount(s)).ToArray();
+                var buffer = Encoding.GetBytes(string.Concat(strings));
+
+                CollectionAssert.AreEqual(strings, decode(buffer, lengths, false));
+                CollectionAssert.AreEqual(strings, decode(buffer, lengths, true));
+
+                var elapsed = new TimeSpan[2];
+                for( var win32 = 0; win32 < 2; ++win32 ) {
+                    var stopwatch = Stopwatch.StartNew();
+                    for( var n = 0; n < Iterations; ++n ) {
+                        decode(buffer, lengths, win32 != 0);
+                    }
+
+                    elapsed[win32] = stopwatch.Elapsed;
+                }
+
+                Trace.WriteLine(string.Format(CultureInfo.InvariantCulture, "Decoding {0} strings with prefix {1}: SSE2 {2}, Win32 {3}", Iterations * Count, prefix.Substring(0, Math.Min(prefix.Length, 8)), elapsed[0], elapsed[1]));
+            }
+        }
+
         [TestMethod]
         public void ScanTableWithUnicodeCharacters() {
             var rows = new [] {
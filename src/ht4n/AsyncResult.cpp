@@ -27,9 +27,12 @@
 #include "ITableMutator.h"
 #include "ScanSpec.h"
 #include "Cell.h"
+#include "ScanBlock.h"
+#include "StringCache.h"
 #include "AsyncScannerContext.h"
 #include "AsyncMutatorContext.h"
 #include "CrossAppDomainFunc.h"
+#include "HypertableEventSource.h"
 #include "Exception.h"
 
 #include "ht4c.Common/Cell.h"
@@ -108,6 +111,63 @@ namespace Hypertable {
 				virtual Common::AsyncCallbackResult invoke( AsyncScannerCallback^ callback, AsyncScannerCtx* ctx );
 		};
 
+		/// <summary>
+		/// CrossAppDomainAsyncScannerDetachedCallbackBase.
+		/// </summary>
+		typedef CrossAppDomainFunc<Action<Int64>^, int64_t, bool> CrossAppDomainAsyncScannerDetachedCallbackBase;
+
+		/// <summary>
+		/// Application domain aware scanner detached callback.
+		/// </summary>
+		class CrossAppDomainAsyncScannerDetachedCallback : public CrossAppDomainAsyncScannerDetachedCallbackBase
+																									 , public CrossAppDomainAsyncScannerDetachedCallbackBase::Invoker {
+
+			public:
+
+				CrossAppDomainAsyncScannerDetachedCallback( Action<Int64>^ callback )
+					: CrossAppDomainAsyncScannerDetachedCallbackBase( this, callback )
+				{
+				}
+
+				inline bool invoke( int64_t asyncScannerId ) {
+					return CrossAppDomainAsyncScannerDetachedCallbackBase::invoke( asyncScannerId );
+				}
+
+			protected:
+
+				virtual bool invoke( Action<Int64>^ callback, int64_t asyncScannerId ) {
+					callback( asyncScannerId );
+					return true;
+				}
+		};
+
+		/// <summary>
+		/// CrossAppDomainAsyncScanBlockCallbackBase.
+		/// </summary>
+		typedef CrossAppDomainFunc<AsyncScanBlockCallback^, AsyncScannerCtx*, Common::AsyncCallbackResult> CrossAppDomainAsyncScanBlockCallbackBase;
+
+		/// <summary>
+		/// Application domain aware scan block callback.
+		/// </summary>
+		class CrossAppDomainAsyncScanBlockCallback : public CrossAppDomainAsyncScanBlockCallbackBase
+																							 , public CrossAppDomainAsyncScanBlockCallbackBase::Invoker {
+
+			public:
+
+				CrossAppDomainAsyncScanBlockCallback( AsyncScanBlockCallback^ callback )
+					: CrossAppDomainAsyncScanBlockCallbackBase( this, callback )
+				{
+				}
+
+				inline Common::AsyncCallbackResult invoke( AsyncScannerCtx* ctx ) {
+					return CrossAppDomainAsyncScanBlockCallbackBase::invoke( ctx );
+				}
+
+			protected:
+
+				virtual Common::AsyncCallbackResult invoke( AsyncScanBlockCallback^ callback, AsyncScannerCtx* ctx );
+		};
+
 
 		/// <summary>
 		/// Base class for table related asynchronous operation context.
@@ -157,12 +217,24 @@ namespace Hypertable {
 				gcroot<AsyncScannerContext^> ctx;
 				Common::Cells* cells;
 				CrossAppDomainAsyncScannerCallback* callback;
+				CrossAppDomainAsyncScanBlockCallback* blockCallback;
+				gcroot<ScanBlock^> block;
 
 				AsyncScannerCtx( AsyncScannerContext^ _ctx, AsyncScannerCallback^ _callback )
 				: AsyncCtx<AsyncScannerCtx>( )
 				, ctx( _ctx )
 				, cells( 0 )
 				, callback( _callback != nullptr ? new CrossAppDomainAsyncScannerCallback(_callback) : 0 )
+				, blockCallback( 0 )
+				{
+				}
+
+				AsyncScannerCtx( AsyncScannerContext^ _ctx, AsyncScanBlockCallback^ _blockCallback )
+				: AsyncCtx<AsyncScannerCtx>( )
+				, ctx( _ctx )
+				, cells( 0 )
+				, callback( 0 )
+				, blockCallback( _blockCallback != nullptr ? new CrossAppDomainAsyncScanBlockCallback(_blockCallback) : 0 )
 				{
 				}
 
@@ -170,6 +242,9 @@ namespace Hypertable {
 					if( callback ) {
 						delete callback;
 					}
+					if( blockCallback ) {
+						delete blockCallback;
+					}
 				}
 		};
 
@@ -194,12 +269,43 @@ namespace Hypertable {
 			Common::Cell* cell = Common::Cell::create();
 			try {
 				const Common::Cells& _cells = *ctx->cells;
+				StringCache^ stringCache = ctx->ctx->StringCache;
 				List<Cell^>^ cells = gcnew List<Cell^>( (int)_cells.size() );
+				if( stringCache != nullptr ) {
+					// the string cache is shared by the callbacks of the scanner context
+					msclr::lock sync( stringCache );
+					for( size_t n = 0; n < _cells.size(); ++n ) {
+						_cells.get_unchecked( n, cell );
+						cells->Add( gcnew Cell(cell, stringCache) );
+					}
+				}
+				else {
+					for( size_t n = 0; n < _cells.size(); ++n ) {
+						_cells.get_unchecked( n, cell );
+						cells->Add( gcnew Cell(cell) );
+					}
+				}
+				return static_cast<Common::AsyncCallbackResult>( callback->Invoke(ctx->ctx, cells) );
+			}
+			finally {
+				delete cell;
+			}
+		}
+
+		Common::AsyncCallbackResult CrossAppDomainAsyncScanBlockCallback::invoke( AsyncScanBlockCallback^ callback, AsyncScannerCtx* ctx ) {
+			Common::Cell* cell = Common::Cell::create();
+			try {
+				const Common::Cells& _cells = *ctx->cells;
+				ScanBlock^ block = ctx->block;
+				if( block == nullptr || block->Capacity < (int)_cells.size() ) {
+					ctx->block = block = gcnew ScanBlock( __max((int)_cells.size(), ScanBlock::CapacityDefault) );
+				}
+				block->Clear();
 				for( size_t n = 0; n < _cells.size(); ++n ) {
 					_cells.get_unchecked( n, cell );
-					cells->Add( gcnew Cell(cell) );
+					block->Add( *cell );
 				}
-				return static_cast<Common::AsyncCallbackResult>( callback->Invoke(ctx->ctx, cells) );
+				return static_cast<Common::AsyncCallbackResult>( callback->Invoke(ctx->ctx, block) );
 			}
 			finally {
 				delete cell;
@@ -219,6 +325,7 @@ namespace Hypertable {
 
 			AsyncResultSink( )
 			: callback( nullptr )
+			, detachedCallback( 0 )
 			, exception( 0 )
 			, resetException( false )
 			{
@@ -228,6 +335,7 @@ namespace Hypertable {
 
 			explicit AsyncResultSink( AsyncScannerCallback^ _callback )
 			: callback( _callback )
+			, detachedCallback( 0 )
 			, exception( 0 )
 			, resetException( false )
 			{
@@ -238,6 +346,9 @@ namespace Hypertable {
 			virtual ~AsyncResultSink( ) {
 				freeAsyncScannerCtx();
 				freeAsyncMutatorCtx();
+				if( detachedCallback ) {
+					delete detachedCallback;
+				}
 				if( exception ) {
 					delete exception;
 				}
@@ -246,16 +357,20 @@ namespace Hypertable {
 			}
 
 			void attachAsyncScanner( AsyncScannerContext^ asyncScannerContext, AsyncScannerCallback^ callback ) {
-				AsyncScannerCtx* ctx = new AsyncScannerCtx( asyncScannerContext, callback );
+				attachAsyncScanner( asyncScannerContext->Id, new AsyncScannerCtx(asyncScannerContext, callback) );
+			}
+
+			void attachAsyncScanner( AsyncScannerContext^ asyncScannerContext, AsyncScanBlockCallback^ callback ) {
+				attachAsyncScanner( asyncScannerContext->Id, new AsyncScannerCtx(asyncScannerContext, callback) );
+			}
+
+			void attachAsyncScannerDetached( Action<Int64>^ _detachedCallback ) {
+				CrossAppDomainAsyncScannerDetachedCallback* cb = new CrossAppDomainAsyncScannerDetachedCallback( _detachedCallback );
 				Lock lock( &async_scanner_crit );
-				async_scanner_map_t::iterator it = async_scanner_map.find( asyncScannerContext->Id );
-				if( it == async_scanner_map.end() ) {
-					async_scanner_map.insert( async_scanner_map_t::value_type(asyncScannerContext->Id, ctx) );
-				}
-				else {
-					AsyncScannerCtx::free( (*it).second );
-					(*it).second = ctx;
+				if( detachedCallback ) {
+					delete detachedCallback;
 				}
+				detachedCallback = cb;
 			}
 
 			void attachAsyncMutator( AsyncMutatorContext^ asyncMutatorContext ) {
@@ -281,8 +396,31 @@ namespace Hypertable {
 
 		private:
 
+			void attachAsyncScanner( int64_t asyncScannerId, AsyncScannerCtx* ctx ) {
+				Lock lock( &async_scanner_crit );
+				async_scanner_map_t::iterator it = async_scanner_map.find( asyncScannerId );
+				if( it == async_scanner_map.end() ) {
+					async_scanner_map.insert( async_scanner_map_t::value_type(asyncScannerId, ctx) );
+				}
+				else {
+					AsyncScannerCtx::free( (*it).second );
+					(*it).second = ctx;
+				}
+			}
+
 			virtual void detachAsyncScanner( int64_t asyncScannerId ) {
 				freeAsyncScannerCtx( asyncScannerId );
+				CrossAppDomainAsyncScannerDetachedCallback* cb;
+				{
+					Lock lock( &async_scanner_crit );
+					cb = detachedCallback;
+				}
+				if( cb ) {
+					HT4N_TRY {
+						cb->invoke( asyncScannerId );
+					}
+					HT4N_RETHROW
+				}
 			}
 
 			virtual void detachAsyncMutator( int64_t asyncMutatorId ) {
@@ -306,9 +444,13 @@ namespace Hypertable {
 				}
 
 				if( ctx ) {
+					HypertableEventSource::Scanned( cells );
 					HT4N_TRY {
 						ctx->cells = &cells;
-						if( ctx->callback ) {
+						if( ctx->blockCallback ) {
+							return ctx->blockCallback->invoke( ctx );
+						}
+						else if( ctx->callback ) {
 							return ctx->callback->invoke( ctx );
 						}
 						else {
@@ -371,6 +513,7 @@ namespace Hypertable {
 			AsyncResultSink& operator = ( const AsyncResultSink& );
 
 			CrossAppDomainAsyncScannerCallback callback;
+			CrossAppDomainAsyncScannerDetachedCallback* detachedCallback;
 			Common::HypertableException* exception;
 			bool resetException;
 
@@ -442,6 +585,7 @@ namespace Hypertable {
 	, asyncResult( new Common::AsyncResult*[size] )
 	, mutators( gcnew List<WeakReference^>() )
 	, scannerCallback( nullptr )
+	, scannerDetached( nullptr )
 	, disposed( false )
 	{
 		ZeroMemory( asyncResult, sizeof(Common::AsyncResult*) * size );
@@ -452,6 +596,7 @@ namespace Hypertable {
 	, asyncResult( new Common::AsyncResult*[size] )
 	, mutators( gcnew List<WeakReference^>() )
 	, scannerCallback( callback )
+	, scannerDetached( nullptr )
 	, disposed( false )
 	{
 		ZeroMemory( asyncResult, sizeof(Common::AsyncResult*) * size );
@@ -590,6 +735,39 @@ namespace Hypertable {
 		}
 	}
 
+	void AsyncResult::AttachAsyncScanner( AsyncScannerContext^ asyncScannerContext, AsyncScanBlockCallback^ callback ) {
+		if( asyncScannerContext == nullptr ) throw gcnew ArgumentNullException( L"asyncScannerContext" );
+		if( callback == nullptr ) throw gcnew ArgumentNullException( L"callback" );
+		if( !asyncResultSink ) throw gcnew InvalidOperationException( L"Async result sink has not been initialized" );
+		asyncResultSink->attachAsyncScanner( asyncScannerContext, callback );
+		Common::ContextKind contextKind = asyncScannerContext->ContextKind;
+		if( asyncResult[contextKind] ) {
+			asyncResult[contextKind]->attachAsyncScanner( asyncScannerContext->Id );
+		}
+	}
+
+	void AsyncResult::AttachAsyncScannerDetached( Action<Int64>^ callback ) {
+		if( callback == nullptr ) throw gcnew ArgumentNullException( L"callback" );
+		if( !asyncResultSink ) throw gcnew InvalidOperationException( L"Async result sink has not been initialized" );
+		msclr::lock sync( this );
+		if( scannerDetached == nullptr ) {
+			asyncResultSink->attachAsyncScannerDetached( gcnew Action<Int64>(this, &AsyncResult::ScannerDetached) );
+		}
+		scannerDetached = safe_cast<Action<Int64>^>( Delegate::Combine(scannerDetached, callback) );
+	}
+
+	void AsyncResult::DetachAsyncScannerDetached( Action<Int64>^ callback ) {
+		msclr::lock sync( this );
+		scannerDetached = safe_cast<Action<Int64>^>( Delegate::Remove(scannerDetached, callback) );
+	}
+
+	void AsyncResult::ScannerDetached( Int64 asyncScannerId ) {
+		Action<Int64>^ callbacks = scannerDetached;
+		if( callbacks != nullptr ) {
+			callbacks( asyncScannerId );
+		}
+	}
+
 	void AsyncResult::AttachAsyncMutator( AsyncMutatorContext^ asyncMutatorContext, ITableMutator^ mutator ) {
 		if( asyncMutatorContext == nullptr ) throw gcnew ArgumentNullException( L"asyncMutatorContext" );
 		if( mutator == nullptr ) throw gcnew ArgumentNullException( L"mutator" );
@@ -26,6 +26,7 @@
 #endif
 
 #include "AsyncScannerCallback.h"
+#include "AsyncScanBlockCallback.h"
 
 #include "ht4c.Common/Types.h"
 #include "ht4c.Common/ContextKind.h"
@@ -194,8 +195,21 @@ namespace Hypertable {
 			Common::AsyncResult& get( Common::ContextKind contextKind );
 
 			virtual void AttachAsyncScanner( AsyncScannerContext^ asyncScannerContext, AsyncScannerCallback^ callback );
+			void AttachAsyncScanner( AsyncScannerContext^ asyncScannerContext, AsyncScanBlockCallback^ callback );
 			virtual void AttachAsyncMutator( AsyncMutatorContext^ asyncMutatorContext, ITableMutator^ mutator );
 
+			/// <summary>
+			/// Attaches a callback which gets called on the native scanner thread once an asynchronous scanner
+			/// has been detached, the scanner does not deliver any further cells. The callbacks are combined,
+			/// each callback gets called for every detached scanner until it has been removed.
+			/// </summary>
+			void AttachAsyncScannerDetached( Action<Int64>^ callback );
+
+			/// <summary>
+			/// Removes a callback attached by AttachAsyncScannerDetached.
+			/// </summary>
+			void DetachAsyncScannerDetached( Action<Int64>^ callback );
+
 			virtual Common::AsyncResult* CreateAsyncResult( Common::ContextKind contextKind, Common::AsyncResultSink* asyncResultSink );
 
 			template< typename T > inline
@@ -215,7 +229,10 @@ namespace Hypertable {
 			AsyncResultSink* asyncResultSink;
 			List<WeakReference^>^ mutators;
 			AsyncScannerCallback^ scannerCallback;
+			Action<Int64>^ scannerDetached;
 			bool disposed;
+
+			void ScannerDetached( Int64 asyncScannerId );
 	};
 
 }
\ No newline at end of file
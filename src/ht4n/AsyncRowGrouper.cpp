@@ -0,0 +1,95 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#include "stdafx.h"
+
+#include "AsyncRowGrouper.h"
+#include "AsyncResult.h"
+#include "AsyncScannerContext.h"
+#include "ScanBlock.h"
+#include "Row.h"
+#include "StringCache.h"
+#include "Logging.h"
+
+namespace Hypertable {
+	using namespace System;
+
+	AsyncRowGrouper::AsyncRowGrouper( AsyncResult^ _asyncResult, AsyncRowCallback^ _callback )
+	: asyncResult( _asyncResult )
+	, callback( _callback )
+	, context( nullptr )
+	, stringCache( gcnew StringCache() )
+	, building( gcnew Row() )
+	, id( 0 )
+	, stopped( false )
+	{
+		detached = gcnew Action<Int64>( this, &AsyncRowGrouper::Detached );
+		asyncResult->AttachAsyncScannerDetached( detached );
+	}
+
+	AsyncCallbackResult AsyncRowGrouper::Scanned( AsyncScannerContext^ asyncScannerContext, ScanBlock^ block ) {
+		context = asyncScannerContext;
+		if( stopped ) {
+			return AsyncCallbackResult::Cancel;
+		}
+
+		for( int n = 0; n < block->Count; ++n ) {
+			ArraySegment<Byte> row = block->GetRowBytes( n );
+			if( building->Count == 0 ) {
+				building->Reset( row );
+			}
+			else if( !building->IsRowKey(row) ) {
+				// the cell starts the next row, the block is re-filled by the next callback but the row keeps its own copy
+				AsyncCallbackResult result = callback( asyncScannerContext, building );
+				if( result != AsyncCallbackResult::Continue ) {
+					stopped = true;
+					return result;
+				}
+				building->Reset( row );
+			}
+			building->Add( block->GetColumnFamily(n, stringCache), block->GetColumnQualifier(n, stringCache), block->GetTimestamp(n), block->GetFlag(n), block->GetValue(n) );
+		}
+		return AsyncCallbackResult::Continue;
+	}
+
+	void AsyncRowGrouper::Detached( Int64 asyncScannerId ) {
+		// the detached callbacks are shared by all scanners of the asynchronous result
+		if( asyncScannerId != id && (context == nullptr || asyncScannerId != context->Id) ) {
+			return;
+		}
+
+		asyncResult->DetachAsyncScannerDetached( detached );
+		try {
+			if( !stopped && building->Count > 0 ) {
+				callback( context, building );
+			}
+		}
+		catch( Exception^ e ) {
+			Logging::TraceException( e );
+		}
+		finally {
+			stopped = true;
+			building->Clear();
+		}
+	}
+
+}
\ No newline at end of file
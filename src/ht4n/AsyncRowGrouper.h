@@ -0,0 +1,80 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#pragma once
+
+#ifndef __cplusplus_cli
+#error "requires /clr"
+#endif
+
+#include "AsyncRowCallback.h"
+
+namespace Hypertable {
+	using namespace System;
+
+	ref class AsyncResult;
+	ref class AsyncScannerContext;
+	ref class ScanBlock;
+	ref class StringCache;
+
+	/// <summary>
+	/// Groups the scan blocks of an asynchronous scanner into rows.
+	/// </summary>
+	/// <remarks>
+	/// The row boundaries are detected by comparing the utf8 encoded row keys of the scan block, a row spanning
+	/// several blocks is completed by the subsequent blocks. The last row is delivered once the scanner has been
+	/// detached, unless a callback returned Cancel or Abort.
+	/// </remarks>
+	ref class AsyncRowGrouper sealed {
+
+		internal:
+
+			AsyncRowGrouper( AsyncResult^ asyncResult, AsyncRowCallback^ callback );
+
+			/// <summary>
+			/// Gets or sets the asynchronous scanner identifier, zero if not yet known.
+			/// </summary>
+			property Int64 Id {
+				Int64 get( ) {
+					return id;
+				}
+				void set( Int64 value ) {
+					id = value;
+				}
+			}
+
+			AsyncCallbackResult Scanned( AsyncScannerContext^ asyncScannerContext, ScanBlock^ block );
+			void Detached( Int64 asyncScannerId );
+
+		private:
+
+			AsyncResult^ asyncResult;
+			AsyncRowCallback^ callback;
+			Action<Int64>^ detached;
+			AsyncScannerContext^ context;
+			StringCache^ stringCache;
+			Row^ building;
+			Int64 id;
+			bool stopped;
+	};
+
+}
\ No newline at end of file
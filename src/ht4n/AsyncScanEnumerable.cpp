@@ -0,0 +1,271 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+
+#include "stdafx.h"
+
+#ifdef NETCORE
+
+#include "AsyncScanEnumerable.h"
+#include "AsyncScannerCallback.h"
+#include "AsyncScannerContext.h"
+#include "AsyncResult.h"
+#include "Table.h"
+#include "ScanSpec.h"
+#include "Cell.h"
+
+namespace Hypertable {
+	using namespace System;
+
+	AsyncScanBatchEnumerable::AsyncScanBatchEnumerable( Table^ _table, ScanSpec^ _scanSpec, CancellationToken _cancellationToken )
+	: table( _table )
+	, scanSpec( _scanSpec )
+	, cancellationToken( _cancellationToken )
+	{
+	}
+
+	IAsyncEnumerator<IReadOnlyList<Cell^>^>^ AsyncScanBatchEnumerable::GetAsyncEnumerator( CancellationToken enumeratorCancellationToken ) {
+		return CreateEnumerator( enumeratorCancellationToken );
+	}
+
+	AsyncScanBatchEnumerator^ AsyncScanBatchEnumerable::CreateEnumerator( CancellationToken enumeratorCancellationToken ) {
+		return gcnew AsyncScanBatchEnumerator( table, scanSpec, cancellationToken, enumeratorCancellationToken );
+	}
+
+	AsyncScanEnumerable::AsyncScanEnumerable( Table^ table, ScanSpec^ scanSpec, CancellationToken cancellationToken )
+	: batches( gcnew AsyncScanBatchEnumerable(table, scanSpec, cancellationToken) )
+	{
+	}
+
+	IAsyncEnumerator<Cell^>^ AsyncScanEnumerable::GetAsyncEnumerator( CancellationToken cancellationToken ) {
+		AsyncScanBatchEnumerator^ enumerator = batches->CreateEnumerator( cancellationToken );
+		return gcnew AsyncScanEnumerator( enumerator, enumerator->Token );
+	}
+
+	AsyncScanBatchEnumerator::AsyncScanBatchEnumerator( Table^ _table, ScanSpec^ _scanSpec, CancellationToken cancellationToken, CancellationToken enumeratorCancellationToken )
+	: table( _table )
+	, scanSpec( _scanSpec )
+	, asyncResult( nullptr )
+	, asyncScannerContext( nullptr )
+	, cts( CancellationTokenSource::CreateLinkedTokenSource(cancellationToken, enumeratorCancellationToken) )
+	, completed( gcnew TaskCompletionSource<bool>(TaskCreationOptions::RunContinuationsAsynchronously) )
+	, current( nullptr )
+	, failure( nullptr )
+	, syncRoot( gcnew Object() )
+	, completing( 0 )
+	, started( false )
+	, disposed( false )
+	, consumerTimeout( _scanSpec != nullptr && _scanSpec->ConsumerTimeout > TimeSpan::Zero ? static_cast<int>(Math::Min(_scanSpec->ConsumerTimeout.TotalMilliseconds, static_cast<double>(Int32::MaxValue))) : Timeout::Infinite )
+	{
+		token = cts->Token;
+		BoundedChannelOptions^ options = gcnew BoundedChannelOptions( capacity );
+		options->FullMode = BoundedChannelFullMode::Wait;
+		options->SingleReader = true;
+		channel = Channel::CreateBounded<IReadOnlyList<Cell^>^>( options );
+	}
+
+	ValueTask<bool> AsyncScanBatchEnumerator::MoveNextAsync( ) {
+		if( disposed ) throw gcnew ObjectDisposedException( GetType()->Name );
+
+		token.ThrowIfCancellationRequested();
+		if( !started ) {
+			Start();
+		}
+
+		IReadOnlyList<Cell^>^ batch;
+		if( channel->Reader->TryRead(batch) ) {
+			current = batch;
+			return ValueTask<bool>( true );
+		}
+
+		return ValueTask<bool>( channel->Reader->WaitToReadAsync(token).AsTask()->ContinueWith(gcnew Func<Task<bool>^, bool>(this, &AsyncScanBatchEnumerator::Read), TaskContinuationOptions::ExecuteSynchronously) );
+	}
+
+	ValueTask AsyncScanBatchEnumerator::DisposeAsync( ) {
+		if( disposed ) {
+			return ValueTask( );
+		}
+
+		disposed = true;
+		current = nullptr;
+		if( !started ) {
+			cts->Dispose();
+			return ValueTask( );
+		}
+
+		// cancels the asynchronous scanner and releases a callback waiting for the consumer
+		cts->Cancel();
+		return ValueTask( completed->Task->ContinueWith(gcnew Action<Task^>(this, &AsyncScanBatchEnumerator::Disposed), TaskContinuationOptions::ExecuteSynchronously) );
+	}
+
+	void AsyncScanBatchEnumerator::Start( ) {
+		started = true;
+		{
+			// completion might be signalled before BeginScan returns, Complete waits for the lock
+			msclr::lock sync( syncRoot );
+			asyncResult = gcnew AsyncResult();
+			asyncResult->AttachAsyncScannerDetached( gcnew Action<Int64>(this, &AsyncScanBatchEnumerator::Detached) );
+			try {
+				table->BeginScan( asyncResult, scanSpec, gcnew AsyncScannerCallback(this, &AsyncScanBatchEnumerator::Scanned) );
+			}
+			catch( Exception^ ) {
+				sync.release();
+				Complete( nullptr );
+				throw;
+			}
+
+			registration = token.Register( gcnew Action(this, &AsyncScanBatchEnumerator::Cancel) );
+		}
+	}
+
+	AsyncCallbackResult AsyncScanBatchEnumerator::Scanned( AsyncScannerContext^ _asyncScannerContext, IList<Cell^>^ cells ) {
+		asyncScannerContext = _asyncScannerContext;
+		if( cells->Count == 0 ) {
+			return AsyncCallbackResult::Continue;
+		}
+
+		IReadOnlyList<Cell^>^ batch = dynamic_cast<IReadOnlyList<Cell^>^>( cells );
+		if( batch == nullptr ) {
+			batch = gcnew List<Cell^>( cells );
+		}
+
+		ChannelWriter<IReadOnlyList<Cell^>^>^ writer = channel->Writer;
+		while( !writer->TryWrite(batch) ) {
+			// the channel is full, hold the scanner callback for a bounded time until the consumer catches up,
+			// an abandoned enumerator must not pin the native callback thread
+			Task<bool>^ wait = writer->WaitToWriteAsync( token ).AsTask();
+			try {
+				if( !wait->Wait(consumerTimeout) ) {
+					failure = gcnew TimeoutException( L"Asynchronous scan has been cancelled, the consumer did not keep up with the scanner" );
+					return AsyncCallbackResult::Cancel;
+				}
+				if( !wait->Result ) {
+					return AsyncCallbackResult::Cancel;
+				}
+			}
+			catch( AggregateException^ ) {
+				return AsyncCallbackResult::Cancel;
+			}
+		}
+
+		return AsyncCallbackResult::Continue;
+	}
+
+	bool AsyncScanBatchEnumerator::Read( Task<bool>^ task ) {
+		IReadOnlyList<Cell^>^ batch;
+		if( task->GetAwaiter().GetResult() && channel->Reader->TryRead(batch) ) {
+			current = batch;
+			return true;
+		}
+
+		current = nullptr;
+		return false;
+	}
+
+	void AsyncScanBatchEnumerator::Cancel( ) {
+		msclr::lock sync( syncRoot );
+		if( asyncResult != nullptr ) {
+			AsyncScannerContext^ ctx = asyncScannerContext;
+			if( ctx != nullptr ) {
+				asyncResult->CancelAsyncScanner( ctx );
+			}
+			else {
+				asyncResult->Cancel();
+			}
+		}
+	}
+
+	void AsyncScanBatchEnumerator::Detached( Int64 ) {
+		// called on the native scanner thread, the asynchronous result must not be deleted from there
+		ThreadPool::QueueUserWorkItem( gcnew WaitCallback(this, &AsyncScanBatchEnumerator::Complete) );
+	}
+
+	void AsyncScanBatchEnumerator::Complete( Object^ ) {
+		if( Interlocked::Exchange(completing, 1) != 0 ) {
+			return;
+		}
+
+		Exception^ error = nullptr;
+		{
+			msclr::lock sync( syncRoot );
+			if( asyncResult != nullptr ) {
+				error = asyncResult->Error;
+				delete asyncResult;
+				asyncResult = nullptr;
+			}
+		}
+
+		registration.Dispose();
+		if( failure != nullptr ) {
+			error = failure;
+		}
+		else if( token.IsCancellationRequested ) {
+			error = nullptr;
+		}
+		channel->Writer->TryComplete( error );
+		completed->TrySetResult( true );
+	}
+
+	void AsyncScanBatchEnumerator::Disposed( Task^ ) {
+		cts->Dispose();
+	}
+
+	AsyncScanEnumerator::AsyncScanEnumerator( IAsyncEnumerator<IReadOnlyList<Cell^>^>^ _batches, CancellationToken _cancellationToken )
+	: batches( _batches )
+	, batch( nullptr )
+	, cancellationToken( _cancellationToken )
+	, index( 0 )
+	{
+	}
+
+	ValueTask<bool> AsyncScanEnumerator::MoveNextAsync( ) {
+		cancellationToken.ThrowIfCancellationRequested();
+		if( batch != nullptr && ++index < batch->Count ) {
+			return ValueTask<bool>( true );
+		}
+
+		ValueTask<bool> next = batches->MoveNextAsync();
+		if( next.IsCompletedSuccessfully ) {
+			return ValueTask<bool>( Advance(next.Result) );
+		}
+
+		return ValueTask<bool>( next.AsTask()->ContinueWith(gcnew Func<Task<bool>^, bool>(this, &AsyncScanEnumerator::Advanced), TaskContinuationOptions::ExecuteSynchronously) );
+	}
+
+	ValueTask AsyncScanEnumerator::DisposeAsync( ) {
+		batch = nullptr;
+		return batches->DisposeAsync();
+	}
+
+	bool AsyncScanEnumerator::Advance( bool more ) {
+		index = 0;
+		batch = more ? batches->Current : nullptr;
+		return more;
+	}
+
+	bool AsyncScanEnumerator::Advanced( Task<bool>^ task ) {
+		return Advance( task->GetAwaiter().GetResult() );
+	}
+
+}
+
+#endif
\ No newline at end of file
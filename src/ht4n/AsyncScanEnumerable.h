@@ -0,0 +1,186 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+
+#pragma once
+
+#ifndef __cplusplus_cli
+#error "requires /clr"
+#endif
+
+#ifdef NETCORE
+
+#include "AsyncCallbackResult.h"
+
+namespace Hypertable {
+	using namespace System;
+	using namespace System::Collections::Generic;
+	using namespace System::Threading;
+	using namespace System::Threading::Channels;
+	using namespace System::Threading::Tasks;
+
+	ref class Cell;
+	ref class Table;
+	ref class AsyncScanBatchEnumerator;
+	ref class ScanSpec;
+	ref class AsyncResult;
+	ref class AsyncScannerContext;
+
+	/// <summary>
+	/// Represents an asynchronous scan which yields the scanned cells in batches.
+	/// </summary>
+	/// <remarks>
+	/// Each enumeration starts an asynchronous scanner, the scanner callback posts the scanned cells into a bounded
+	/// channel. The enumerator awaits the channel and never blocks. If the channel is full the scanner callback thread
+	/// waits for the consumer, at most ScanSpec.ConsumerTimeout, then the scan fails with a TimeoutException.
+	/// Cancellation cancels the asynchronous scanner.
+	/// </remarks>
+	ref class AsyncScanBatchEnumerable sealed : public IAsyncEnumerable<IReadOnlyList<Cell^>^> {
+
+		public:
+
+			virtual IAsyncEnumerator<IReadOnlyList<Cell^>^>^ GetAsyncEnumerator( CancellationToken cancellationToken );
+
+		internal:
+
+			AsyncScanBatchEnumerable( Table^ table, ScanSpec^ scanSpec, CancellationToken cancellationToken );
+
+			AsyncScanBatchEnumerator^ CreateEnumerator( CancellationToken cancellationToken );
+
+		private:
+
+			Table^ table;
+			ScanSpec^ scanSpec;
+			CancellationToken cancellationToken;
+	};
+
+	/// <summary>
+	/// Represents an asynchronous scan which yields the scanned cells one by one.
+	/// </summary>
+	ref class AsyncScanEnumerable sealed : public IAsyncEnumerable<Cell^> {
+
+		public:
+
+			virtual IAsyncEnumerator<Cell^>^ GetAsyncEnumerator( CancellationToken cancellationToken );
+
+		internal:
+
+			AsyncScanEnumerable( Table^ table, ScanSpec^ scanSpec, CancellationToken cancellationToken );
+
+		private:
+
+			AsyncScanBatchEnumerable^ batches;
+	};
+
+	/// <summary>
+	/// Enumerates the cell batches of an asynchronous scanner.
+	/// </summary>
+	ref class AsyncScanBatchEnumerator sealed : public IAsyncEnumerator<IReadOnlyList<Cell^>^> {
+
+		public:
+
+			property IReadOnlyList<Cell^>^ Current {
+				virtual IReadOnlyList<Cell^>^ get( ) {
+					return current;
+				}
+			}
+
+			virtual ValueTask<bool> MoveNextAsync( );
+			virtual ValueTask DisposeAsync( );
+
+		internal:
+
+			AsyncScanBatchEnumerator( Table^ table, ScanSpec^ scanSpec, CancellationToken cancellationToken, CancellationToken enumeratorCancellationToken );
+
+			/// <summary>
+			/// Gets the linked cancellation token, remains valid after disposing the enumerator.
+			/// </summary>
+			property CancellationToken Token {
+				CancellationToken get( ) {
+					return token;
+				}
+			}
+
+		private:
+
+			void Start( );
+			AsyncCallbackResult Scanned( AsyncScannerContext^ asyncScannerContext, IList<Cell^>^ cells );
+			bool Read( Task<bool>^ task );
+			void Cancel( );
+			void Detached( Int64 asyncScannerId );
+			void Complete( Object^ state );
+			void Disposed( Task^ task );
+
+			Table^ table;
+			ScanSpec^ scanSpec;
+			AsyncResult^ asyncResult;
+			AsyncScannerContext^ asyncScannerContext;
+			Channel<IReadOnlyList<Cell^>^>^ channel;
+			CancellationTokenSource^ cts;
+			CancellationToken token;
+			CancellationTokenRegistration registration;
+			TaskCompletionSource<bool>^ completed;
+			IReadOnlyList<Cell^>^ current;
+			Exception^ failure;
+			Object^ syncRoot;
+			int completing;
+			bool started;
+			bool disposed;
+			initonly int consumerTimeout;
+
+			static const int capacity = 16;
+	};
+
+	/// <summary>
+	/// Enumerates the cells of an asynchronous scanner.
+	/// </summary>
+	ref class AsyncScanEnumerator sealed : public IAsyncEnumerator<Cell^> {
+
+		public:
+
+			property Cell^ Current {
+				virtual Cell^ get( ) {
+					return batch != nullptr ? batch[index] : nullptr;
+				}
+			}
+
+			virtual ValueTask<bool> MoveNextAsync( );
+			virtual ValueTask DisposeAsync( );
+
+		internal:
+
+			AsyncScanEnumerator( IAsyncEnumerator<IReadOnlyList<Cell^>^>^ batches, CancellationToken cancellationToken );
+
+		private:
+
+			bool Advance( bool more );
+			bool Advanced( Task<bool>^ task );
+
+			IAsyncEnumerator<IReadOnlyList<Cell^>^>^ batches;
+			IReadOnlyList<Cell^>^ batch;
+			CancellationToken cancellationToken;
+			int index;
+	};
+
+}
+
+#endif
\ No newline at end of file
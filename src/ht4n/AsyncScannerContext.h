@@ -25,13 +25,15 @@
 #error "requires /clr"
 #endif
 
+#include "ScanSpec.h"
+#include "StringCache.h"
+
 #include "ht4c.Common/ContextKind.h"
 
 namespace Hypertable {
 	using namespace System;
 
 	interface class ITable;
-	ref class ScanSpec;
 
 	/// <summary>
 	/// Represents a asynchronous table scanner context.
@@ -77,13 +79,21 @@ namespace Hypertable {
 				Common::ContextKind get() { return contextKind; }
 			}
 
+			property Hypertable::StringCache^ StringCache {
+				Hypertable::StringCache^ get() { return stringCache; }
+			}
+
 			AsyncScannerContext( Common::ContextKind _contextKind, int64_t _id, Hypertable::ITable^ _table, Hypertable::ScanSpec^ _scanSpec, Object^ _param )
 				: contextKind( _contextKind )
 				, id( _id )
 				, table( _table )
 				, scanSpec( _scanSpec )
 				, param( _param )
+				, stringCache( nullptr )
 			{
+				if( scanSpec != nullptr && (scanSpec->Flags & ScannerFlags::InternStrings) == ScannerFlags::InternStrings ) {
+					stringCache = gcnew Hypertable::StringCache();
+				}
 			}
 
 		private:
@@ -93,6 +103,7 @@ namespace Hypertable {
 			Hypertable::ITable^ table;
 			Hypertable::ScanSpec^ scanSpec;
 			Object^ param;
+			Hypertable::StringCache^ stringCache;
 	};
 
 }
\ No newline at end of file
@@ -26,6 +26,7 @@
 #include "AsyncScannerContext.h"
 #include "AsyncMutatorContext.h"
 #include "Exception.h"
+#include "HypertableEventSource.h"
 
 #include "ht4c.Common/Cell.h"
 #include "ht4c.Common/Cells.h"
@@ -52,8 +53,10 @@ namespace Hypertable {
 
 		public:
 
-			explicit BlockingAsyncResultSink( List<Cell^>^ _result )
+			BlockingAsyncResultSink( List<Cell^>^ _result, Dictionary<int64_t, AsyncScannerContext^>^ _map, Object^ _syncRoot )
 			: result( _result )
+			, map( _map )
+			, syncRoot( _syncRoot )
 			, asyncScannerId( 0 )
 			, exception( 0 )
 			, resetException( false )
@@ -89,12 +92,24 @@ namespace Hypertable {
 
 			virtual Common::AsyncCallbackResult scannedCells( int64_t _asyncScannerId, Common::Cells& cells ) {
 				Common::Cell* _cell = 0;
+				HypertableEventSource::Scanned( cells );
+				HypertableEventSource::Delivered( static_cast<int>(cells.size()) );
 				try {
+					StringCache^ stringCache = getStringCache( _asyncScannerId );
 					result->Capacity = (int)cells.size();
 					_cell = Common::Cell::create();
-					for( size_t n = 0; n < cells.size(); ++n ) {
-						cells.get_unchecked( n, _cell );
-						result->Add( gcnew Cell(_cell) );
+					if( stringCache != nullptr ) {
+						msclr::lock sync( stringCache );
+						for( size_t n = 0; n < cells.size(); ++n ) {
+							cells.get_unchecked( n, _cell );
+							result->Add( gcnew Cell(_cell, stringCache) );
+						}
+					}
+					else {
+						for( size_t n = 0; n < cells.size(); ++n ) {
+							cells.get_unchecked( n, _cell );
+							result->Add( gcnew Cell(_cell) );
+						}
 					}
 				}
 				finally {
@@ -115,10 +130,18 @@ namespace Hypertable {
 				}
 			}
 
+			StringCache^ getStringCache( int64_t _asyncScannerId ) {
+				AsyncScannerContext^ asyncScannerContext;
+				msclr::lock sync( static_cast<Object^>(syncRoot) );
+				return map->TryGetValue( _asyncScannerId, asyncScannerContext ) ? asyncScannerContext->StringCache : nullptr;
+			}
+
 			BlockingAsyncResultSink( const BlockingAsyncResultSink& );
 			BlockingAsyncResultSink& operator = ( const BlockingAsyncResultSink& );
 
 			gcroot<List<Cell^>^> result;
+			gcroot<Dictionary<int64_t, AsyncScannerContext^>^> map;
+			gcroot<Object^> syncRoot;
 			int64_t asyncScannerId;
 			Common::HypertableException* exception;
 			bool resetException;
@@ -153,7 +176,7 @@ namespace Hypertable {
 		HT4N_TRY {
 			List<Cell^>^ l = gcnew List<Cell^>();
 			cells = l;
-			asyncResultSink = new BlockingAsyncResultSink( l );
+			asyncResultSink = new BlockingAsyncResultSink( l, map, syncRoot );
 			std::vector<bool> completed(size, false);
 			for( int probe = 0; probe < 2; ++probe ) {
 				for( int n = 0; n < size; ++n ) {
@@ -195,7 +218,7 @@ namespace Hypertable {
 		HT4N_TRY {
 			List<Cell^>^ l = gcnew List<Cell^>();
 			cells = l;
-			asyncResultSink = new BlockingAsyncResultSink( l );
+			asyncResultSink = new BlockingAsyncResultSink( l, map, syncRoot );
 			std::vector<bool> completed(size, false);
 			for( int probe = 0; probe < 2; ++probe ) {
 				for( int n = 0; n < size; ++n ) {
@@ -24,6 +24,8 @@
 #include "BufferedCell.h"
 #include "Cell.h"
 #include "Key.h"
+#include "ValueCodecMap.h"
+#include "IValueCodec.h"
 
 #include "ht4c.Common/Cell.h"
 
@@ -51,14 +53,38 @@ namespace Hypertable {
 
 	BufferedCell::BufferedCell( const Common::Cell* cell ) {
 		if( cell ) {
-			From( *cell );
+			From( *cell, nullptr );
+		}
+	}
+
+	BufferedCell::BufferedCell( const Common::Cell* cell, StringCache^ stringCache ) {
+		if( cell ) {
+			From( *cell, stringCache );
 		}
 	}
 
 	void BufferedCell::From( const Common::Cell& cell ) {
-		Key = gcnew Hypertable::Key( cell );
+		From( cell, nullptr );
+	}
 
-		if( (valueLength = static_cast<int>(cell.valueLength())) > 0 ) {
+	void BufferedCell::From( const Common::Cell& cell, StringCache^ stringCache ) {
+		From( cell, stringCache, nullptr );
+	}
+
+	void BufferedCell::From( const Common::Cell& cell, StringCache^ stringCache, ValueCodecMap^ valueCodecs ) {
+		Key = gcnew Hypertable::Key( cell, stringCache );
+
+		int decodedLength;
+		IValueCodec^ codec;
+		if( (valueLength = static_cast<int>(cell.valueLength())) > 0 && valueCodecs != nullptr && (codec = valueCodecs->GetEncoded(Key->ColumnFamily, cell.value(), valueLength, decodedLength)) != nullptr ) {
+			if( value == nullptr || value->Length < decodedLength ) {
+				value = gcnew cli::array<Byte>( decodedLength );
+			}
+			pin_ptr<Byte> pv = &value[0];
+			ValueCodecMap::Decode( codec, cell.value(), valueLength, pv, decodedLength );
+			valueLength = decodedLength;
+		}
+		else if( valueLength > 0 ) {
 			if( value == nullptr || value->Length < valueLength ) {
 				value = gcnew cli::array<Byte>( valueLength );
 			}
@@ -37,6 +37,8 @@ namespace Hypertable {
 	using namespace ht4c;
 
 	ref class Key;
+	ref class StringCache;
+	ref class ValueCodecMap;
 	ref class Counter;
 
 	/// <summary>
@@ -114,7 +116,10 @@ namespace Hypertable {
 		internal:
 
 			BufferedCell( const Common::Cell* cell );
+			BufferedCell( const Common::Cell* cell, StringCache^ stringCache );
 			void From( const Common::Cell& cell );
+			void From( const Common::Cell& cell, StringCache^ stringCache );
+			void From( const Common::Cell& cell, StringCache^ stringCache, ValueCodecMap^ valueCodecs );
 
 		private:
 
@@ -0,0 +1,78 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#include "stdafx.h"
+
+#include "BulkLoadOptions.h"
+
+namespace Hypertable {
+	using namespace System;
+	using namespace System::Text;
+	using namespace System::Globalization;
+
+	BulkLoadOptions::BulkLoadOptions( ) {
+		Mutators = 1;
+		BlockSize = 1024 * 1024;
+		MaxChunkSize = 256 * 1024;
+	}
+
+	BulkLoadOptions::BulkLoadOptions( BulkLoadOptions^ other ) {
+		if( other == nullptr ) throw gcnew ArgumentNullException( L"other" );
+
+		Workers = other->Workers;
+		Mutators = other->Mutators;
+		BlockSize = other->BlockSize;
+		MaxChunkSize = other->MaxChunkSize;
+		MaxParseErrors = other->MaxParseErrors;
+		NoEscape = other->NoEscape;
+		Timeout = other->Timeout;
+		Flags = other->Flags;
+	}
+
+	String^ BulkLoadOptions::ToString() {
+
+		#define APPEND_INT( what ) if( what > 0 ) sb->Append( String::Format(CultureInfo::InvariantCulture, L#what L"={0}, ", what) );
+		#define APPEND_BOOL( what ) if( what ) sb->Append( L#what L", " );
+		#define APPEND_TIMESPAN( what ) if( what.Ticks > 0 ) sb->Append( String::Format(CultureInfo::InvariantCulture, L#what L"={0}, ", what) );
+
+		StringBuilder^ sb = gcnew StringBuilder();
+		sb->Append( GetType() );
+		sb->Append( L"(" );
+
+		APPEND_INT( Workers )
+		APPEND_INT( Mutators )
+		APPEND_INT( BlockSize )
+		APPEND_INT( MaxChunkSize )
+		APPEND_INT( MaxParseErrors )
+		APPEND_BOOL( NoEscape )
+		APPEND_TIMESPAN( Timeout )
+		sb->Append( String::Format(CultureInfo::InvariantCulture, L"Flags={0}", Flags) );
+		sb->Append( L")" );
+
+		return sb->ToString();
+
+		#undef APPEND_TIMESPAN
+		#undef APPEND_BOOL
+		#undef APPEND_INT
+	}
+
+}
\ No newline at end of file
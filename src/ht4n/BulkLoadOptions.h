@@ -0,0 +1,122 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#pragma once
+
+#ifndef __cplusplus_cli
+#error "requires /clr"
+#endif
+
+#include "MutatorFlags.h"
+
+namespace Hypertable {
+	using namespace System;
+
+	/// <summary>
+	/// Represents the bulk load options.
+	/// </summary>
+	/// <example>
+	/// The following example shows how to load a tab delimited file.
+	/// <code>
+	/// var options = new BulkLoadOptions();
+	/// options.Flags = MutatorFlags.NoLogSync;
+	/// var statistics = table.BulkLoad( "data.tsv", options );
+	/// Trace.WriteLine( statistics );
+	/// </code>
+	/// </example>
+	/// <seealso cref="ITable.BulkLoad(String, BulkLoadOptions)"/>
+	/// <seealso cref="BulkLoadStatistics"/>
+	[Serializable]
+	public ref class BulkLoadOptions sealed {
+
+		public:
+
+			/// <summary>
+			/// Gets or sets the number of parser threads.
+			/// </summary>
+			/// <remarks>Defaults to zero, which uses one parser thread per processor.</remarks>
+			property int Workers;
+
+			/// <summary>
+			/// Gets or sets the number of native mutators the parsed cells are passed to.
+			/// </summary>
+			/// <remarks>Defaults to 1, parser threads are assigned to the mutators round robin.</remarks>
+			property int Mutators;
+
+			/// <summary>
+			/// Gets or sets the number of input bytes per parser work item.
+			/// </summary>
+			/// <remarks>Defaults to 1MB, work items are split on line boundaries.</remarks>
+			property int BlockSize;
+
+			/// <summary>
+			/// Gets or sets the maximum number of bytes passed to the native mutator at once.
+			/// </summary>
+			/// <remarks>Defaults to 256kB</remarks>
+			property UInt32 MaxChunkSize;
+
+			/// <summary>
+			/// Gets or sets the maximum number of malformed lines skipped before the bulk load will be aborted.
+			/// </summary>
+			/// <remarks>
+			/// Set to zero (default value) for skipping any number of malformed lines, the number of
+			/// malformed lines is reported by BulkLoadStatistics.ParseErrors.
+			/// </remarks>
+			property Int64 MaxParseErrors;
+
+			/// <summary>
+			/// Gets or sets a value indicating whether values are taken verbatim.
+			/// </summary>
+			/// <remarks>
+			/// Defaults to false, which unescapes \n, \t, \\ and \0 in values as written by the Hypertable DUMP TABLE command.
+			/// </remarks>
+			property bool NoEscape;
+
+			/// <summary>
+			/// Gets or sets the maximum time to allow the native mutator methods to execute before time out, if zero timeout is disabled.
+			/// </summary>
+			property TimeSpan Timeout;
+
+			/// <summary>
+			/// Gets or sets the table mutator flags.
+			/// </summary>
+			property MutatorFlags Flags;
+
+			/// <summary>
+			/// Initializes a new instance of the BulkLoadOptions class.
+			/// </summary>
+			BulkLoadOptions( );
+
+			/// <summary>
+			/// Initializes a new instance of the BulkLoadOptions class identical to the specified options.
+			/// </summary>
+			/// <param name="other">Bulk load options to copy.</param>
+			BulkLoadOptions( BulkLoadOptions^ other );
+
+			/// <summary>
+			/// Returns a string that represents the current object.
+			/// </summary>
+			/// <returns>A string that represents the current object.</returns>
+			virtual String^ ToString() override;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,279 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#pragma once
+
+#ifndef __cplusplus_cli
+#error "requires /clr"
+#endif
+
+#include <string>
+#include <cstring>
+
+#include "ht4c.Common/Cells.h"
+
+#pragma managed( push, off )
+
+namespace Hypertable {
+
+	/// <summary>
+	/// Native parser for the Hypertable LOAD DATA INFILE tab delimited format.
+	/// </summary>
+	/// <remarks>
+	/// Each line consists of row, column and value or, if declared by the header line, of timestamp,
+	/// row, column and value. The column is either column family or column family:column qualifier,
+	/// timestamps are nanoseconds since epoch or formatted as 'YYYY-MM-DD HH:MM:SS[.nanoseconds]' (UTC). Escaped values (\\n, \\t, \\\\, \\0)
+	/// will be unescaped unless disabled. The parser reuses its field buffers, parsing does not allocate
+	/// once the buffers have grown to the longest field.
+	/// </remarks>
+	class BulkLoadParser {
+
+		public:
+
+			struct Counters {
+				Counters( )
+				: lines( 0 )
+				, cells( 0 )
+				, errors( 0 )
+				{
+				}
+
+				uint64_t lines;
+				uint64_t cells;
+				uint64_t errors;
+			};
+
+			explicit BulkLoadParser( bool _unescape )
+			: unescape( _unescape )
+			{
+			}
+
+			/// <summary>
+			/// Parses the lines [p, end) into the cells specified, timestamps indicates a leading timestamp field.
+			/// </summary>
+			/// <returns>
+			/// The position of the first line not parsed, parsing stops after the line which
+			/// makes the cells exceed maxBytes.
+			/// </returns>
+			const char* parse( const char* p, const char* end, bool timestamps, ht4c::Common::Cells& cells, size_t& bytes, size_t maxBytes, Counters& counters ) {
+				while( p < end && bytes < maxBytes ) {
+					const char* eol = static_cast<const char*>( memchr(p, '\n', end - p) );
+					if( !eol ) {
+						eol = end;
+					}
+					const char* last = eol;
+					if( last > p && last[-1] == '\r' ) {
+						--last;
+					}
+					if( last > p ) {
+						++counters.lines;
+						if( parseLine(p, last, timestamps, cells, bytes) ) {
+							++counters.cells;
+						}
+						else {
+							++counters.errors;
+						}
+					}
+					p = eol < end ? eol + 1 : end;
+				}
+				return p;
+			}
+
+			/// <summary>
+			/// Returns the position after the header line if the input starts with a header line ('#...').
+			/// </summary>
+			static const char* skipHeader( const char* p, const char* end ) {
+				if( p < end && *p == '#' ) {
+					const char* eol = static_cast<const char*>( memchr(p, '\n', end - p) );
+					return eol ? eol + 1 : end;
+				}
+				return p;
+			}
+
+			/// <summary>
+			/// Returns true if the input starts with a header line declaring a leading timestamp field ('#timestamp\trow\t...').
+			/// </summary>
+			static bool hasTimestamps( const char* p, const char* end ) {
+				static const char header[] = "timestamp\t";
+				if( p == end || *p++ != '#' ) {
+					return false;
+				}
+				while( p < end && *p == ' ' ) {
+					++p;
+				}
+				return static_cast<size_t>( end - p ) >= sizeof(header) - 1 && memcmp( p, header, sizeof(header) - 1 ) == 0;
+			}
+
+		private:
+
+			bool parseLine( const char* p, const char* end, bool timestamps, ht4c::Common::Cells& cells, size_t& bytes ) {
+				// values containing tabs are possible if escaping has been disabled
+				const int t = timestamps ? 1 : 0;
+				const char* tabs[3];
+				int n = 0;
+				for( const char* q = p; q < end && n < t + 2; ++q ) {
+					if( *q == '\t' ) {
+						tabs[n++] = q;
+					}
+				}
+				if( n < t + 2 ) {
+					return false;
+				}
+
+				uint64_t timestamp = 0;
+				const char* rowBegin = p;
+				if( timestamps ) {
+					if( !parseTimestamp(p, tabs[0], timestamp) ) {
+						return false;
+					}
+					rowBegin = tabs[0] + 1;
+				}
+				const char* rowEnd = tabs[t];
+				const char* columnBegin = rowEnd + 1;
+				const char* columnEnd = tabs[t + 1];
+				const char* valueBegin = columnEnd + 1;
+				if( rowEnd == rowBegin || columnEnd == columnBegin ) {
+					return false;
+				}
+
+				row.assign( rowBegin, rowEnd );
+				const char* colon = static_cast<const char*>( memchr(columnBegin, ':', columnEnd - columnBegin) );
+				columnFamily.assign( columnBegin, colon ? colon : columnEnd );
+				if( columnFamily.empty() ) {
+					return false;
+				}
+				if( colon ) {
+					columnQualifier.assign( colon + 1, columnEnd );
+				}
+				else {
+					columnQualifier.clear();
+				}
+				assignValue( valueBegin, end );
+
+				cells.add( row.c_str(), columnFamily.c_str(), colon ? columnQualifier.c_str() : 0, timestamp, value.data(), static_cast<uint32_t>(value.size()), ht4c::Common::CF_Default );
+				bytes += row.size() + columnFamily.size() + columnQualifier.size() + value.size();
+				return true;
+			}
+
+			void assignValue( const char* p, const char* end ) {
+				if( !unescape || !memchr(p, '\\', end - p) ) {
+					value.assign( p, end );
+					return;
+				}
+				value.clear();
+				for( ; p < end; ++p ) {
+					if( *p == '\\' && p + 1 < end ) {
+						switch( p[1] ) {
+							case 'n': value.push_back( '\n' ); ++p; continue;
+							case 't': value.push_back( '\t' ); ++p; continue;
+							case '\\': value.push_back( '\\' ); ++p; continue;
+							case '0': value.push_back( '\0' ); ++p; continue;
+						}
+					}
+					value.push_back( *p );
+				}
+			}
+
+			static bool parseTimestamp( const char* p, const char* end, uint64_t& timestamp ) {
+				if( p == end ) {
+					return false;
+				}
+				const char* q = p;
+				uint64_t ns = 0;
+				while( q < end && *q >= '0' && *q <= '9' ) {
+					ns = ns * 10 + (*q++ - '0');
+				}
+				if( q == end ) {
+					timestamp = ns;
+					return true;
+				}
+
+				// YYYY-MM-DD HH:MM:SS[.fraction]
+				int year, month, day, hour, minute, second;
+				q = p;
+				if( !digits(q, end, 4, year) || !expect(q, end, '-') || !digits(q, end, 2, month) || !expect(q, end, '-') || !digits(q, end, 2, day)
+				 || !expect(q, end, ' ') || !digits(q, end, 2, hour) || !expect(q, end, ':') || !digits(q, end, 2, minute) || !expect(q, end, ':') || !digits(q, end, 2, second) ) {
+					return false;
+				}
+				if( month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60 || year < 1970 ) {
+					return false;
+				}
+				uint64_t fraction = 0;
+				if( q < end ) {
+					if( *q++ != '.' ) {
+						return false;
+					}
+					int scale = 0;
+					while( q < end && scale < 9 && *q >= '0' && *q <= '9' ) {
+						fraction = fraction * 10 + (*q++ - '0');
+						++scale;
+					}
+					if( q != end || !scale ) {
+						return false;
+					}
+					for( ; scale < 9; ++scale ) {
+						fraction *= 10;
+					}
+				}
+				const uint64_t seconds = static_cast<uint64_t>( daysFromCivil(year, month, day) ) * 86400 + hour * 3600 + minute * 60 + second;
+				timestamp = seconds * 1000000000ULL + fraction;
+				return true;
+			}
+
+			static bool digits( const char*& p, const char* end, int count, int& v ) {
+				v = 0;
+				for( int n = 0; n < count; ++n, ++p ) {
+					if( p == end || *p < '0' || *p > '9' ) {
+						return false;
+					}
+					v = v * 10 + (*p - '0');
+				}
+				return true;
+			}
+
+			static bool expect( const char*& p, const char* end, char c ) {
+				return p < end && *p++ == c;
+			}
+
+			static int64_t daysFromCivil( int y, int m, int d ) {
+				// days since 1970-01-01 in the proleptic gregorian calendar
+				y -= m <= 2;
+				const int era = y / 400;
+				const int yoe = y - era * 400;
+				const int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+				const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+				return static_cast<int64_t>( era ) * 146097 + doe - 719468;
+			}
+
+			BulkLoadParser( const BulkLoadParser& );
+			BulkLoadParser& operator = ( const BulkLoadParser& );
+
+			const bool unescape;
+			std::string row;
+			std::string columnFamily;
+			std::string columnQualifier;
+			std::string value;
+	};
+
+}
+
+#pragma managed( pop )
\ No newline at end of file
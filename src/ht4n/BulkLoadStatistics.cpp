@@ -0,0 +1,80 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#include "stdafx.h"
+
+#include "BulkLoadStatistics.h"
+
+namespace Hypertable {
+	using namespace System;
+	using namespace System::Text;
+	using namespace System::Threading;
+	using namespace System::Globalization;
+
+	String^ BulkLoadStatistics::ToString() {
+
+		#define APPEND_INT( what ) if( what > 0 ) sb->Append( String::Format(CultureInfo::InvariantCulture, L#what L"={0}, ", what) );
+
+		StringBuilder^ sb = gcnew StringBuilder();
+		sb->Append( GetType() );
+		sb->Append( L"(" );
+
+		APPEND_INT( Bytes )
+		APPEND_INT( Lines )
+		APPEND_INT( Cells )
+		APPEND_INT( ParseErrors )
+		if( Elapsed.Ticks > 0 ) sb->Append( String::Format(CultureInfo::InvariantCulture, L"Elapsed={0}, ", Elapsed) );
+		APPEND_INT( BytesPerSecond )
+		APPEND_INT( CellsPerSecond )
+		if( sb[sb->Length - 1] == L' ' ) {
+			sb->Length -= 2;
+		}
+		sb->Append( L")" );
+
+		return sb->ToString();
+
+		#undef APPEND_INT
+	}
+
+	BulkLoadStatistics::BulkLoadStatistics( )
+	: bytes( 0 )
+	, lines( 0 )
+	, cells( 0 )
+	, parseErrors( 0 )
+	{
+	}
+
+	void BulkLoadStatistics::AddBytes( Int64 count ) {
+		Interlocked::Add( bytes, count );
+	}
+
+	Int64 BulkLoadStatistics::AddParsed( Int64 lineCount, Int64 cellCount, Int64 errorCount ) {
+		Interlocked::Add( lines, lineCount );
+		Interlocked::Add( cells, cellCount );
+		return Interlocked::Add( parseErrors, errorCount );
+	}
+
+	void BulkLoadStatistics::SetElapsed( TimeSpan value ) {
+		elapsed = value;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#pragma once
+
+#ifndef __cplusplus_cli
+#error "requires /clr"
+#endif
+
+namespace Hypertable {
+	using namespace System;
+
+	/// <summary>
+	/// Represents bulk load statistics.
+	/// </summary>
+	/// <seealso cref="ITable.BulkLoad(String, BulkLoadOptions)"/>
+	/// <seealso cref="BulkLoadOptions"/>
+	public ref class BulkLoadStatistics sealed {
+
+		public:
+
+			/// <summary>
+			/// Gets the number of input bytes read.
+			/// </summary>
+			property Int64 Bytes {
+				Int64 get( ) {
+					return Threading::Interlocked::Read( bytes );
+				}
+			}
+
+			/// <summary>
+			/// Gets the number of non-empty input lines, including malformed lines.
+			/// </summary>
+			property Int64 Lines {
+				Int64 get( ) {
+					return Threading::Interlocked::Read( lines );
+				}
+			}
+
+			/// <summary>
+			/// Gets the number of cells passed to the native mutators.
+			/// </summary>
+			property Int64 Cells {
+				Int64 get( ) {
+					return Threading::Interlocked::Read( cells );
+				}
+			}
+
+			/// <summary>
+			/// Gets the number of malformed lines which have been skipped.
+			/// </summary>
+			property Int64 ParseErrors {
+				Int64 get( ) {
+					return Threading::Interlocked::Read( parseErrors );
+				}
+			}
+
+			/// <summary>
+			/// Gets the elapsed time, including the final flush.
+			/// </summary>
+			property TimeSpan Elapsed {
+				TimeSpan get( ) {
+					return elapsed;
+				}
+			}
+
+			/// <summary>
+			/// Gets the throughput in input bytes per second.
+			/// </summary>
+			property double BytesPerSecond {
+				double get( ) {
+					return elapsed.Ticks > 0 ? Bytes / elapsed.TotalSeconds : 0.0;
+				}
+			}
+
+			/// <summary>
+			/// Gets the throughput in cells per second.
+			/// </summary>
+			property double CellsPerSecond {
+				double get( ) {
+					return elapsed.Ticks > 0 ? Cells / elapsed.TotalSeconds : 0.0;
+				}
+			}
+
+			/// <summary>
+			/// Returns a string that represents the current object.
+			/// </summary>
+			/// <returns>A string that represents the current object.</returns>
+			virtual String^ ToString() override;
+
+		internal:
+
+			BulkLoadStatistics( );
+
+			void AddBytes( Int64 count );
+			Int64 AddParsed( Int64 lineCount, Int64 cellCount, Int64 errorCount );
+			void SetElapsed( TimeSpan value );
+
+		private:
+
+			Int64 bytes;
+			Int64 lines;
+			Int64 cells;
+			Int64 parseErrors;
+			TimeSpan elapsed;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,265 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#include "stdafx.h"
+
+#include "BulkLoader.h"
+#include "BulkLoadOptions.h"
+#include "BulkLoadStatistics.h"
+#include "BulkLoadParser.h"
+#include "MutatorSpec.h"
+#include "Logging.h"
+#include "Exception.h"
+
+#include "ht4c.Common/Table.h"
+#include "ht4c.Common/TableMutator.h"
+#include "ht4c.Common/Cells.h"
+
+namespace Hypertable {
+	using namespace System;
+	using namespace System::Buffers;
+	using namespace System::Collections::Generic;
+	using namespace System::Diagnostics;
+	using namespace System::Runtime::ExceptionServices;
+	using namespace System::Threading;
+	using namespace System::Threading::Tasks;
+
+	BulkLoader::BulkLoader( Common::Table* _table, BulkLoadOptions^ _options )
+	: table( _table )
+	, options( _options )
+	, timestamps( false )
+	{
+		if( options->Workers < 0 ) throw gcnew ArgumentException( L"Invalid parameter options (Workers < 0)", L"options" );
+		if( options->Mutators < 1 ) throw gcnew ArgumentException( L"Invalid parameter options (Mutators < 1)", L"options" );
+		if( options->BlockSize < 1 ) throw gcnew ArgumentException( L"Invalid parameter options (BlockSize < 1)", L"options" );
+		if( options->MaxChunkSize < 1 ) throw gcnew ArgumentException( L"Invalid parameter options (MaxChunkSize < 1)", L"options" );
+		if( options->MaxParseErrors < 0 ) throw gcnew ArgumentException( L"Invalid parameter options (MaxParseErrors < 0)", L"options" );
+		if( options->Timeout.TotalMilliseconds < 0 ) throw gcnew ArgumentException( L"Invalid parameter options (Timeout < 0)", L"options" );
+	}
+
+	BulkLoadStatistics^ BulkLoader::Load( IO::Stream^ stream ) {
+		Stopwatch^ stopwatch = Stopwatch::StartNew();
+		int workers = options->Workers > 0 ? options->Workers : Environment::ProcessorCount;
+		statistics = gcnew BulkLoadStatistics();
+		blocks = gcnew BlockingCollection<Block>( 2 * workers );
+		cancellation = gcnew CancellationTokenSource();
+		mutators = gcnew cli::array<IntPtr>( Math::Min(options->Mutators, workers) );
+		mutatorLocks = gcnew cli::array<Object^>( mutators->Length );
+
+		HT4N_TRY {
+			List<Task^>^ tasks = gcnew List<Task^>( workers );
+			try {
+				for( int n = 0; n < mutators->Length; ++n ) {
+					mutators[n] = IntPtr( table->createMutator((uint32_t)options->Timeout.TotalMilliseconds, (uint32_t)options->Flags, 0) );
+					mutatorLocks[n] = gcnew Object();
+				}
+
+				for( int n = 0; n < workers; ++n ) {
+					tasks->Add( Task::Factory->StartNew(gcnew Action<Object^>(this, &BulkLoader::Parse), n, CancellationToken::None, TaskCreationOptions::LongRunning, TaskScheduler::Default) );
+				}
+
+				try {
+					Read( stream );
+				}
+				catch( OperationCanceledException^ ) {
+					// a parser has failed, the failure will be rethrown below
+					if( !cancellation->IsCancellationRequested ) {
+						throw;
+					}
+				}
+				finally {
+					blocks->CompleteAdding();
+				}
+
+				try {
+					Task::WaitAll( tasks->ToArray() );
+				}
+				catch( AggregateException^ e ) {
+					// surface the parser failure, the other parsers have been cancelled
+					ExceptionDispatchInfo::Capture( e->Flatten()->InnerExceptions[0] )->Throw();
+				}
+
+				for each( IntPtr mutator in mutators ) {
+					static_cast<Common::TableMutator*>( mutator.ToPointer() )->flush();
+				}
+			}
+			finally {
+				// parsers must not touch the native mutators any longer
+				cancellation->Cancel();
+				try {
+					Task::WaitAll( tasks->ToArray() );
+				}
+				catch( AggregateException^ ) {
+					// already thrown or superseded by the actual failure
+				}
+
+				Block block;
+				while( blocks->TryTake(block) ) {
+					ArrayPool<Byte>::Shared->Return( block.buffer );
+				}
+				for( int n = 0; n < mutators->Length; ++n ) {
+					delete static_cast<Common::TableMutator*>( mutators[n].ToPointer() );
+					mutators[n] = IntPtr::Zero;
+				}
+				delete blocks;
+				delete cancellation;
+				statistics->SetElapsed( stopwatch->Elapsed );
+			}
+		}
+		HT4N_RETHROW
+
+		return statistics;
+	}
+
+	void BulkLoader::Read( IO::Stream^ stream ) {
+		int blockSize = options->BlockSize;
+		cli::array<Byte>^ buffer = ArrayPool<Byte>::Shared->Rent( blockSize );
+		int length = 0;
+		bool first = true;
+		try {
+			for( ;; ) {
+				if( length == buffer->Length ) {
+					// single line exceeds the buffer
+					cli::array<Byte>^ larger = ArrayPool<Byte>::Shared->Rent( 2 * buffer->Length );
+					Buffer::BlockCopy( buffer, 0, larger, 0, length );
+					ArrayPool<Byte>::Shared->Return( buffer );
+					buffer = larger;
+				}
+
+				int read = stream->Read( buffer, length, buffer->Length - length );
+				statistics->AddBytes( read );
+				length += read;
+				if( read == 0 ) {
+					if( length > 0 ) {
+						Post( buffer, length, first );
+						buffer = nullptr;
+					}
+					break;
+				}
+				if( length < buffer->Length ) {
+					continue;
+				}
+
+				int eol = Array::LastIndexOf( buffer, static_cast<Byte>('\n'), length - 1, length );
+				if( eol < 0 ) {
+					continue;
+				}
+
+				int remaining = length - eol - 1;
+				cli::array<Byte>^ next = ArrayPool<Byte>::Shared->Rent( Math::Max(blockSize, 2 * remaining) );
+				Buffer::BlockCopy( buffer, eol + 1, next, 0, remaining );
+				Post( buffer, eol + 1, first );
+				buffer = next;
+				length = remaining;
+				first = false;
+			}
+		}
+		finally {
+			if( buffer != nullptr ) {
+				ArrayPool<Byte>::Shared->Return( buffer );
+			}
+		}
+	}
+
+	void BulkLoader::Post( cli::array<Byte>^ buffer, int length, bool first ) {
+		if( first ) {
+			// the header line determines the layout of all lines
+			pin_ptr<Byte> pb = &buffer[0];
+			const char* p = reinterpret_cast<const char*>( pb );
+			timestamps = BulkLoadParser::hasTimestamps( p, p + length );
+		}
+		Block block;
+		block.buffer = buffer;
+		block.length = length;
+		block.first = first;
+		block.timestamps = timestamps;
+		blocks->Add( block, cancellation->Token );
+	}
+
+	void BulkLoader::Parse( Object^ state ) {
+		int mutatorIndex = safe_cast<int>( state ) % mutators->Length;
+		size_t maxChunkSize = options->MaxChunkSize;
+		Int64 maxParseErrors = options->MaxParseErrors;
+		Common::Cells* cells = Common::Cells::create( MutatorSpec::MaxCellCountDefault );
+		BulkLoadParser parser( !options->NoEscape );
+		size_t bytes = 0;
+
+		try {
+			for each( Block block in blocks->GetConsumingEnumerable(cancellation->Token) ) {
+				BulkLoadParser::Counters counters;
+				try {
+					pin_ptr<Byte> pb = &block.buffer[0];
+					const char* p = reinterpret_cast<const char*>( pb );
+					const char* end = p + block.length;
+					if( block.first ) {
+						p = BulkLoadParser::skipHeader( p, end );
+					}
+					while( p < end ) {
+						p = parser.parse( p, end, block.timestamps, *cells, bytes, maxChunkSize, counters );
+						if( bytes >= maxChunkSize ) {
+							Set( mutatorIndex, cells );
+							bytes = 0;
+						}
+					}
+				}
+				finally {
+					ArrayPool<Byte>::Shared->Return( block.buffer );
+				}
+
+				Int64 parseErrors = statistics->AddParsed( static_cast<Int64>(counters.lines), static_cast<Int64>(counters.cells), static_cast<Int64>(counters.errors) );
+				if( maxParseErrors > 0 && parseErrors > maxParseErrors ) {
+					throw gcnew IO::InvalidDataException( String::Format(L"Bulk load aborted, {0} malformed lines", parseErrors) );
+				}
+			}
+
+			if( cells->size() ) {
+				Set( mutatorIndex, cells );
+			}
+		}
+		catch( OperationCanceledException^ ) {
+			// another parser or the reader has failed
+			if( !cancellation->IsCancellationRequested ) {
+				throw;
+			}
+		}
+		catch( Exception^ e ) {
+			Logging::TraceException( e );
+			cancellation->Cancel();
+			throw;
+		}
+		finally {
+			delete cells;
+		}
+	}
+
+	void BulkLoader::Set( int mutatorIndex, Common::Cells* cells ) {
+		HT4N_TRY {
+			msclr::lock sync( mutatorLocks[mutatorIndex] );
+			static_cast<Common::TableMutator*>( mutators[mutatorIndex].ToPointer() )->set( *cells );
+		}
+		HT4N_RETHROW
+		finally {
+			cells->clear();
+		}
+	}
+
+}
\ No newline at end of file
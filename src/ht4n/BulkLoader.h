@@ -0,0 +1,85 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#pragma once
+
+#ifndef __cplusplus_cli
+#error "requires /clr"
+#endif
+
+namespace ht4c { namespace Common {
+	class Table;
+	class TableMutator;
+	class Cells;
+} }
+
+namespace Hypertable {
+	using namespace System;
+	using namespace System::Threading;
+	using namespace System::Collections::Concurrent;
+	using namespace ht4c;
+
+	ref class BulkLoadOptions;
+	ref class BulkLoadStatistics;
+
+	/// <summary>
+	/// Loads tab delimited input into a table.
+	/// </summary>
+	/// <remarks>
+	/// The input is read in blocks split on line boundaries, parser threads parse the blocks
+	/// straight into native cell chunks and pass them to the native mutators. No managed
+	/// cell or key instances are created.
+	/// </remarks>
+	/// <seealso cref="BulkLoadParser"/>
+	ref class BulkLoader sealed {
+
+		internal:
+
+			BulkLoader( Common::Table* table, BulkLoadOptions^ options );
+
+			BulkLoadStatistics^ Load( IO::Stream^ stream );
+
+		private:
+
+			value struct Block {
+				cli::array<Byte>^ buffer;
+				int length;
+				bool first;
+				bool timestamps;
+			};
+
+			void Read( IO::Stream^ stream );
+			void Post( cli::array<Byte>^ buffer, int length, bool first );
+			void Parse( Object^ state );
+			void Set( int mutatorIndex, Common::Cells* cells );
+
+			Common::Table* table;
+			BulkLoadOptions^ options;
+			BulkLoadStatistics^ statistics;
+			BlockingCollection<Block>^ blocks;
+			CancellationTokenSource^ cancellation;
+			cli::array<IntPtr>^ mutators;
+			cli::array<Object^>^ mutatorLocks;
+			bool timestamps;
+	};
+
+}
\ No newline at end of file
@@ -19,12 +19,235 @@
  * 02110-1301, USA.
  */
 
+
 #pragma once
 
 #ifndef __cplusplus_cli
 #error "requires /clr"
 #endif
 
+#if defined(_M_IX86) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#pragma managed( push, off )
+
+namespace Hypertable {
+
+	/// <summary>
+	/// Native utf8/utf16 transcoder, converts ASCII runs 16 characters at a time.
+	/// </summary>
+	/// <remarks>
+	/// The transcoder handles well-formed input only, the methods return -1 for invalid
+	/// utf8 sequences or unpaired surrogates so that the caller can fall back to the
+	/// Win32 conversion functions, which substitute invalid code points.
+	/// </remarks>
+	class Utf8Transcoder {
+
+		public:
+
+			/// <summary>
+			/// Converts an utf8 string into utf16.
+			/// </summary>
+			/// <param name="sz">Utf8 string.</param>
+			/// <param name="len">The utf8 string length in bytes.</param>
+			/// <param name="wsz">Utf16 buffer, requires space for at least len characters.</param>
+			/// <returns>The number of utf16 characters written, -1 if the utf8 string is invalid.</returns>
+			static int ToUtf16( const char* sz, int len, wchar_t* wsz ) {
+				const unsigned char* p = reinterpret_cast<const unsigned char*>( sz );
+				const unsigned char* end = p + len;
+				wchar_t* q = wsz;
+
+				while( p < end ) {
+#if defined(_M_IX86) || defined(_M_X64)
+					if( end - p >= 16 ) {
+						__m128i v = _mm_loadu_si128( reinterpret_cast<const __m128i*>(p) );
+						if( !_mm_movemask_epi8(v) ) {
+							const __m128i zero = _mm_setzero_si128();
+							_mm_storeu_si128( reinterpret_cast<__m128i*>(q), _mm_unpacklo_epi8(v, zero) );
+							_mm_storeu_si128( reinterpret_cast<__m128i*>(q + 8), _mm_unpackhi_epi8(v, zero) );
+							p += 16;
+							q += 16;
+							continue;
+						}
+					}
+#else
+					if( end - p >= 8 ) {
+						uint64_t v;
+						memcpy( &v, p, sizeof(v) );
+						if( !(v & 0x8080808080808080ULL) ) {
+							for( int n = 0; n < 8; ++n ) {
+								q[n] = p[n];
+							}
+							p += 8;
+							q += 8;
+							continue;
+						}
+					}
+#endif
+
+					unsigned int c = *p;
+					if( c < 0x80 ) {
+						*q++ = static_cast<wchar_t>( c );
+						++p;
+					}
+					else if( c < 0xC2 ) {
+						return -1;
+					}
+					else if( c < 0xE0 ) {
+						if( end - p < 2 || (p[1] & 0xC0) != 0x80 ) {
+							return -1;
+						}
+						*q++ = static_cast<wchar_t>( ((c & 0x1F) << 6) | (p[1] & 0x3F) );
+						p += 2;
+					}
+					else if( c < 0xF0 ) {
+						if( end - p < 3 || (p[1] & 0xC0) != 0x80 || (p[2] & 0xC0) != 0x80 ) {
+							return -1;
+						}
+						unsigned int cp = ((c & 0x0F) << 12) | ((p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+						if( cp < 0x800 || (cp >= 0xD800 && cp <= 0xDFFF) ) {
+							return -1;
+						}
+						*q++ = static_cast<wchar_t>( cp );
+						p += 3;
+					}
+					else if( c < 0xF5 ) {
+						if( end - p < 4 || (p[1] & 0xC0) != 0x80 || (p[2] & 0xC0) != 0x80 || (p[3] & 0xC0) != 0x80 ) {
+							return -1;
+						}
+						unsigned int cp = ((c & 0x07) << 18) | ((p[1] & 0x3F) << 12) | ((p[2] & 0x3F) << 6) | (p[3] & 0x3F);
+						if( cp < 0x10000 || cp > 0x10FFFF ) {
+							return -1;
+						}
+						cp -= 0x10000;
+						*q++ = static_cast<wchar_t>( 0xD800 + (cp >> 10) );
+						*q++ = static_cast<wchar_t>( 0xDC00 + (cp & 0x3FF) );
+						p += 4;
+					}
+					else {
+						return -1;
+					}
+				}
+
+				return static_cast<int>( q - wsz );
+			}
+
+			/// <summary>
+			/// Gets the utf8 length of an utf16 string.
+			/// </summary>
+			/// <param name="wsz">Utf16 string.</param>
+			/// <param name="len">The utf16 string length in characters.</param>
+			/// <returns>The utf8 length in bytes, -1 if the utf16 string contains unpaired surrogates.</returns>
+			static int Utf8Length( const wchar_t* wsz, int len ) {
+				const wchar_t* p = wsz;
+				const wchar_t* end = p + len;
+				int cb = 0;
+
+				while( p < end ) {
+#if defined(_M_IX86) || defined(_M_X64)
+					if( end - p >= 16 && IsAscii16(p) ) {
+						cb += 16;
+						p += 16;
+						continue;
+					}
+#endif
+
+					unsigned int c = *p;
+					if( c < 0x80 ) {
+						cb += 1;
+					}
+					else if( c < 0x800 ) {
+						cb += 2;
+					}
+					else if( c >= 0xD800 && c <= 0xDFFF ) {
+						if( c > 0xDBFF || end - p < 2 || p[1] < 0xDC00 || p[1] > 0xDFFF ) {
+							return -1;
+						}
+						cb += 4;
+						++p;
+					}
+					else {
+						cb += 3;
+					}
+					++p;
+				}
+
+				return cb;
+			}
+
+			/// <summary>
+			/// Converts an utf16 string into utf8.
+			/// </summary>
+			/// <param name="wsz">Utf16 string.</param>
+			/// <param name="len">The utf16 string length in characters.</param>
+			/// <param name="sz">Utf8 buffer, requires space for at least Utf8Length bytes.</param>
+			/// <returns>The number of utf8 bytes written, -1 if the utf16 string contains unpaired surrogates.</returns>
+			static int ToUtf8( const wchar_t* wsz, int len, char* sz ) {
+				const wchar_t* p = wsz;
+				const wchar_t* end = p + len;
+				unsigned char* q = reinterpret_cast<unsigned char*>( sz );
+
+				while( p < end ) {
+#if defined(_M_IX86) || defined(_M_X64)
+					if( end - p >= 16 && IsAscii16(p) ) {
+						__m128i a = _mm_loadu_si128( reinterpret_cast<const __m128i*>(p) );
+						__m128i b = _mm_loadu_si128( reinterpret_cast<const __m128i*>(p + 8) );
+						_mm_storeu_si128( reinterpret_cast<__m128i*>(q), _mm_packus_epi16(a, b) );
+						p += 16;
+						q += 16;
+						continue;
+					}
+#endif
+
+					unsigned int c = *p;
+					if( c < 0x80 ) {
+						*q++ = static_cast<unsigned char>( c );
+					}
+					else if( c < 0x800 ) {
+						*q++ = static_cast<unsigned char>( 0xC0 | (c >> 6) );
+						*q++ = static_cast<unsigned char>( 0x80 | (c & 0x3F) );
+					}
+					else if( c >= 0xD800 && c <= 0xDFFF ) {
+						if( c > 0xDBFF || end - p < 2 || p[1] < 0xDC00 || p[1] > 0xDFFF ) {
+							return -1;
+						}
+						unsigned int cp = 0x10000 + ((c - 0xD800) << 10) + (p[1] - 0xDC00);
+						*q++ = static_cast<unsigned char>( 0xF0 | (cp >> 18) );
+						*q++ = static_cast<unsigned char>( 0x80 | ((cp >> 12) & 0x3F) );
+						*q++ = static_cast<unsigned char>( 0x80 | ((cp >> 6) & 0x3F) );
+						*q++ = static_cast<unsigned char>( 0x80 | (cp & 0x3F) );
+						++p;
+					}
+					else {
+						*q++ = static_cast<unsigned char>( 0xE0 | (c >> 12) );
+						*q++ = static_cast<unsigned char>( 0x80 | ((c >> 6) & 0x3F) );
+						*q++ = static_cast<unsigned char>( 0x80 | (c & 0x3F) );
+					}
+					++p;
+				}
+
+				return static_cast<int>( q - reinterpret_cast<unsigned char*>(sz) );
+			}
+
+		private:
+
+#if defined(_M_IX86) || defined(_M_X64)
+
+			static bool IsAscii16( const wchar_t* p ) {
+				__m128i a = _mm_loadu_si128( reinterpret_cast<const __m128i*>(p) );
+				__m128i b = _mm_loadu_si128( reinterpret_cast<const __m128i*>(p + 8) );
+				__m128i v = _mm_and_si128( _mm_or_si128(a, b), _mm_set1_epi16(static_cast<short>(0xFF80)) );
+				return _mm_movemask_epi8( _mm_cmpeq_epi16(v, _mm_setzero_si128()) ) == 0xFFFF;
+			}
+
+#endif
+	};
+
+}
+
+#pragma managed( pop )
+
 namespace Hypertable {
 	using namespace System;
 	using namespace System::ComponentModel;
@@ -92,29 +315,76 @@ namespace Hypertable {
 			/// <returns>Managed string.</returns>
 			static String^ ToString( const char* string, int len ) {
 				if( len ) {
-					wchar_t wbuf[SIZE + 1];
-					int cc = len < SIZE ? MultiByteToWideChar(CP_UTF8, 0, string, len, wbuf, SIZE) : 0;
-					if( !cc ) {
-						cc = MultiByteToWideChar( CP_UTF8, 0, string, len, 0, 0 );
-						wchar_t* wsz = static_cast<wchar_t*>( malloc((cc + 1) * sizeof(wchar_t)) );
+					if( len <= SIZE ) {
+						wchar_t wbuf[SIZE];
+						int cc = Utf8Transcoder::ToUtf16( string, len, wbuf );
+						if( cc >= 0 ) {
+							return gcnew String( wbuf, 0, cc );
+						}
+					}
+					else {
+						// single pass, utf8 never results in more utf16 characters than bytes
+						wchar_t* wsz = static_cast<wchar_t*>( malloc(len * sizeof(wchar_t)) );
 						if( !wsz ) {
 							throw gcnew OutOfMemoryException();
 						}
-						cc = MultiByteToWideChar( CP_UTF8, 0, string, len, wsz, cc );
-						if( !cc ) {
+						try {
+							int cc = Utf8Transcoder::ToUtf16( string, len, wsz );
+							if( cc >= 0 ) {
+								return gcnew String( wsz, 0, cc );
+							}
+						}
+						finally {
 							free( wsz );
-							throw gcnew Win32Exception( GetLastError() );
 						}
+					}
+					return ToStringWin32( string, len );
+				}
+				return String::Empty;
+			}
+
+			/// <summary>
+			/// Gets the utf8 length of a managed string.
+			/// </summary>
+			/// <param name="string">Managed string, might be null.</param>
+			/// <returns>The utf8 length in bytes.</returns>
+			static int Utf8Length( String^ string ) {
+				if( String::IsNullOrEmpty(string) ) {
+					return 0;
+				}
+				pin_ptr<const wchar_t> wsz = PtrToStringChars( string );
+				int cb = Utf8Transcoder::Utf8Length( wsz, string->Length );
+				return cb >= 0 ? cb : Text::Encoding::UTF8->GetByteCount( string );
+			}
 
-						wsz[cc] = 0;
-						String^ s = gcnew String( wsz );
+			/// <summary>
+			/// Creates a managed string from an unmanaged utf8 C string using the Win32 conversion.
+			/// </summary>
+			/// <param name="string">Unmanaged utf8 C string.</param>
+			/// <param name="len">The string length.</param>
+			/// <returns>Managed string.</returns>
+			static String^ ToStringWin32( const char* string, int len ) {
+				wchar_t wbuf[SIZE + 1];
+				int cc = len < SIZE ? MultiByteToWideChar(CP_UTF8, 0, string, len, wbuf, SIZE) : 0;
+				if( !cc ) {
+					cc = MultiByteToWideChar( CP_UTF8, 0, string, len, 0, 0 );
+					wchar_t* wsz = static_cast<wchar_t*>( malloc((cc + 1) * sizeof(wchar_t)) );
+					if( !wsz ) {
+						throw gcnew OutOfMemoryException();
+					}
+					cc = MultiByteToWideChar( CP_UTF8, 0, string, len, wsz, cc );
+					if( !cc ) {
 						free( wsz );
-						return s;
+						throw gcnew Win32Exception( GetLastError() );
 					}
-					wbuf[cc] = 0;
-					return gcnew String( wbuf );
+
+					wsz[cc] = 0;
+					String^ s = gcnew String( wsz );
+					free( wsz );
+					return s;
 				}
-				return String::Empty;
+				wbuf[cc] = 0;
+				return gcnew String( wbuf );
 			}
 
 		private:
@@ -125,24 +395,17 @@ namespace Hypertable {
 
 			char* ToUtf8( const wchar_t* wsz, int len ) {
 				if( len ) {
-					int cb = len < SIZE ? WideCharToMultiByte(CP_UTF8, 0, wsz, len, cbuf, SIZE, 0, 0) : 0;
-					if( !cb ) {
-						cb = WideCharToMultiByte( CP_UTF8, 0, wsz, len, 0, 0, 0, 0 );
-						char* sz = static_cast<char*>( malloc(cb + 1) );
+					int cb = Utf8Transcoder::Utf8Length( wsz, len );
+					if( cb >= 0 ) {
+						char* sz = cb <= SIZE ? cbuf : static_cast<char*>( malloc(cb + 1) );
 						if( !sz ) {
 							throw gcnew OutOfMemoryException();
 						}
-						cb = WideCharToMultiByte( CP_UTF8, 0, wsz, len, sz, cb, 0, 0);
-						if( !cb ) {
-							free( sz );
-							throw gcnew Win32Exception( GetLastError() );
-						}
+						Utf8Transcoder::ToUtf8( wsz, len, sz );
 						sz[cb] = 0;
 						return sz;
 					}
-					else {
-						cbuf[cb] = 0;
-					}
+					return ToUtf8Win32( wsz, len );
 				}
 				else {
 					*cbuf = 0;
@@ -150,6 +413,26 @@ namespace Hypertable {
 				return cbuf;
 			}
 
+			char* ToUtf8Win32( const wchar_t* wsz, int len ) {
+				int cb = len < SIZE ? WideCharToMultiByte(CP_UTF8, 0, wsz, len, cbuf, SIZE, 0, 0) : 0;
+				if( !cb ) {
+					cb = WideCharToMultiByte( CP_UTF8, 0, wsz, len, 0, 0, 0, 0 );
+					char* sz = static_cast<char*>( malloc(cb + 1) );
+					if( !sz ) {
+						throw gcnew OutOfMemoryException();
+					}
+					cb = WideCharToMultiByte( CP_UTF8, 0, wsz, len, sz, cb, 0, 0);
+					if( !cb ) {
+						free( sz );
+						throw gcnew Win32Exception( GetLastError() );
+					}
+					sz[cb] = 0;
+					return sz;
+				}
+				cbuf[cb] = 0;
+				return cbuf;
+			}
+
 			char cbuf[SIZE + 1];
 			char* cstr;
 	};
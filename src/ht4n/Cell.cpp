@@ -23,6 +23,8 @@
 
 #include "Cell.h"
 #include "Key.h"
+#include "ValueCodecMap.h"
+#include "IValueCodec.h"
 
 #include "ht4c.Common/Cell.h"
 
@@ -97,15 +99,38 @@ namespace Hypertable {
 
 	Cell::Cell( const Common::Cell* cell ) {
 		if( cell ) {
-			From( *cell );
+			From( *cell, nullptr );
+		}
+	}
+
+	Cell::Cell( const Common::Cell* cell, StringCache^ stringCache ) {
+		if( cell ) {
+			From( *cell, stringCache );
 		}
 	}
 
 	void Cell::From( const Common::Cell& cell ) {
-		Key = gcnew Hypertable::Key( cell );
+		From( cell, nullptr );
+	}
+
+	void Cell::From( const Common::Cell& cell, StringCache^ stringCache ) {
+		From( cell, stringCache, nullptr );
+	}
+
+	void Cell::From( const Common::Cell& cell, StringCache^ stringCache, ValueCodecMap^ valueCodecs ) {
+		Key = gcnew Hypertable::Key( cell, stringCache );
 		
 		size_t len;
-		if( (len = cell.valueLength()) > 0 ) {
+		int decodedLength;
+		IValueCodec^ codec;
+		if( (len = cell.valueLength()) > 0 && valueCodecs != nullptr && (codec = valueCodecs->GetEncoded(Key->ColumnFamily, cell.value(), (int)len, decodedLength)) != nullptr ) {
+			if( Value == nullptr || Value->Length != decodedLength ) {
+				Value = gcnew cli::array<Byte>( decodedLength );
+			}
+			pin_ptr<Byte> pv = &Value[0];
+			ValueCodecMap::Decode( codec, cell.value(), (int)len, pv, decodedLength );
+		}
+		else if( len > 0 ) {
 			if( Value == nullptr || Value->LongLength != len ) {
 				Value = gcnew cli::array<Byte>( (int)len );
 			}
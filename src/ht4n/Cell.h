@@ -37,6 +37,8 @@ namespace Hypertable {
 	using namespace ht4c;
 
 	ref class Key;
+	ref class StringCache;
+	ref class ValueCodecMap;
 	ref class Counter;
 
 	/// <summary>
@@ -184,7 +186,10 @@ namespace Hypertable {
 		internal:
 
 			Cell( const Common::Cell* cell );
+			Cell( const Common::Cell* cell, StringCache^ stringCache );
 			void From( const Common::Cell& cell );
+			void From( const Common::Cell& cell, StringCache^ stringCache );
+			void From( const Common::Cell& cell, StringCache^ stringCache, ValueCodecMap^ valueCodecs );
 
 			static CellFlag DeleteFlagFromKey( Hypertable::Key^ key );
 	};
@@ -0,0 +1,217 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#pragma once
+
+#ifndef __cplusplus_cli
+#error "requires /clr"
+#endif
+
+#include <vector>
+#include <string>
+#include <cstring>
+
+#include "ht4c.Common/Cell.h"
+#include "ht4c.Common/Cells.h"
+#include "ht4c.Common/CellFlag.h"
+
+#pragma managed( push, off )
+
+namespace Hypertable {
+
+	/// <summary>
+	/// Native cell chunk coalescer, keeps only the latest value per cell key.
+	/// </summary>
+	/// <remarks>
+	/// Only insert cells with an automatically assigned timestamp will be coalesced. A delete cell
+	/// resets the index, so that no cell will be coalesced across a delete. Cells of excluded column
+	/// families (counter columns, where each insert is an increment) are never coalesced. The remaining
+	/// cells keep their order.
+	/// </remarks>
+	class CellCoalescer {
+
+		public:
+
+			CellCoalescer( )
+			: cell( ht4c::Common::Cell::create() )
+			, generation( 0 )
+			{
+			}
+
+			~CellCoalescer( ) {
+				delete cell;
+			}
+
+			/// <summary>
+			/// Excludes the column family specified from coalescing.
+			/// </summary>
+			/// <param name="columnFamily">Column family, utf8 encoded.</param>
+			void exclude( const char* columnFamily ) {
+				excluded.push_back( columnFamily );
+			}
+
+			/// <summary>
+			/// Coalesces the cells specified.
+			/// </summary>
+			/// <param name="cells">Cells to coalesce.</param>
+			/// <param name="coalesced">Receives the remaining cells if any cell has been elided.</param>
+			/// <returns>The number of elided cells.</returns>
+			size_t coalesce( const ht4c::Common::Cells& cells, ht4c::Common::Cells& coalesced ) {
+				const size_t size = cells.size();
+				entries.resize( size );
+				size_t capacity = 16;
+				while( capacity < 2 * size ) {
+					capacity <<= 1;
+				}
+				if( slots.size() < capacity ) {
+					slots.assign( capacity, Slot() );
+					generation = 0;
+				}
+				capacity = slots.size();
+				newGeneration();
+
+				size_t elided = 0;
+				for( size_t n = 0; n < size; ++n ) {
+					Entry& entry = entries[n];
+					cells.get_unchecked( n, cell );
+					entry.row = cell->row() ? cell->row() : "";
+					entry.columnFamily = cell->columnFamily() ? cell->columnFamily() : "";
+					entry.columnQualifier = cell->columnQualifier() ? cell->columnQualifier() : "";
+					entry.timestamp = cell->timestamp();
+					entry.value = cell->value();
+					entry.valueLength = cell->valueLength();
+					entry.flag = cell->flag();
+					entry.elided = false;
+
+					if( entry.flag != ht4c::Common::CF_Default ) {
+						newGeneration();
+						continue;
+					}
+					if( entry.timestamp || isExcluded(entry.columnFamily) ) {
+						continue;
+					}
+
+					// open addressing with linear probing, slots of former generations are empty
+					uint32_t hash = hashOf( entry );
+					for( size_t i = hash & (capacity - 1); ; i = (i + 1) & (capacity - 1) ) {
+						Slot& slot = slots[i];
+						if( slot.generation != generation ) {
+							slot.generation = generation;
+							slot.hash = hash;
+							slot.index = static_cast<uint32_t>( n );
+							break;
+						}
+						if( slot.hash == hash && equals(entries[slot.index], entry) ) {
+							entries[slot.index].elided = true;
+							slot.index = static_cast<uint32_t>( n );
+							++elided;
+							break;
+						}
+					}
+				}
+
+				if( elided ) {
+					for( std::vector<Entry>::const_iterator it = entries.begin(); it != entries.end(); ++it ) {
+						if( !it->elided ) {
+							coalesced.add( it->row, it->columnFamily, *it->columnQualifier ? it->columnQualifier : 0, it->timestamp, it->value, it->valueLength, it->flag );
+						}
+					}
+				}
+				return elided;
+			}
+
+		private:
+
+			struct Entry {
+				const char* row;
+				const char* columnFamily;
+				const char* columnQualifier;
+				uint64_t timestamp;
+				const ht4c::Common::uint8_t* value;
+				uint32_t valueLength;
+				uint8_t flag;
+				bool elided;
+			};
+
+			struct Slot {
+				Slot( )
+				: generation( 0 )
+				, hash( 0 )
+				, index( 0 )
+				{
+				}
+
+				uint32_t generation;
+				uint32_t hash;
+				uint32_t index;
+			};
+
+			void newGeneration( ) {
+				if( ++generation == 0 ) {
+					slots.assign( slots.size(), Slot() );
+					generation = 1;
+				}
+			}
+
+			bool isExcluded( const char* columnFamily ) const {
+				for( std::vector<std::string>::const_iterator it = excluded.begin(); it != excluded.end(); ++it ) {
+					if( *it == columnFamily ) {
+						return true;
+					}
+				}
+				return false;
+			}
+
+			static uint32_t hashOf( const Entry& entry ) {
+				// FNV-1a over row, column family and column qualifier
+				uint32_t hash = 2166136261U;
+				hash = hashOf( hash, entry.row );
+				hash = hashOf( hash, entry.columnFamily );
+				return hashOf( hash, entry.columnQualifier );
+			}
+
+			static uint32_t hashOf( uint32_t hash, const char* sz ) {
+				for( ; *sz; ++sz ) {
+					hash = (hash ^ static_cast<unsigned char>(*sz)) * 16777619U;
+				}
+				return (hash ^ 0xff) * 16777619U;
+			}
+
+			static bool equals( const Entry& x, const Entry& y ) {
+				return !strcmp( x.row, y.row )
+						&& !strcmp( x.columnFamily, y.columnFamily )
+						&& !strcmp( x.columnQualifier, y.columnQualifier );
+			}
+
+			CellCoalescer( const CellCoalescer& );
+			CellCoalescer& operator = ( const CellCoalescer& );
+
+			ht4c::Common::Cell* cell;
+			std::vector<Entry> entries;
+			std::vector<Slot> slots;
+			std::vector<std::string> excluded;
+			uint32_t generation;
+	};
+
+}
+
+#pragma managed( pop )
\ No newline at end of file
@@ -0,0 +1,158 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#pragma once
+
+#ifndef __cplusplus_cli
+#error "requires /clr"
+#endif
+
+#include <vector>
+#include <algorithm>
+#include <cstring>
+
+#include "ht4c.Common/Cell.h"
+#include "ht4c.Common/Cells.h"
+#include "ht4c.Common/CellFlag.h"
+
+#pragma managed( push, off )
+
+namespace Hypertable {
+
+	/// <summary>
+	/// Native cell chunk sorter, orders cells by row, column family and column qualifier.
+	/// </summary>
+	/// <remarks>
+	/// The sort is stable and never compares timestamps, cells with equal keys keep their
+	/// arrival order. If the chunk contains delete cells, cells are ordered by row only,
+	/// so that deletes and inserts of the same row are passed in the order they were added.
+	/// </remarks>
+	class CellSorter {
+
+		public:
+
+			CellSorter( )
+			: cell( ht4c::Common::Cell::create() )
+			{
+			}
+
+			~CellSorter( ) {
+				delete cell;
+			}
+
+			/// <summary>
+			/// Sorts the cells specified.
+			/// </summary>
+			/// <param name="cells">Cells to sort.</param>
+			/// <param name="sorted">Receives the sorted cells if the cells are not yet in order.</param>
+			/// <returns>true if the sorted cells have been added, false if the cells are already in order.</returns>
+			bool sort( const ht4c::Common::Cells& cells, ht4c::Common::Cells& sorted ) {
+				entries.clear();
+				entries.reserve( cells.size() );
+				bool rowsOnly = false;
+				for( size_t n = 0; n < cells.size(); ++n ) {
+					cells.get_unchecked( n, cell );
+					Entry entry;
+					entry.row = cell->row() ? cell->row() : "";
+					entry.prefix = prefix( entry.row );
+					entry.columnFamily = cell->columnFamily() ? cell->columnFamily() : "";
+					entry.columnQualifier = cell->columnQualifier();
+					entry.timestamp = cell->timestamp();
+					entry.value = cell->value();
+					entry.valueLength = cell->valueLength();
+					entry.flag = cell->flag();
+					rowsOnly |= entry.flag != ht4c::Common::CF_Default;
+					entries.push_back( entry );
+				}
+
+				Less less( rowsOnly );
+				if( std::is_sorted(entries.begin(), entries.end(), less) ) {
+					return false;
+				}
+
+				// merge sort, runs of pre-ordered cells are cheap and equal keys remain stable
+				std::stable_sort( entries.begin(), entries.end(), less );
+				for( std::vector<Entry>::const_iterator it = entries.begin(); it != entries.end(); ++it ) {
+					sorted.add( it->row, it->columnFamily, it->columnQualifier, it->timestamp, it->value, it->valueLength, it->flag );
+				}
+				return true;
+			}
+
+		private:
+
+			struct Entry {
+				uint64_t prefix;
+				const char* row;
+				const char* columnFamily;
+				const char* columnQualifier;
+				uint64_t timestamp;
+				const ht4c::Common::uint8_t* value;
+				uint32_t valueLength;
+				uint8_t flag;
+			};
+
+			struct Less {
+				explicit Less( bool _rowsOnly )
+				: rowsOnly( _rowsOnly )
+				{
+				}
+
+				bool operator () ( const Entry& x, const Entry& y ) const {
+					// the big endian row prefix resolves most comparisons without touching the row strings
+					if( x.prefix != y.prefix ) {
+						return x.prefix < y.prefix;
+					}
+					int cmp = strcmp( x.row, y.row );
+					if( cmp || rowsOnly ) {
+						return cmp < 0;
+					}
+					cmp = strcmp( x.columnFamily, y.columnFamily );
+					if( cmp ) {
+						return cmp < 0;
+					}
+					return strcmp( x.columnQualifier ? x.columnQualifier : "", y.columnQualifier ? y.columnQualifier : "" ) < 0;
+				}
+
+				bool rowsOnly;
+			};
+
+			static uint64_t prefix( const char* sz ) {
+				uint64_t p = 0;
+				for( int n = 0; n < 8; ++n ) {
+					p <<= 8;
+					if( *sz ) {
+						p |= static_cast<unsigned char>( *sz++ );
+					}
+				}
+				return p;
+			}
+
+			CellSorter( const CellSorter& );
+			CellSorter& operator = ( const CellSorter& );
+
+			ht4c::Common::Cell* cell;
+			std::vector<Entry> entries;
+	};
+
+}
+
+#pragma managed( pop )
\ No newline at end of file
@@ -0,0 +1,76 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#include "stdafx.h"
+
+#include "CellView.h"
+#include "CM2U8.h"
+
+#include "ht4c.Common/Cell.h"
+
+namespace Hypertable {
+	using namespace System;
+	using namespace System::Globalization;
+	using namespace ht4c;
+
+	String^ CellView::GetRow( ) {
+		return row != 0 ? CM2U8::ToString( row, rowLength ) : nullptr;
+	}
+
+	String^ CellView::GetColumnFamily( ) {
+		return columnFamily != 0 ? CM2U8::ToString( columnFamily, columnFamilyLength ) : nullptr;
+	}
+
+	String^ CellView::GetColumnQualifier( ) {
+		return columnQualifier != 0 ? CM2U8::ToString( columnQualifier, columnQualifierLength ) : nullptr;
+	}
+
+	String^ CellView::ToString() {
+		return String::Format( CultureInfo::InvariantCulture
+												 , L"{0}(Row={1}, ColumnFamily={2}, ColumnQualifier={3}, Timestamp={4}, Flag={5}, ValueLength={6})"
+												 , GetType()
+												 , GetRow()
+												 , GetColumnFamily()
+												 , GetColumnQualifier()
+												 , timestamp
+												 , flag
+												 , valueLength );
+	}
+
+	CellView::CellView( const Common::Cell& cell, IntPtr _value, int _valueLength )
+	: row( cell.row() )
+	, columnFamily( cell.columnFamily() )
+	, columnQualifier( cell.columnQualifier() )
+	, rowLength( 0 )
+	, columnFamilyLength( 0 )
+	, columnQualifierLength( 0 )
+	, timestamp( cell.timestamp() )
+	, flag( static_cast<CellFlag>(cell.flag()) )
+	, value( _value )
+	, valueLength( _valueLength )
+	{
+		rowLength = row != 0 ? static_cast<int>( strlen(row) ) : 0;
+		columnFamilyLength = columnFamily != 0 ? static_cast<int>( strlen(columnFamily) ) : 0;
+		columnQualifierLength = columnQualifier != 0 ? static_cast<int>( strlen(columnQualifier) ) : 0;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,190 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#pragma once
+
+#ifndef __cplusplus_cli
+#error "requires /clr"
+#endif
+
+#include "CellFlag.h"
+
+namespace ht4c { namespace Common {
+	class Cell;
+} }
+
+namespace Hypertable {
+	using namespace System;
+	using namespace ht4c;
+
+	/// <summary>
+	/// Represents a read-only view of a scanned cell, pointing into the native scanner buffers.
+	/// </summary>
+	/// <remarks>
+	/// The row key, column family and column qualifier are utf8 encoded and not null terminated.
+	/// A cell view does not copy any data and is only valid for the duration of the visitor callback.
+	/// Use <c>new ReadOnlySpan&lt;byte&gt;((void*)view.Row, view.RowLength)</c> to access the bytes without copying.
+	/// </remarks>
+	/// <seealso cref="CellVisitor"/>
+	/// <seealso cref="ITableScanner"/>
+	public value struct CellView {
+
+		public:
+
+			/// <summary>
+			/// Gets a pointer to the utf8 encoded row key.
+			/// </summary>
+			property IntPtr Row {
+				IntPtr get( ) {
+					return IntPtr( const_cast<char*>(row) );
+				}
+			}
+
+			/// <summary>
+			/// Gets the length of the utf8 encoded row key in bytes.
+			/// </summary>
+			property int RowLength {
+				int get( ) {
+					return rowLength;
+				}
+			}
+
+			/// <summary>
+			/// Gets a pointer to the utf8 encoded column family.
+			/// </summary>
+			property IntPtr ColumnFamily {
+				IntPtr get( ) {
+					return IntPtr( const_cast<char*>(columnFamily) );
+				}
+			}
+
+			/// <summary>
+			/// Gets the length of the utf8 encoded column family in bytes.
+			/// </summary>
+			property int ColumnFamilyLength {
+				int get( ) {
+					return columnFamilyLength;
+				}
+			}
+
+			/// <summary>
+			/// Gets a pointer to the utf8 encoded column qualifier, IntPtr.Zero if the column qualifier is null.
+			/// </summary>
+			property IntPtr ColumnQualifier {
+				IntPtr get( ) {
+					return IntPtr( const_cast<char*>(columnQualifier) );
+				}
+			}
+
+			/// <summary>
+			/// Gets the length of the utf8 encoded column qualifier in bytes.
+			/// </summary>
+			property int ColumnQualifierLength {
+				int get( ) {
+					return columnQualifierLength;
+				}
+			}
+
+			/// <summary>
+			/// Gets the cell timestamp.
+			/// </summary>
+			/// <remarks>Timestamp in nanoseconds since 1970-01-01 00:00:00.0 UTC.</remarks>
+			property UInt64 Timestamp {
+				UInt64 get( ) {
+					return timestamp;
+				}
+			}
+
+			/// <summary>
+			/// Gets the cell flag.
+			/// </summary>
+			/// <seealso cref="CellFlag"/>
+			property CellFlag Flag {
+				CellFlag get( ) {
+					return flag;
+				}
+			}
+
+			/// <summary>
+			/// Gets a pointer to the cell value, decoded if a value codec applies.
+			/// </summary>
+			property IntPtr Value {
+				IntPtr get( ) {
+					return value;
+				}
+			}
+
+			/// <summary>
+			/// Gets the length of the cell value in bytes.
+			/// </summary>
+			property int ValueLength {
+				int get( ) {
+					return valueLength;
+				}
+			}
+
+			/// <summary>
+			/// Decodes the row key.
+			/// </summary>
+			/// <returns>Row key.</returns>
+			/// <remarks>Allocates a new string.</remarks>
+			String^ GetRow( );
+
+			/// <summary>
+			/// Decodes the column family.
+			/// </summary>
+			/// <returns>Column family.</returns>
+			/// <remarks>Allocates a new string.</remarks>
+			String^ GetColumnFamily( );
+
+			/// <summary>
+			/// Decodes the column qualifier.
+			/// </summary>
+			/// <returns>Column qualifier, might be null.</returns>
+			/// <remarks>Allocates a new string.</remarks>
+			String^ GetColumnQualifier( );
+
+			/// <summary>
+			/// Returns a string that represents the current object.
+			/// </summary>
+			/// <returns>A string that represents the current object.</returns>
+			virtual String^ ToString() override;
+
+		internal:
+
+			CellView( const Common::Cell& cell, IntPtr value, int valueLength );
+
+		private:
+
+			const char* row;
+			const char* columnFamily;
+			const char* columnQualifier;
+			int rowLength;
+			int columnFamilyLength;
+			int columnQualifierLength;
+			UInt64 timestamp;
+			CellFlag flag;
+			IntPtr value;
+			int valueLength;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#pragma once
+
+#ifndef __cplusplus_cli
+#error "requires /clr"
+#endif
+
+#include <unordered_set>
+
+#include "ht4c.Common/Cells.h"
+
+#pragma managed( push, off )
+
+namespace Hypertable {
+
+	/// <summary>
+	/// Native registry of the cell chunks owned by a mutator.
+	/// </summary>
+	/// <remarks>
+	/// The registry keeps track of every chunk created, which allows a finalizer to release
+	/// the chunks without touching the managed queues holding them.
+	/// </remarks>
+	class ChunkRegistry {
+
+		public:
+
+			ChunkRegistry( ) {
+				::InitializeCriticalSection( &crit );
+			}
+
+			~ChunkRegistry( ) {
+				for( ht4c::Common::Cells* chunk : chunks ) {
+					delete chunk;
+				}
+				::DeleteCriticalSection( &crit );
+			}
+
+			/// <summary>
+			/// Creates a new registered chunk.
+			/// </summary>
+			/// <param name="capacity">Initial cell capacity.</param>
+			/// <returns>Newly created chunk.</returns>
+			ht4c::Common::Cells* create( size_t capacity ) {
+				ht4c::Common::Cells* chunk = ht4c::Common::Cells::create( capacity );
+				try {
+					Lock lock( &crit );
+					chunks.insert( chunk );
+				}
+				catch( ... ) {
+					delete chunk;
+					throw;
+				}
+				return chunk;
+			}
+
+			/// <summary>
+			/// Unregisters and deletes the chunk specified.
+			/// </summary>
+			/// <param name="chunk">Chunk to delete.</param>
+			void destroy( ht4c::Common::Cells* chunk ) {
+				{
+					Lock lock( &crit );
+					chunks.erase( chunk );
+				}
+				delete chunk;
+			}
+
+		private:
+
+			class Lock {
+
+				public:
+
+					inline Lock( CRITICAL_SECTION* _pcs )
+					: pcs( _pcs ) {
+						::EnterCriticalSection( pcs );
+					}
+
+					inline ~Lock( ) {
+						::LeaveCriticalSection( pcs );
+					}
+
+				private:
+
+					CRITICAL_SECTION* pcs;
+			};
+
+			ChunkRegistry( const ChunkRegistry& );
+			ChunkRegistry& operator = ( const ChunkRegistry& );
+
+			CRITICAL_SECTION crit;
+			std::unordered_set<ht4c::Common::Cells*> chunks;
+	};
+
+}
+
+#pragma managed( pop )
\ No newline at end of file
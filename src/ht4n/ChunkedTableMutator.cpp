@@ -26,6 +26,12 @@
 #include "Cell.h"
 #include "Exception.h"
 #include "CM2U8.h"
+#include "MutatorStatistics.h"
+#include "PendingBytesBudget.h"
+#include "CellSorter.h"
+#include "CellCoalescer.h"
+#include "ValueCodecMap.h"
+#include "HypertableEventSource.h"
 
 #include "ht4c.Common/TableMutator.h"
 #include "ht4c.Common/Cells.h"
@@ -33,6 +39,8 @@
 
 namespace Hypertable {
 	using namespace System;
+	using namespace System::Threading;
+	using namespace System::Diagnostics;
 
 	ChunkedTableMutator::~ChunkedTableMutator( ) {
 		GC::SuppressFinalize(this);
@@ -41,11 +49,33 @@ namespace Hypertable {
 
 	ChunkedTableMutator::!ChunkedTableMutator( ) {
 		HT4N_TRY {
-			msclr::lock sync( syncRoot );
 			if( cellChunk ) {
-				SetChunk( true );
+				SwappedChunk chunk;
+				{
+					msclr::lock sync( chunkRoot );
+					chunk = SwapChunk( true );
+				}
+				SetChunk( chunk, false );
+
+				msclr::lock sync( chunkRoot );
 				delete cellChunk;
 				cellChunk = 0;
+				if( spareChunk ) {
+					delete spareChunk;
+					spareChunk = 0;
+				}
+				if( cellSorter ) {
+					delete cellSorter;
+					cellSorter = 0;
+					delete sortedChunk;
+					sortedChunk = 0;
+				}
+				if( cellCoalescer ) {
+					delete cellCoalescer;
+					cellCoalescer = 0;
+					delete coalescedChunk;
+					coalescedChunk = 0;
+				}
 			}
 		} 
 		HT4N_RETHROW
@@ -57,12 +87,7 @@ namespace Hypertable {
 			key->Row = gcnew String( Common::KeyBuilder().c_str() );
 		}
 		HT4N_TRY {
-			UInt32 len = value != nullptr ? value->Length : 0;
-			msclr::lock sync( syncRoot );
-			pin_ptr<Byte> pv = len ? &value[0] : nullptr;
-			cellChunk->add( CM2U8(key->Row), CM2U8(key->ColumnFamily), CM2U8(key->ColumnQualifier), key->Timestamp, pv, len, (Byte)CellFlag::Default );
-			lenTotal += len;
-			SetChunk( false );
+			AddCell( key, value, CellFlag::Default );
 		}
 		HT4N_RETHROW
 	}
@@ -75,12 +100,7 @@ namespace Hypertable {
 			key->Row = gcnew String( Common::KeyBuilder().c_str() );
 		}
 		HT4N_TRY {
-			UInt32 len = cell->Value != nullptr ? cell->Value->Length : 0;
-			msclr::lock sync( syncRoot );
-			pin_ptr<Byte> pv = len ? &cell->Value[0] : nullptr;
-			cellChunk->add( CM2U8(key->Row), CM2U8(key->ColumnFamily), CM2U8(key->ColumnQualifier), key->Timestamp, pv, len, (Byte)cell->Flag );
-			lenTotal += len;
-			SetChunk( false );
+			AddCell( key, cell->Value, cell->Flag );
 		}
 		HT4N_RETHROW
 	}
@@ -95,12 +115,7 @@ namespace Hypertable {
 						if( createRowKey || String::IsNullOrEmpty(key->Row) ) {
 							key->Row = gcnew String( Common::KeyBuilder().c_str() );
 						}
-						UInt32 len = cell->Value != nullptr ? cell->Value->Length : 0;
-						msclr::lock sync( syncRoot );
-						pin_ptr<Byte> pv = len ? &cell->Value[0] : nullptr;
-						cellChunk->add( CM2U8(key->Row), CM2U8(key->ColumnFamily), CM2U8(key->ColumnQualifier), key->Timestamp, pv, len, (Byte)cell->Flag );
-						lenTotal += len;
-						SetChunk( false );
+						AddCell( key, cell->Value, cell->Flag );
 					}
 				}
 			}
@@ -137,40 +152,202 @@ namespace Hypertable {
 	}
 
 	void ChunkedTableMutator::Flush( ) {
-		if( !SetChunk(true) ) {
-			TableMutator::Flush();
+		SwappedChunk chunk;
+		{
+			msclr::lock sync( chunkRoot );
+			chunk = SwapChunk( true );
 		}
+		SetChunk( chunk, true );
 	}
 
-	ChunkedTableMutator::ChunkedTableMutator( Common::TableMutator* _tableMutator, UInt32 _maxChunkSize, UInt32 _maxCellCount, bool _flushEachChunk )
-	: TableMutator( _tableMutator )
+	ChunkedTableMutator::ChunkedTableMutator( Common::TableMutator* _tableMutator, UInt32 _maxChunkSize, UInt32 _maxCellCount, bool _flushEachChunk, bool _adaptiveChunkSize, UInt32 _minChunkSize, TimeSpan _targetChunkLatency, Int64 maxPendingBytes, bool sortChunks, bool coalesce, cli::array<String^>^ counterColumnFamilies, ValueCodecMap^ _valueCodecs )
+	: TableMutator( _tableMutator, 0, _valueCodecs )
+	, chunkRoot( gcnew Object() )
 	, cellChunk( Common::Cells::create(__min(_maxCellCount, 64 * 1024)) )
+	, spareChunk( 0 )
 	, lenTotal( 0 )
+	, bytesTotal( 0 )
+	, nextTicket( 0 )
+	, sentTicket( 0 )
+	, chunkSize( _maxChunkSize )
+	, cellCount( _maxCellCount )
+	, cellSorter( 0 )
+	, sortedChunk( 0 )
+	, cellCoalescer( 0 )
+	, coalescedChunk( 0 )
 	, maxChunkSize( _maxChunkSize )
 	, maxCellCount( _maxCellCount )
 	, flushEachChunk( _flushEachChunk )
+	, adaptiveChunkSize( _adaptiveChunkSize && _maxChunkSize > 0 )
+	, minChunkSize( __max(__min(_minChunkSize, _maxChunkSize), 1) )
+	, targetChunkLatency( _targetChunkLatency.Ticks )
 	{
+		if( maxPendingBytes > 0 ) {
+			budget = gcnew PendingBytesBudget( maxPendingBytes, statistics );
+		}
+		if( sortChunks ) {
+			cellSorter = new CellSorter();
+			sortedChunk = Common::Cells::create( __min(_maxCellCount, 64 * 1024) );
+		}
+		if( coalesce ) {
+			cellCoalescer = new CellCoalescer();
+			if( counterColumnFamilies != nullptr ) {
+				for each( String^ columnFamily in counterColumnFamilies ) {
+					cellCoalescer->exclude( CM2U8(columnFamily) );
+				}
+			}
+			coalescedChunk = Common::Cells::create( __min(_maxCellCount, 64 * 1024) );
+		}
 	}
 
-	bool ChunkedTableMutator::SetChunk( bool force ) {
-		if( force || lenTotal >= maxChunkSize || cellChunk->size() >= maxCellCount ) {
-			if( cellChunk->size() ) {
-				msclr::lock sync( syncRoot );
-				HT4N_TRY {
-					tableMutator->set( *cellChunk );
-					if( flushEachChunk ) {
-						TableMutator::Flush();
-						return true;
+	void ChunkedTableMutator::AddCell( Key^ key, cli::array<Byte>^ value, CellFlag cellFlag ) {
+		Int64 bytes = 0;
+		if( budget != nullptr ) {
+			bytes = PendingBytesBudget::SizeOf( key, value );
+			if( !budget->TryAcquire(bytes) ) {
+				// pass the current chunk before blocking, its bytes would never be released otherwise
+				SwappedChunk chunk;
+				{
+					msclr::lock sync( chunkRoot );
+					chunk = SwapChunk( true );
+				}
+				SetChunk( chunk, false );
+				budget->Acquire( bytes );
+			}
+		}
+
+		SwappedChunk chunk;
+		cli::array<Byte>^ buffer = nullptr;
+		try {
+			// encode before taking the chunk lock, producers only serialize on appending the cell
+			int encodedLength = Encode( key, value, buffer );
+			msclr::lock sync( chunkRoot );
+			lenTotal += Add( cellChunk, key, value, cellFlag, buffer, encodedLength );
+			bytesTotal += bytes;
+			chunk = SwapChunk( false );
+		}
+		finally {
+			ValueCodecMap::Release( buffer );
+		}
+		if( chunk.cells ) {
+			// producers keep appending to the fresh chunk while this one is in flight
+			SetChunk( chunk, false );
+		}
+	}
+
+	ChunkedTableMutator::SwappedChunk ChunkedTableMutator::SwapChunk( bool force ) {
+		SwappedChunk chunk;
+		chunk.cells = 0;
+		chunk.ticket = -1;
+		chunk.len = 0;
+		chunk.bytes = 0;
+		if( cellChunk->size() && (force || lenTotal >= chunkSize || cellChunk->size() >= cellCount) ) {
+			chunk.cells = cellChunk;
+			chunk.len = lenTotal;
+			chunk.bytes = bytesTotal;
+			cellChunk = spareChunk ? spareChunk : Common::Cells::create( __min(maxCellCount, 64 * 1024) );
+			spareChunk = 0;
+			lenTotal = 0;
+			bytesTotal = 0;
+		}
+		if( chunk.cells || force ) {
+			chunk.ticket = nextTicket++;
+		}
+		return chunk;
+	}
+
+	void ChunkedTableMutator::SetChunk( SwappedChunk chunk, bool flush ) {
+		if( chunk.ticket < 0 ) {
+			return;
+		}
+		HT4N_TRY {
+			msclr::lock sync( syncRoot );
+			// chunks must be passed in order
+			while( chunk.ticket != sentTicket ) {
+				Monitor::Wait( syncRoot );
+			}
+			try {
+				if( chunk.cells ) {
+					Int64 started = Stopwatch::GetTimestamp();
+					HypertableEventSource::Written( *chunk.cells );
+					SetCells( chunk.cells );
+					Int64 elapsedTicks = Stopwatch::GetTimestamp() - started;
+					if( HypertableEventSource::IsInstrumented ) {
+						HypertableEventSource::ChunkSent( started );
+					}
+					if( adaptiveChunkSize && !flush ) {
+						AdaptChunkSize( chunk.len, elapsedTicks );
 					}
+					statistics->AddChunk( chunkSize, elapsedTicks > 0 ? static_cast<double>(chunk.len) * Stopwatch::Frequency / elapsedTicks : 0.0 );
 				}
-				HT4N_RETHROW
-				finally {
-					cellChunk->clear();
-					lenTotal = 0;
+				if( flush || (flushEachChunk && chunk.cells) ) {
+					Int64 started = HypertableEventSource::Start();
+					tableMutator->flush();
+					HypertableEventSource::Flushed( started );
+				}
+			}
+			finally {
+				++sentTicket;
+				Monitor::PulseAll( syncRoot );
+			}
+		}
+		HT4N_RETHROW
+		finally {
+			if( chunk.cells ) {
+				ReleaseChunk( chunk.cells );
+			}
+			if( budget != nullptr && chunk.bytes ) {
+				budget->Release( chunk.bytes );
+			}
+		}
+	}
+
+	void ChunkedTableMutator::AdaptChunkSize( UInt32 len, Int64 elapsedTicks ) {
+		// AIMD, halve the chunk size if the latency exceeds the target, otherwise grow additively
+		if( elapsedTicks * TimeSpan::TicksPerSecond > targetChunkLatency * Stopwatch::Frequency ) {
+			chunkSize = __max( chunkSize / 2, minChunkSize );
+		}
+		else if( len >= chunkSize / 2 ) {
+			chunkSize = __min( chunkSize + minChunkSize, maxChunkSize );
+		}
+		cellCount = static_cast<UInt32>( __max(static_cast<UInt64>(maxCellCount) * chunkSize / maxChunkSize, 1ULL) );
+	}
+
+	void ChunkedTableMutator::SetCells( Common::Cells* chunk ) {
+		// called under syncRoot, coalesce before sorting since coalescing depends on the arrival order
+		try {
+			if( cellCoalescer && chunk->size() > 1 ) {
+				size_t elided = cellCoalescer->coalesce( *chunk, *coalescedChunk );
+				if( elided ) {
+					statistics->AddElided( static_cast<int>(elided) );
+					chunk = coalescedChunk;
 				}
 			}
+			// sorted chunks are cheaper to split into range server updates
+			if( cellSorter && chunk->size() > 1 && cellSorter->sort(*chunk, *sortedChunk) ) {
+				chunk = sortedChunk;
+			}
+			tableMutator->set( *chunk );
+		}
+		finally {
+			if( coalescedChunk ) {
+				coalescedChunk->clear();
+			}
+			if( sortedChunk ) {
+				sortedChunk->clear();
+			}
+		}
+	}
+
+	void ChunkedTableMutator::ReleaseChunk( Common::Cells* chunk ) {
+		chunk->clear();
+		msclr::lock sync( chunkRoot );
+		if( !spareChunk && cellChunk ) {
+			spareChunk = chunk;
+		}
+		else {
+			delete chunk;
 		}
-		return false;
 	}
 
 }
\ No newline at end of file
@@ -35,6 +35,11 @@ namespace Hypertable {
 	using namespace System;
 	using namespace ht4c;
 
+	ref class PendingBytesBudget;
+	ref class ValueCodecMap;
+	class CellSorter;
+	class CellCoalescer;
+
 	/// <summary>
 	/// Represents a chunked table mutator.
 	/// </summary>
@@ -68,18 +73,45 @@ namespace Hypertable {
 
 		internal:
 
-			ChunkedTableMutator( Common::TableMutator* tableMutator, UInt32 maxChunkSize, UInt32 maxCellCount, bool flushEachChunk );
+			ChunkedTableMutator( Common::TableMutator* tableMutator, UInt32 maxChunkSize, UInt32 maxCellCount, bool flushEachChunk, bool adaptiveChunkSize, UInt32 minChunkSize, TimeSpan targetChunkLatency, Int64 maxPendingBytes, bool sortChunks, bool coalesce, cli::array<String^>^ counterColumnFamilies, ValueCodecMap^ valueCodecs );
 
 		private:
 
-			bool SetChunk( bool force );
-
+			value struct SwappedChunk {
+				Common::Cells* cells;
+				Int64 ticket;
+				UInt32 len;
+				Int64 bytes;
+			};
+
+			void AddCell( Key^ key, cli::array<Byte>^ value, CellFlag cellFlag );
+			SwappedChunk SwapChunk( bool force );
+			void SetChunk( SwappedChunk chunk, bool flush );
+			void AdaptChunkSize( UInt32 len, Int64 elapsedTicks );
+			void ReleaseChunk( Common::Cells* chunk );
+			void SetCells( Common::Cells* chunk );
+
+			Object^ chunkRoot;
 			Common::Cells* cellChunk;
+			Common::Cells* spareChunk;
 			UInt32 lenTotal;
+			Int64 bytesTotal;
+			PendingBytesBudget^ budget;
+			Int64 nextTicket;
+			Int64 sentTicket;
+			UInt32 chunkSize;
+			UInt32 cellCount;
+			CellSorter* cellSorter;
+			Common::Cells* sortedChunk;
+			CellCoalescer* cellCoalescer;
+			Common::Cells* coalescedChunk;
 
 			const UInt32 maxChunkSize;
 			const UInt32 maxCellCount;
 			const bool flushEachChunk;
+			const bool adaptiveChunkSize;
+			const UInt32 minChunkSize;
+			const Int64 targetChunkLatency;
 	};
 
 }
\ No newline at end of file
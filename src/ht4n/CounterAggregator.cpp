@@ -0,0 +1,205 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#include "stdafx.h"
+
+#include "CounterAggregator.h"
+#include "IContext.h"
+#include "ITableMutator.h"
+#include "ContextFeature.h"
+#include "Counter.h"
+#include "Key.h"
+#include "Cell.h"
+#include "Exception.h"
+#include "Logging.h"
+
+namespace Hypertable {
+	using namespace System;
+	using namespace System::Threading;
+	using namespace System::Collections::Generic;
+
+	CounterAggregator::CounterAggregator( IContext^ context, ITableMutator^ _mutator )
+	: accumulators( gcnew ConcurrentDictionary<Key^, Accumulator^>() )
+	, mutator( _mutator )
+	, syncRoot( gcnew Object() )
+	, disposed( false )
+	{
+		if( context == nullptr ) throw gcnew ArgumentNullException( L"context" );
+		if( mutator == nullptr ) throw gcnew ArgumentNullException( L"mutator" );
+		if( !IsSupported(context) ) throw gcnew NotSupportedException( L"Counter columns are not supported by the context" );
+	}
+
+	CounterAggregator::CounterAggregator( IContext^ context, ITableMutator^ _mutator, TimeSpan flushInterval )
+	: accumulators( gcnew ConcurrentDictionary<Key^, Accumulator^>() )
+	, mutator( _mutator )
+	, syncRoot( gcnew Object() )
+	, disposed( false )
+	{
+		if( context == nullptr ) throw gcnew ArgumentNullException( L"context" );
+		if( mutator == nullptr ) throw gcnew ArgumentNullException( L"mutator" );
+		if( flushInterval.Ticks < 0 ) throw gcnew ArgumentException( L"Invalid parameter flushInterval (< 0)", L"flushInterval" );
+		if( !IsSupported(context) ) throw gcnew NotSupportedException( L"Counter columns are not supported by the context" );
+		if( flushInterval.Ticks > 0 ) {
+			timer = gcnew Timer( gcnew TimerCallback(this, &CounterAggregator::OnTimer), nullptr, flushInterval, flushInterval );
+		}
+	}
+
+	CounterAggregator::~CounterAggregator( ) {
+		if( disposed ) {
+			return;
+		}
+		disposed = true;
+		if( timer != nullptr ) {
+			delete timer;
+			timer = nullptr;
+		}
+		if( !mutator->IsDisposed ) {
+			SetCounters();
+			mutator->Flush();
+		}
+	}
+
+	void CounterAggregator::Increment( Key^ key, Int64 n ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		if( key == nullptr ) throw gcnew ArgumentNullException( L"key" );
+		ThrowIfTimerExceptionOccurred();
+		if( n ) {
+			SpinWait spinWait;
+			for( ;; ) {
+				Accumulator^ accumulator = GetAccumulator( key );
+				Int64 delta = Interlocked::Read( accumulator->delta );
+				if( delta == Accumulator::Evicted ) {
+					// the accumulator is about to be removed, retry with a new one
+					spinWait.SpinOnce();
+				}
+				else if( Interlocked::CompareExchange(accumulator->delta, delta + n, delta) == delta ) {
+					break;
+				}
+			}
+		}
+	}
+
+	void CounterAggregator::Decrement( Key^ key, Int64 n ) {
+		Increment( key, -n );
+	}
+
+	void CounterAggregator::ResetCounter( Key^ key, Int64 n ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		if( key == nullptr ) throw gcnew ArgumentNullException( L"key" );
+		ThrowIfTimerExceptionOccurred();
+		SpinWait spinWait;
+		for( ;; ) {
+			Accumulator^ accumulator = GetAccumulator( key );
+			msclr::lock sync( accumulator );
+			if( Interlocked::Read(accumulator->delta) != Accumulator::Evicted ) {
+				accumulator->resetValue = n;
+				accumulator->reset = true;
+				Interlocked::Exchange( accumulator->delta, 0 );
+				break;
+			}
+			sync.release();
+			spinWait.SpinOnce();
+		}
+	}
+
+	void CounterAggregator::Flush( ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		ThrowIfTimerExceptionOccurred();
+		SetCounters();
+		mutator->Flush();
+	}
+
+	bool CounterAggregator::IsSupported( IContext^ context ) {
+		if( context == nullptr ) throw gcnew ArgumentNullException( L"context" );
+		return context->HasFeature( ContextFeature::CounterColumn );
+	}
+
+	CounterAggregator::Accumulator^ CounterAggregator::GetAccumulator( Key^ key ) {
+		Accumulator^ accumulator;
+		if( !accumulators->TryGetValue(key, accumulator) ) {
+			// the key might be modified by the caller
+			Key^ clone = dynamic_cast<Key^>( key->Clone() );
+			Accumulator^ added = gcnew Accumulator();
+			accumulator = accumulators->TryAdd( clone, added ) ? added : accumulators[clone];
+		}
+		return accumulator;
+	}
+
+	void CounterAggregator::SetCounters( ) {
+		// serialized, succeeding instructions for the same counter must not overtake each other
+		msclr::lock sync( syncRoot );
+		List<Cell^>^ cells = gcnew List<Cell^>();
+		for each( KeyValuePair<Key^, Accumulator^> item in accumulators ) {
+			Accumulator^ accumulator = item.Value;
+			Counter^ counter = nullptr;
+			bool evicted = false;
+			{
+				msclr::lock syncAccumulator( accumulator );
+				Int64 delta = Interlocked::Exchange( accumulator->delta, 0 );
+				if( accumulator->reset ) {
+					counter = gcnew Counter( item.Key, accumulator->resetValue + delta );
+					accumulator->reset = false;
+				}
+				else if( delta ) {
+					counter = gcnew Counter( item.Key );
+					counter->IncrementCounter( delta );
+				}
+				else {
+					// idle since the previous flush, concurrent increments retry unless they have been added before
+					evicted = Interlocked::CompareExchange( accumulator->delta, Accumulator::Evicted, 0LL ) == 0;
+				}
+			}
+			if( counter != nullptr ) {
+				cells->Add( counter->ToCell() );
+			}
+			else if( evicted ) {
+				Accumulator^ removed;
+				accumulators->TryRemove( item.Key, removed );
+			}
+		}
+		if( cells->Count > 0 ) {
+			mutator->Set( cells );
+		}
+	}
+
+	void CounterAggregator::OnTimer( Object^ ) {
+		try {
+			if( !disposed ) {
+				SetCounters();
+			}
+		}
+		catch( Exception^ e ) {
+			Logging::TraceException( e );
+			timerException = e;
+		}
+	}
+
+	void CounterAggregator::ThrowIfTimerExceptionOccurred( ) {
+		if( timerException != nullptr ) {
+			throw gcnew AggregateException( "Counter aggregation have been aborted", timerException );
+		}
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,168 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#pragma once
+
+#ifndef __cplusplus_cli
+#error "requires /clr"
+#endif
+
+namespace Hypertable {
+	using namespace System;
+	using namespace System::Threading;
+	using namespace System::Collections::Concurrent;
+
+	interface class IContext;
+	interface class ITableMutator;
+	ref class Key;
+
+	/// <summary>
+	/// Represents a client-side counter aggregator, sums up counter instructions per key in memory.
+	/// </summary>
+	/// <remarks>
+	/// Increments are accumulated lock-free per key and passed as a single counter instruction per key to the
+	/// table mutator on Flush or periodically if a flush interval has been specified. A reset discards all
+	/// increments added before, reset and succeeding increments will be passed as a single reset instruction.
+	/// Counters without any increment or reset since the previous flush are no longer tracked after the next flush.
+	/// The aggregator does not take ownership of the table mutator, the table mutator must outlive the aggregator.
+	/// Requires a context providing ContextFeature.CounterColumn.
+	/// </remarks>
+	/// <example>
+	/// The following example shows how to aggregate counter increments.
+	/// <code>
+	/// using( var mutator = table.CreateMutator() ) {
+	///    using( var aggregator = new CounterAggregator(context, mutator, TimeSpan.FromSeconds(1)) ) {
+	///       Key key = new Key("row", "cf");
+	///       for( int n = 0; n &lt; 1000; ++n ) {
+	///          aggregator.Increment(key, 1);
+	///       }
+	///    }
+	/// }
+	/// </code>
+	/// </example>
+	/// <seealso cref="Counter"/>
+	/// <seealso cref="ContextFeature"/>
+	public ref class CounterAggregator sealed : public IDisposable {
+
+		public:
+
+			/// <summary>
+			/// Initializes a new instance of the CounterAggregator class.
+			/// </summary>
+			/// <param name="context">Context, used to verify the counter column feature.</param>
+			/// <param name="mutator">Table mutator to pass the aggregated counter instructions to.</param>
+			/// <exception cref="NotSupportedException">If the context does not support counter columns.</exception>
+			/// <seealso cref="IContext"/>
+			/// <seealso cref="ITableMutator"/>
+			CounterAggregator( IContext^ context, ITableMutator^ mutator );
+
+			/// <summary>
+			/// Initializes a new instance of the CounterAggregator class.
+			/// </summary>
+			/// <param name="context">Context, used to verify the counter column feature.</param>
+			/// <param name="mutator">Table mutator to pass the aggregated counter instructions to.</param>
+			/// <param name="flushInterval">Interval to pass the aggregated counter instructions to the table mutator, zero to disable periodic passing.</param>
+			/// <exception cref="NotSupportedException">If the context does not support counter columns.</exception>
+			/// <seealso cref="IContext"/>
+			/// <seealso cref="ITableMutator"/>
+			CounterAggregator( IContext^ context, ITableMutator^ mutator, TimeSpan flushInterval );
+
+			/// <summary>
+			/// Passes the pending counter instructions and clean up all resources.
+			/// </summary>
+			virtual ~CounterAggregator( );
+
+			/// <summary>
+			/// Gets the number of counter keys tracked by the aggregator.
+			/// </summary>
+			property int Count {
+				int get( ) {
+					return accumulators->Count;
+				}
+			}
+
+			/// <summary>
+			/// Increments the counter value by the value specified.
+			/// </summary>
+			/// <param name="key">Counter key.</param>
+			/// <param name="n">Increment value.</param>
+			/// <seealso cref="Key"/>
+			void Increment( Key^ key, Int64 n );
+
+			/// <summary>
+			/// Decrements the counter value by the value specified.
+			/// </summary>
+			/// <param name="key">Counter key.</param>
+			/// <param name="n">Decrement value.</param>
+			/// <seealso cref="Key"/>
+			void Decrement( Key^ key, Int64 n );
+
+			/// <summary>
+			/// Resets the counter value to the value specified, discards all pending increments for this counter.
+			/// </summary>
+			/// <param name="key">Counter key.</param>
+			/// <param name="n">Reset value.</param>
+			/// <seealso cref="Key"/>
+			void ResetCounter( Key^ key, Int64 n );
+
+			/// <summary>
+			/// Passes the pending counter instructions to the table mutator and flushes the table mutator.
+			/// </summary>
+			void Flush( );
+
+			/// <summary>
+			/// Returns true if the context specified supports counter aggregation.
+			/// </summary>
+			/// <param name="context">Context.</param>
+			/// <returns>true if the context supports counter columns, otherwise false.</returns>
+			static bool IsSupported( IContext^ context );
+
+		private:
+
+			ref class Accumulator sealed {
+
+				public:
+
+					Int64 delta;
+					Int64 resetValue;
+					bool reset;
+
+					/// <summary>
+					/// Delta of an evicted accumulator, which is about to be removed.
+					/// </summary>
+					literal Int64 Evicted = INT64_MIN;
+			};
+
+			Accumulator^ GetAccumulator( Key^ key );
+			void SetCounters( );
+			void OnTimer( Object^ state );
+			void ThrowIfTimerExceptionOccurred( );
+
+			ConcurrentDictionary<Key^, Accumulator^>^ accumulators;
+			ITableMutator^ mutator;
+			Timer^ timer;
+			Object^ syncRoot;
+			Exception^ timerException;
+			bool disposed;
+	};
+
+}
\ No newline at end of file
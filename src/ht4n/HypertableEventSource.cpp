@@ -0,0 +1,259 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#include "stdafx.h"
+
+#include "HypertableEventSource.h"
+#include "Key.h"
+#include "MutatorStatistics.h"
+#include "CM2U8.h"
+
+#include "ht4c.Common/Cell.h"
+#include "ht4c.Common/Cells.h"
+
+namespace Hypertable {
+	using namespace System;
+	using namespace System::Diagnostics;
+	using namespace System::Diagnostics::Tracing;
+	using namespace System::Collections::Generic;
+	using namespace ht4c;
+
+	namespace {
+
+		Int64 SizeOf( const Common::Cell& cell ) {
+			return strlen( cell.row() )
+					 + (cell.columnFamily() ? strlen(cell.columnFamily()) : 0)
+					 + (cell.columnQualifier() ? strlen(cell.columnQualifier()) : 0)
+					 + cell.valueLength();
+		}
+
+	}
+
+	Int64 HypertableEventSource::Start( ) {
+		return Log->IsEnabled() ? Stopwatch::GetTimestamp() : 0;
+	}
+
+	void HypertableEventSource::Written( Key^ key, UInt32 valueLength ) {
+		if( Log->IsEnabled() ) {
+			// utf8 bytes, as for the native cells
+			Int64 bytes = valueLength;
+			bytes += CM2U8::Utf8Length( key->Row );
+			bytes += CM2U8::Utf8Length( key->ColumnFamily );
+			bytes += CM2U8::Utf8Length( key->ColumnQualifier );
+			cellsWritten->Add( 1 );
+			bytesWritten->Add( bytes );
+		}
+	}
+
+	void HypertableEventSource::Written( Common::Cells& cells ) {
+		if( Log->IsEnabled() && cells.size() ) {
+			Common::Cell* cell = Common::Cell::create();
+			try {
+				Int64 bytes = 0;
+				for( size_t n = 0; n < cells.size(); ++n ) {
+					cells.get_unchecked( n, cell );
+					bytes += SizeOf( *cell );
+				}
+				cellsWritten->Add( cells.size() );
+				bytesWritten->Add( bytes );
+			}
+			finally {
+				delete cell;
+			}
+		}
+	}
+
+	void HypertableEventSource::Scanned( const Common::Cell& cell ) {
+		if( Log->IsEnabled() ) {
+			cellsScanned->Add( 1 );
+			bytesScanned->Add( SizeOf(cell) );
+		}
+	}
+
+	void HypertableEventSource::Scanned( Common::Cells& cells ) {
+		if( Log->IsEnabled() && cells.size() ) {
+			Common::Cell* cell = Common::Cell::create();
+			try {
+				Int64 bytes = 0;
+				for( size_t n = 0; n < cells.size(); ++n ) {
+					cells.get_unchecked( n, cell );
+					bytes += SizeOf( *cell );
+				}
+				cellsScanned->Add( cells.size() );
+				bytesScanned->Add( bytes );
+			}
+			finally {
+				delete cell;
+			}
+		}
+	}
+
+	void HypertableEventSource::Delivered( int count ) {
+		if( Log->IsEnabled() ) {
+			cellsDelivered->Add( count );
+		}
+	}
+
+	void HypertableEventSource::ChunkSent( Int64 started ) {
+		#ifdef NETCORE
+		if( started ) {
+			EventCounter^ counter = Log->chunkLatency;
+			if( counter != nullptr ) {
+				counter->WriteMetric( ElapsedMilliseconds(started) );
+			}
+		}
+		#endif
+	}
+
+	void HypertableEventSource::Flushed( Int64 started ) {
+		if( started ) {
+			double elapsed = ElapsedMilliseconds( started );
+			{
+				msclr::lock sync( syncRoot );
+				flushLatencies[flushLatencyIndex] = elapsed;
+				flushLatencyIndex = (flushLatencyIndex + 1) % flushLatencies->Length;
+				flushLatencyCount = Math::Min( flushLatencyCount + 1, flushLatencies->Length );
+			}
+			#ifdef NETCORE
+			EventCounter^ counter = Log->flushLatency;
+			if( counter != nullptr ) {
+				counter->WriteMetric( elapsed );
+			}
+			#endif
+		}
+	}
+
+	void HypertableEventSource::MutatorOpened( ) {
+		openMutators->Add( 1 );
+	}
+
+	void HypertableEventSource::MutatorClosed( ) {
+		openMutators->Add( -1 );
+	}
+
+	void HypertableEventSource::ScannerOpened( ) {
+		openScanners->Add( 1 );
+	}
+
+	void HypertableEventSource::ScannerClosed( ) {
+		openScanners->Add( -1 );
+	}
+
+	void HypertableEventSource::RegisterQueue( MutatorStatistics^ statistics ) {
+		#ifdef NETCORE
+		// partitioned mutators share the statistics
+		queues->AddOrUpdate( statistics, nullptr );
+		#endif
+	}
+
+	void HypertableEventSource::OnEventCommand( EventCommandEventArgs^ command ) {
+		#ifdef NETCORE
+		if( command->Command == EventCommand::Enable && counters == nullptr ) {
+			TimeSpan second = TimeSpan::FromSeconds( 1 );
+			counters = gcnew List<DiagnosticCounter^>();
+
+			IncrementingPollingCounter^ rate;
+			rate = gcnew IncrementingPollingCounter( L"cells-written", this, gcnew Func<double>(cellsWritten, &Gauge::Read) );
+			rate->DisplayName = L"Cells Written";
+			rate->DisplayRateTimeScale = second;
+			counters->Add( rate );
+			rate = gcnew IncrementingPollingCounter( L"bytes-written", this, gcnew Func<double>(bytesWritten, &Gauge::Read) );
+			rate->DisplayName = L"Bytes Written";
+			rate->DisplayUnits = L"B";
+			rate->DisplayRateTimeScale = second;
+			counters->Add( rate );
+			rate = gcnew IncrementingPollingCounter( L"cells-scanned", this, gcnew Func<double>(cellsScanned, &Gauge::Read) );
+			rate->DisplayName = L"Cells Scanned";
+			rate->DisplayRateTimeScale = second;
+			counters->Add( rate );
+			rate = gcnew IncrementingPollingCounter( L"bytes-scanned", this, gcnew Func<double>(bytesScanned, &Gauge::Read) );
+			rate->DisplayName = L"Bytes Scanned";
+			rate->DisplayUnits = L"B";
+			rate->DisplayRateTimeScale = second;
+			counters->Add( rate );
+			rate = gcnew IncrementingPollingCounter( L"blocking-async-cells", this, gcnew Func<double>(cellsDelivered, &Gauge::Read) );
+			rate->DisplayName = L"Cells Retrieved from Blocking Async Results";
+			rate->DisplayRateTimeScale = second;
+			counters->Add( rate );
+
+			chunkLatency = gcnew EventCounter( L"chunk-send-latency", this );
+			chunkLatency->DisplayName = L"Chunk Send Latency";
+			chunkLatency->DisplayUnits = L"ms";
+			flushLatency = gcnew EventCounter( L"flush-latency", this );
+			flushLatency->DisplayName = L"Flush Latency";
+			flushLatency->DisplayUnits = L"ms";
+
+			PollingCounter^ gauge;
+			cli::array<double>^ quantiles = { 0.5, 0.95, 0.99 };
+			for each( double q in quantiles ) {
+				int p = static_cast<int>( q * 100 );
+				gauge = gcnew PollingCounter( String::Format(L"flush-latency-p{0}", p), this, gcnew Func<double>(gcnew Percentile(q), &Percentile::Read) );
+				gauge->DisplayName = String::Format( L"Flush Latency P{0}", p );
+				gauge->DisplayUnits = L"ms";
+				counters->Add( gauge );
+			}
+			gauge = gcnew PollingCounter( L"queue-depth", this, gcnew Func<double>(&HypertableEventSource::QueueDepth) );
+			gauge->DisplayName = L"Queued Mutator Queue Depth";
+			counters->Add( gauge );
+			gauge = gcnew PollingCounter( L"open-mutators", this, gcnew Func<double>(openMutators, &Gauge::Read) );
+			gauge->DisplayName = L"Open Mutators";
+			counters->Add( gauge );
+			gauge = gcnew PollingCounter( L"open-scanners", this, gcnew Func<double>(openScanners, &Gauge::Read) );
+			gauge->DisplayName = L"Open Scanners";
+			counters->Add( gauge );
+		}
+		#endif
+	}
+
+	HypertableEventSource::HypertableEventSource( ) {
+	}
+
+	double HypertableEventSource::QueueDepth( ) {
+		double depth = 0;
+		#ifdef NETCORE
+		for each( KeyValuePair<MutatorStatistics^, Object^> queue in static_cast<IEnumerable<KeyValuePair<MutatorStatistics^, Object^>>^>(queues) ) {
+			depth += queue.Key->QueueDepth;
+		}
+		#endif
+		return depth;
+	}
+
+	double HypertableEventSource::ElapsedMilliseconds( Int64 started ) {
+		return (Stopwatch::GetTimestamp() - started) * 1000.0 / Stopwatch::Frequency;
+	}
+
+	double HypertableEventSource::Percentile::Read( ) {
+		cli::array<double>^ samples;
+		{
+			msclr::lock sync( syncRoot );
+			int count = flushLatencyCount;
+			if( count == 0 ) {
+				return 0;
+			}
+			samples = gcnew cli::array<double>( count );
+			Array::Copy( flushLatencies, samples, count );
+		}
+		Array::Sort( samples );
+		return samples[Math::Min(static_cast<int>(q * samples->Length), samples->Length - 1)];
+	}
+
+}
\ No newline at end of file
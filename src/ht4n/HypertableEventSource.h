@@ -0,0 +1,149 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#pragma once
+
+#ifndef __cplusplus_cli
+#error "requires /clr"
+#endif
+
+namespace ht4c { namespace Common {
+	class Cell;
+	class Cells;
+} }
+
+namespace Hypertable {
+	using namespace System;
+	using namespace System::Diagnostics::Tracing;
+	using namespace ht4c;
+
+	ref class Key;
+	ref class MutatorStatistics;
+
+	/// <summary>
+	/// Represents the ht4n event source, publishes mutator and scanner event counters.
+	/// </summary>
+	/// <remarks>
+	/// The event counters are available on .NET Core only, for example 'dotnet-counters monitor --counters ht4n'.
+	/// Cells and bytes are counted and latencies measured only while a listener has enabled the event source,
+	/// open mutators and scanners are counted regardless.
+	/// </remarks>
+	[EventSourceAttribute(Name = L"ht4n")]
+	ref class HypertableEventSource sealed : public EventSource {
+
+		internal:
+
+			static property bool IsInstrumented {
+				bool get( ) {
+					return Log->IsEnabled();
+				}
+			}
+
+			static Int64 Start( );
+			static void Written( Key^ key, UInt32 valueLength );
+			static void Written( Common::Cells& cells );
+			static void Scanned( const Common::Cell& cell );
+			static void Scanned( Common::Cells& cells );
+			static void Delivered( int count );
+			static void ChunkSent( Int64 started );
+			static void Flushed( Int64 started );
+			static void MutatorOpened( );
+			static void MutatorClosed( );
+			static void ScannerOpened( );
+			static void ScannerClosed( );
+			static void RegisterQueue( MutatorStatistics^ statistics );
+
+		protected:
+
+			virtual void OnEventCommand( EventCommandEventArgs^ command ) override;
+
+		private:
+
+			ref class Gauge sealed {
+
+				public:
+
+					void Add( Int64 value ) {
+						Threading::Interlocked::Add( this->value, value );
+					}
+
+					double Read( ) {
+						return static_cast<double>( Threading::Interlocked::Read(value) );
+					}
+
+				private:
+
+					Int64 value;
+			};
+
+			ref class Percentile sealed {
+
+				public:
+
+					Percentile( double _q )
+					: q( _q ) {
+					}
+
+					double Read( );
+
+				private:
+
+					const double q;
+			};
+
+			HypertableEventSource( );
+
+			static double QueueDepth( );
+
+			static double ElapsedMilliseconds( Int64 started );
+
+			static initonly Gauge^ cellsWritten = gcnew Gauge();
+			static initonly Gauge^ bytesWritten = gcnew Gauge();
+			static initonly Gauge^ cellsScanned = gcnew Gauge();
+			static initonly Gauge^ bytesScanned = gcnew Gauge();
+			static initonly Gauge^ cellsDelivered = gcnew Gauge();
+			static initonly Gauge^ openMutators = gcnew Gauge();
+			static initonly Gauge^ openScanners = gcnew Gauge();
+
+			// most recent flush latencies in milliseconds, percentiles are taken from this window
+			static initonly cli::array<double>^ flushLatencies = gcnew cli::array<double>( 1024 );
+			static int flushLatencyIndex = 0;
+			static int flushLatencyCount = 0;
+			static Object^ syncRoot = gcnew Object();
+
+			#ifdef NETCORE
+
+			static initonly Runtime::CompilerServices::ConditionalWeakTable<MutatorStatistics^, Object^>^ queues = gcnew Runtime::CompilerServices::ConditionalWeakTable<MutatorStatistics^, Object^>();
+
+			EventCounter^ chunkLatency;
+			EventCounter^ flushLatency;
+			Collections::Generic::List<DiagnosticCounter^>^ counters;
+
+			#endif
+
+		internal:
+
+			// initialized last, enabling the event source creates counters on the gauges above
+			static initonly HypertableEventSource^ Log = gcnew HypertableEventSource();
+	};
+
+}
\ No newline at end of file
@@ -26,6 +26,8 @@
 #endif
 
 #include "AsyncScannerCallback.h"
+#include "AsyncScanBlockCallback.h"
+#include "AsyncRowCallback.h"
 
 namespace Hypertable {
 	using namespace System;
@@ -37,6 +39,8 @@ namespace Hypertable {
 	ref class ScanSpec;
 	ref class Cell;
 	ref class AsyncResult;
+	ref class BulkLoadOptions;
+	ref class BulkLoadStatistics;
 
 	namespace Xml {
 
@@ -165,6 +169,37 @@ namespace Hypertable {
 			/// <returns>Newly created table mutator instance.</returns>
 			ITableScanner^ CreateScanner( ScanSpec^ scanSpec );
 
+			/// <summary>
+			/// Creates a new table scanner on this table which scans disjoint row partitions concurrently,
+			/// the cells are returned in key order.
+			/// </summary>
+			/// <param name="scanSpec">Table scanner specification, might be null.</param>
+			/// <param name="degree">Maximum number of concurrent partition scans.</param>
+			/// <returns>Newly created table scanner instance.</returns>
+			/// <remarks>
+			/// Rows, cells, row intervals or cell intervals of the scan specification are split into
+			/// contiguous partitions. MaxRows and MaxCells apply to each row or cell interval as for
+			/// a sequential scanner. Scan specifications without row predicates or with a single row
+			/// interval are split at rows sampled by keys only probe scans, unless MaxRows or MaxCells
+			/// have been specified. Scan specifications with mixed row predicates, a single cell interval,
+			/// RowOffset or CellOffset are not split, they are scanned by a single prefetching worker and
+			/// a warning is traced. ScannerStatistics.Partitions reports the number of partitions.
+			/// </remarks>
+			ITableScanner^ CreateParallelScanner( ScanSpec^ scanSpec, int degree );
+
+			/// <summary>
+			/// Creates a new table scanner on this table which scans disjoint row partitions concurrently.
+			/// </summary>
+			/// <param name="scanSpec">Table scanner specification, might be null.</param>
+			/// <param name="degree">Maximum number of concurrent partition scans.</param>
+			/// <param name="ordered">true to return the cells in key order, false to return the cells as they arrive.</param>
+			/// <returns>Newly created table scanner instance.</returns>
+			/// <remarks>
+			/// The cells of a row are always returned contiguously. Unordered scans do not wait
+			/// for preceding partitions and give the highest throughput.
+			/// </remarks>
+			ITableScanner^ CreateParallelScanner( ScanSpec^ scanSpec, int degree, bool ordered );
+
 			/// <summary>
 			/// Creates a new asynchronous scanner on this table and attach it
 			/// to the specified asynchronous result instance.
@@ -224,11 +259,115 @@ namespace Hypertable {
 			/// <returns>Asynchronous scanner identifier.</returns>
 			int64_t BeginScan( AsyncResult^ asyncResult, ScanSpec^ scanSpec, Object^ param, AsyncScannerCallback^ callback );
 
+			/// <summary>
+			/// Creates a new asynchronous scanner on this table using the specified scanner specification
+			/// and attach to the specified asynchronous result instance, the scanned cells are delivered as scan blocks.
+			/// </summary>
+			/// <param name="asyncResult">Asynchronous result instance.</param>
+			/// <param name="scanSpec">Table scanner specification.</param>
+			/// <param name="param">User defined parameter, which will be passed to the callback.</param>
+			/// <param name="callback">Asynchronous scan block callback.</param>
+			/// <returns>Asynchronous scanner identifier.</returns>
+			/// <remarks>
+			/// The scan block will be reused for subsequent callbacks, blocking asynchronous results are not supported.
+			/// </remarks>
+			/// <seealso cref="ScanBlock"/>
+			int64_t BeginBlockScan( AsyncResult^ asyncResult, ScanSpec^ scanSpec, Object^ param, AsyncScanBlockCallback^ callback );
+
+			/// <summary>
+			/// Creates a new asynchronous scanner on this table using the specified scanner specification
+			/// and attach to the specified asynchronous result instance, the scanned cells are delivered grouped into rows.
+			/// </summary>
+			/// <param name="asyncResult">Asynchronous result instance.</param>
+			/// <param name="scanSpec">Table scanner specification.</param>
+			/// <param name="param">User defined parameter, which will be passed to the callback.</param>
+			/// <param name="callback">Asynchronous row callback.</param>
+			/// <returns>Asynchronous scanner identifier.</returns>
+			/// <remarks>
+			/// The row boundaries are detected on the utf8 encoded row keys of the scan blocks, rows spanning several
+			/// blocks are delivered once complete. The last row is delivered after the scanner has been detached.
+			/// The row instance will be reused for subsequent callbacks, blocking asynchronous results are not supported.
+			/// </remarks>
+			/// <seealso cref="Row"/>
+			/// <seealso cref="RowScanner"/>
+			int64_t BeginRowScan( AsyncResult^ asyncResult, ScanSpec^ scanSpec, Object^ param, AsyncRowCallback^ callback );
+
+			#ifdef NETCORE
+
+			/// <summary>
+			/// Scans this table asynchronously using the specified scanner specification.
+			/// </summary>
+			/// <param name="scanSpec">Table scanner specification, might be null.</param>
+			/// <param name="cancellationToken">Cancellation token, cancels the asynchronous scanner.</param>
+			/// <returns>Asynchronous sequence of the scanned cells.</returns>
+			/// <remarks>
+			/// Each enumeration starts an asynchronous scanner, the scanned cells are buffered in a bounded channel.
+			/// Awaiting the next cell never blocks a thread. If the channel is full, the native scanner callback thread
+			/// waits for the consumer, but at most ScanSpec.ConsumerTimeout, then the scanner gets cancelled and the
+			/// enumeration fails with a TimeoutException. Always dispose the enumerator (await foreach does), an
+			/// abandoned enumerator holds the scanner callback thread until the timeout elapses, or forever if no
+			/// consumer timeout has been specified.
+			/// </remarks>
+			/// <example>
+			/// The following example shows how to scan a table asynchronously.
+			/// <code>
+			/// await foreach( var cell in table.ScanAsync(new ScanSpec().AddColumn("a"), cancellationToken) ) {
+			///    // process cell
+			/// }
+			/// </code>
+			/// </example>
+			IAsyncEnumerable<Cell^>^ ScanAsync( ScanSpec^ scanSpec, Threading::CancellationToken cancellationToken );
+
+			/// <summary>
+			/// Scans this table asynchronously using the specified scanner specification, the scanned cells
+			/// are delivered in batches as received by the asynchronous scanner.
+			/// </summary>
+			/// <param name="scanSpec">Table scanner specification, might be null.</param>
+			/// <param name="cancellationToken">Cancellation token, cancels the asynchronous scanner.</param>
+			/// <returns>Asynchronous sequence of the scanned cell batches.</returns>
+			/// <seealso cref="ScanAsync"/>
+			IAsyncEnumerable<IReadOnlyList<Cell^>^>^ ScanBatchesAsync( ScanSpec^ scanSpec, Threading::CancellationToken cancellationToken );
+
+			#endif
+
 			/// <summary>
 			/// Gets a table schema instance.
 			/// </summary>
 			/// <returns>The table schem instance.</returns>
 			Xml::TableSchema^ GetTableSchema( );
+
+			/// <summary>
+			/// Loads the specified tab delimited file into this table.
+			/// </summary>
+			/// <param name="path">Input file path.</param>
+			/// <param name="options">Bulk load options, might be null.</param>
+			/// <returns>The bulk load statistics.</returns>
+			/// <remarks>
+			/// The input format corresponds to the Hypertable LOAD DATA INFILE format, each line consists of
+			/// row, column and value separated by tabs. A leading '#timestamp\trow\tcolumn\tvalue' header line
+			/// declares an additional leading timestamp field on every line, any other '#' header line will be
+			/// skipped. The column is either 'column family' or 'column family:column qualifier', timestamps are
+			/// nanoseconds since epoch or formatted as 'YYYY-MM-DD HH:MM:SS[.nanoseconds]' (UTC). Malformed lines
+			/// are skipped and counted. The input is expected to be UTF-8 encoded. If the load fails, the exception
+			/// of the failing parser or native mutator is thrown.
+			/// </remarks>
+			/// <seealso cref="BulkLoadOptions"/>
+			/// <seealso cref="BulkLoadStatistics"/>
+			BulkLoadStatistics^ BulkLoad( String^ path, BulkLoadOptions^ options );
+
+			/// <summary>
+			/// Loads tab delimited input from the specified stream into this table.
+			/// </summary>
+			/// <param name="stream">Input stream.</param>
+			/// <param name="options">Bulk load options, might be null.</param>
+			/// <returns>The bulk load statistics.</returns>
+			/// <remarks>
+			/// See BulkLoad(String, BulkLoadOptions) for the input format. The stream will be read to the end,
+			/// but not closed.
+			/// </remarks>
+			/// <seealso cref="BulkLoadOptions"/>
+			/// <seealso cref="BulkLoadStatistics"/>
+			BulkLoadStatistics^ BulkLoad( IO::Stream^ stream, BulkLoadOptions^ options );
 	};
 
 }
\ No newline at end of file
@@ -34,6 +34,7 @@ namespace Hypertable {
 
 	ref class Key;
 	ref class Cell;
+	ref class MutatorStatistics;
 
 	/// <summary>
 	/// Defines a generalized table mutator.
@@ -89,6 +90,14 @@ namespace Hypertable {
 				bool get( );
 			}
 
+			/// <summary>
+			/// Gets the mutator statistics.
+			/// </summary>
+			/// <seealso cref="MutatorStatistics"/>
+			property MutatorStatistics^ Statistics {
+				MutatorStatistics^ get( );
+			}
+
 			/// <summary>
 			/// Inserts a new cell into a table.
 			/// </summary>
@@ -211,6 +220,58 @@ namespace Hypertable {
 			/// Flushes the accumulated mutations to their respective range servers.
 			/// </summary>
 			void Flush();
+
+			/// <summary>
+			/// Inserts multiple cells into a table or delete cells asynchronously.
+			/// </summary>
+			/// <param name="cells">Cell collection to insert.</param>
+			/// <returns>A task that represents the asynchronous operation.</returns>
+			/// <remarks>
+			/// The cell collection must not be modified until the task has completed. For queued mutators
+			/// the task completes as soon as the cells have been queued. Other mutators run the blocking
+			/// Set on a thread pool thread, each pending call ties up a pool thread until the native mutator
+			/// has accepted the cells; use a queued mutator for many concurrent calls.
+			/// </remarks>
+			/// <seealso cref="Cell"/>
+			System::Threading::Tasks::Task^ SetAsync( IEnumerable<Cell^>^ cells );
+
+			/// <summary>
+			/// Inserts multiple cells into a table or delete cells asynchronously.
+			/// </summary>
+			/// <param name="cells">Cell collection to insert.</param>
+			/// <param name="cancellationToken">The token to monitor for cancellation requests.</param>
+			/// <returns>A task that represents the asynchronous operation.</returns>
+			/// <remarks>
+			/// The cell collection must not be modified until the task has completed. For queued mutators
+			/// the task completes as soon as the cells have been queued. Other mutators run the blocking
+			/// Set on a thread pool thread, each pending call ties up a pool thread until the native mutator
+			/// has accepted the cells; use a queued mutator for many concurrent calls.
+			/// </remarks>
+			/// <seealso cref="Cell"/>
+			System::Threading::Tasks::Task^ SetAsync( IEnumerable<Cell^>^ cells, System::Threading::CancellationToken cancellationToken );
+
+			/// <summary>
+			/// Flushes the accumulated mutations to their respective range servers asynchronously.
+			/// </summary>
+			/// <returns>A task that represents the asynchronous operation.</returns>
+			/// <remarks>
+			/// Mutators other than queued mutators run the blocking Flush on a thread pool thread,
+			/// which is tied up until the flush has completed.
+			/// </remarks>
+			System::Threading::Tasks::Task^ FlushAsync( );
+
+			/// <summary>
+			/// Flushes the accumulated mutations to their respective range servers asynchronously.
+			/// </summary>
+			/// <param name="cancellationToken">The token to monitor for cancellation requests.</param>
+			/// <returns>A task that represents the asynchronous operation.</returns>
+			/// <remarks>
+			/// For queued mutators the task completes on the consumer once all queued cells have been passed
+			/// to the underlying mutator and flushed, no thread is blocked while waiting. Cancelling the task
+			/// does not cancel the mutations. Other mutators run the blocking Flush on a thread pool thread,
+			/// which is tied up until the flush has completed.
+			/// </remarks>
+			System::Threading::Tasks::Task^ FlushAsync( System::Threading::CancellationToken cancellationToken );
 	};
 
 }
@@ -25,6 +25,8 @@
 #error "requires /clr"
 #endif
 
+#include "CellVisitor.h"
+
 namespace Hypertable {
 	using namespace System;
 	using namespace System::Collections::Generic;
@@ -34,7 +36,10 @@ namespace Hypertable {
 	ref class Cell;
 	ref class BufferedCell;
 	ref class PooledCell;
+	ref class ScanBlock;
 	ref class ScanSpec;
+	value struct CellView;
+	ref class ScannerStatistics;
 
 	/// <summary>
 	/// Defines a generalized table scanner.
@@ -64,6 +69,29 @@ namespace Hypertable {
 	///    }
 	/// }
 	/// </code>
+	/// The following example shows how to scan all cells of a table in batches of buffered cells.
+	/// <code>
+	/// using( var scanner = table.CreateScanner() ) {
+	///    BufferedCell[] cells = new BufferedCell[1024];
+	///    int count;
+	///    while( scanner.MoveBatch(cells, out count) ) {
+	///       for( int n = 0; n &lt; count; ++n ) {
+	///          // process cells[n]
+	///       }
+	///    }
+	/// }
+	/// </code>
+	/// The following example shows how to scan all cells of a table without allocating any object per cell.
+	/// <code>
+	/// using( var scanner = table.CreateScanner() ) {
+	///    int count;
+	///    while( scanner.VisitBatch(view => {
+	///       // process view.Row, view.RowLength, view.Value, view.ValueLength
+	///       return true;
+	///    }, 1024, out count) ) {
+	///    }
+	/// }
+	/// </code>
 	/// </example>
 	/// <seealso cref="ScanSpec"/>
 	/// <seealso cref="Cell"/>
@@ -89,6 +117,14 @@ namespace Hypertable {
 				bool get( );
 			}
 
+			/// <summary>
+			/// Gets the scanner statistics.
+			/// </summary>
+			/// <seealso cref="ScannerStatistics"/>
+			property ScannerStatistics^ Statistics {
+				ScannerStatistics^ get( );
+			}
+
 			/// <summary>
 			/// Gets the next available cell using the specified cell instance.
 			/// </summary>
@@ -119,6 +155,28 @@ namespace Hypertable {
 			/// </remarks>
 			bool Move( PooledCell^ cell );
 
+			/// <summary>
+			/// Gets the next available cells using the specified cell instances.
+			/// </summary>
+			/// <param name="cells">Cell instances to fill, null elements will be allocated.</param>
+			/// <param name="count">Number of cells filled. This parameter is passed uninitialized.</param>
+			/// <returns>true if at least one cell has been filled, otherwise false.</returns>
+			/// <remarks>
+			/// The methods updates up to cells.Length cell instances, the cell value buffers are retained.
+			/// </remarks>
+			bool MoveBatch( cli::array<BufferedCell^>^ cells, [Out] int% count );
+
+			/// <summary>
+			/// Fills the specified scan block with the next available cells.
+			/// </summary>
+			/// <param name="block">Scan block to fill.</param>
+			/// <returns>true if the block contains at least one cell, otherwise false.</returns>
+			/// <remarks>
+			/// The method clears the block and adds up to block.Capacity cells, the block buffers are retained.
+			/// </remarks>
+			/// <seealso cref="ScanBlock"/>
+			bool Move( ScanBlock^ block );
+
 			/// <summary>
 			/// Gets the next available cell, creating a new cell instance.
 			/// </summary>
@@ -135,6 +193,30 @@ namespace Hypertable {
 			/// <param name="action">The action called with the scanned cell.</param>
 			/// <returns>true if there are more cells available, otherwise false.</returns>
 			bool Next(Func<Key^, IntPtr, int, bool>^ action);
+
+			/// <summary>
+			/// Visits the next available cell without allocating any object.
+			/// </summary>
+			/// <param name="visitor">The visitor called with the scanned cell.</param>
+			/// <returns>true if there are more cells available and the visitor has not stopped, otherwise false.</returns>
+			/// <remarks>
+			/// The cell view points into the native scanner buffers and is only valid for the duration of the visitor call.
+			/// </remarks>
+			/// <seealso cref="CellView"/>
+			bool Visit( CellVisitor^ visitor );
+
+			/// <summary>
+			/// Visits up to the specified number of cells without allocating any object per cell.
+			/// </summary>
+			/// <param name="visitor">The visitor called with each scanned cell.</param>
+			/// <param name="maxCount">Maximum number of cells to visit.</param>
+			/// <param name="count">Number of cells visited. This parameter is passed uninitialized.</param>
+			/// <returns>true if there are more cells available and the visitor has not stopped, otherwise false.</returns>
+			/// <remarks>
+			/// The scanner is locked once per batch. The cell views point into the native scanner buffers and are only valid for the duration of the visitor call.
+			/// </remarks>
+			/// <seealso cref="CellView"/>
+			bool VisitBatch( CellVisitor^ visitor, int maxCount, [Out] int% count );
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,91 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#pragma once
+
+#ifndef __cplusplus_cli
+#error "requires /clr"
+#endif
+
+namespace Hypertable {
+	using namespace System;
+
+	/// <summary>
+	/// Represents a cell value codec.
+	/// </summary>
+	/// <remarks>
+	/// Value codecs are configured per column family by MutatorSpec.ValueCodecs and ScanSpec.ValueCodecs.
+	/// Encoded values are prefixed by a small header which identifies the codec and the decoded length,
+	/// values without such a header will be read verbatim. Codecs must be thread-safe and, if the
+	/// mutator or scan specification gets serialized, serializable.
+	/// </remarks>
+	/// <seealso cref="Lz4ValueCodec"/>
+	/// <seealso cref="MutatorSpec"/>
+	/// <seealso cref="ScanSpec"/>
+	public interface class IValueCodec {
+
+		public:
+
+			/// <summary>
+			/// Gets the codec identifier, stored in the value header, zero is reserved.
+			/// </summary>
+			property Byte Id {
+				Byte get();
+			}
+
+			/// <summary>
+			/// Returns the maximum encoded length for the length specified.
+			/// </summary>
+			/// <param name="length">Value length in bytes.</param>
+			/// <returns>Maximum encoded length in bytes.</returns>
+			int GetMaxEncodedLength( int length );
+
+			/// <summary>
+			/// Returns the maximum decoded length for the encoded length specified, values with a larger
+			/// decoded length in the header are not considered to be encoded and are read verbatim.
+			/// </summary>
+			/// <param name="length">Encoded length in bytes.</param>
+			/// <returns>Maximum decoded length in bytes.</returns>
+			int GetMaxDecodedLength( int length );
+
+			/// <summary>
+			/// Encodes a value.
+			/// </summary>
+			/// <param name="source">Value to encode.</param>
+			/// <param name="length">Value length in bytes.</param>
+			/// <param name="target">Target buffer.</param>
+			/// <param name="capacity">Target buffer capacity in bytes.</param>
+			/// <returns>The encoded length in bytes, zero if the value cannot be encoded into the target buffer.</returns>
+			int Encode( IntPtr source, int length, IntPtr target, int capacity );
+
+			/// <summary>
+			/// Decodes a value.
+			/// </summary>
+			/// <param name="source">Value to decode.</param>
+			/// <param name="length">Encoded length in bytes.</param>
+			/// <param name="target">Target buffer.</param>
+			/// <param name="decodedLength">Decoded length in bytes.</param>
+			/// <returns>The decoded length in bytes, -1 if the encoded value is invalid.</returns>
+			int Decode( IntPtr source, int length, IntPtr target, int decodedLength );
+	};
+
+}
\ No newline at end of file
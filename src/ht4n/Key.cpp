@@ -23,6 +23,7 @@
 
 #include "Key.h"
 #include "CM2U8.h"
+#include "StringCache.h"
 
 #include "ht4c.Common/Cell.h"
 #include "ht4c.Common/KeyBuilder.h"
@@ -103,13 +104,27 @@ namespace Hypertable {
 	}
 
 	Key::Key( const Common::Cell& cell ) {
-		From( cell );
+		From( cell, nullptr );
+	}
+
+	Key::Key( const Common::Cell& cell, StringCache^ stringCache ) {
+		From( cell, stringCache );
 	}
 
 	void Key::From( const Common::Cell& cell ) {
+		From( cell, nullptr );
+	}
+
+	void Key::From( const Common::Cell& cell, StringCache^ stringCache ) {
 		Row = CM2U8::ToString( cell.row() );
-		ColumnFamily = CM2U8::ToString( cell.columnFamily() );
-		ColumnQualifier = cell.columnQualifier() ? CM2U8::ToString( cell.columnQualifier() ) : nullptr;
+		if( stringCache != nullptr ) {
+			ColumnFamily = stringCache->Get( cell.columnFamily() );
+			ColumnQualifier = cell.columnQualifier() ? stringCache->Get( cell.columnQualifier() ) : nullptr;
+		}
+		else {
+			ColumnFamily = CM2U8::ToString( cell.columnFamily() );
+			ColumnQualifier = cell.columnQualifier() ? CM2U8::ToString( cell.columnQualifier() ) : nullptr;
+		}
 		Timestamp = cell.timestamp();
 	}
 
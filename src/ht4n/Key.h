@@ -33,6 +33,8 @@ namespace Hypertable {
 	using namespace System;
 	using namespace ht4c;
 
+	ref class StringCache;
+
 	/// <summary>
 	/// Represents a Hypertable key, provide accessors to the key attributes.
 	/// </summary>
@@ -256,7 +258,9 @@ namespace Hypertable {
 		internal:
 
 			Key( const Common::Cell& cell );
+			Key( const Common::Cell& cell, StringCache^ stringCache );
 			void From( const Common::Cell& cell );
+			void From( const Common::Cell& cell, StringCache^ stringCache );
 
 		private:
 
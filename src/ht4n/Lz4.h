@@ -0,0 +1,231 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#pragma once
+
+#ifndef __cplusplus_cli
+#error "requires /clr"
+#endif
+
+#include <cstring>
+
+#pragma managed( push, off )
+
+namespace Hypertable {
+
+	/// <summary>
+	/// Native LZ4 block format compressor and decompressor.
+	/// </summary>
+	/// <remarks>
+	/// Single pass greedy compressor using a 4096 entries hash table, the output complies with the
+	/// LZ4 block format. The decompressor validates all offsets and lengths.
+	/// </remarks>
+	class Lz4 {
+
+		public:
+
+			/// <summary>
+			/// Returns the maximum compressed length.
+			/// </summary>
+			static int maxCompressedLength( int len ) {
+				return len + len / 255 + 16;
+			}
+
+			/// <summary>
+			/// Returns the maximum decompressed length for the compressed length specified, a length byte
+			/// extends a match by at most 255 bytes.
+			/// </summary>
+			static int64_t maxDecompressedLength( int len ) {
+				return static_cast<int64_t>( len ) * 255 + 16;
+			}
+
+			/// <summary>
+			/// Compresses the source buffer.
+			/// </summary>
+			/// <returns>The compressed length, zero if the compressed data do not fit into the target buffer.</returns>
+			static int compress( const uint8_t* src, int srcLen, uint8_t* dst, int dstCapacity ) {
+				int table[1 << hashLog];
+				memset( table, 0xff, sizeof(table) );
+
+				uint8_t* op = dst;
+				uint8_t* const oend = dst + dstCapacity;
+				int anchor = 0;
+				if( srcLen > minLength ) {
+					const int mflimit = srcLen - matchFindLimit;
+					const int matchLimit = srcLen - lastLiterals;
+					int ip = 0;
+					int searches = 0;
+					while( ip < mflimit ) {
+						uint32_t seq = read32( src + ip );
+						uint32_t h = hash( seq );
+						int ref = table[h];
+						table[h] = ip;
+						if( ref < 0 || ip - ref > maxOffset || read32(src + ref) != seq ) {
+							// skip faster through incompressible data
+							ip += 1 + (searches++ >> 6);
+							continue;
+						}
+						searches = 0;
+
+						int m = ip + minMatch;
+						int r = ref + minMatch;
+						while( m < matchLimit && src[m] == src[r] ) {
+							++m;
+							++r;
+						}
+
+						const int litLen = ip - anchor;
+						const int matchLen = m - ip - minMatch;
+						if( op + 1 + litLen / 255 + 1 + litLen + 2 + matchLen / 255 + 1 > oend ) {
+							return 0;
+						}
+						uint8_t* token = op++;
+						*token = 0;
+						op = writeLength( op, token, litLen, 4 );
+						memcpy( op, src + anchor, litLen );
+						op += litLen;
+						const int offset = ip - ref;
+						*op++ = static_cast<uint8_t>( offset );
+						*op++ = static_cast<uint8_t>( offset >> 8 );
+						op = writeLength( op, token, matchLen, 0 );
+
+						ip = anchor = m;
+						if( ip - 2 < mflimit ) {
+							table[hash(read32(src + ip - 2))] = ip - 2;
+						}
+					}
+				}
+
+				const int litLen = srcLen - anchor;
+				if( op + 1 + litLen / 255 + 1 + litLen > oend ) {
+					return 0;
+				}
+				uint8_t* token = op++;
+				*token = 0;
+				op = writeLength( op, token, litLen, 4 );
+				memcpy( op, src + anchor, litLen );
+				op += litLen;
+				return static_cast<int>( op - dst );
+			}
+
+			/// <summary>
+			/// Decompresses the source buffer.
+			/// </summary>
+			/// <returns>The decompressed length, -1 if the source buffer is malformed.</returns>
+			static int decompress( const uint8_t* src, int srcLen, uint8_t* dst, int dstLen ) {
+				const uint8_t* ip = src;
+				const uint8_t* const iend = src + srcLen;
+				uint8_t* op = dst;
+				uint8_t* const oend = dst + dstLen;
+				while( ip < iend ) {
+					const uint8_t token = *ip++;
+					size_t litLen = token >> 4;
+					if( !readLength(ip, iend, litLen) || litLen > static_cast<size_t>(iend - ip) || litLen > static_cast<size_t>(oend - op) ) {
+						return -1;
+					}
+					memcpy( op, ip, litLen );
+					ip += litLen;
+					op += litLen;
+					if( ip == iend ) {
+						break;
+					}
+
+					if( iend - ip < 2 ) {
+						return -1;
+					}
+					const size_t offset = ip[0] | (ip[1] << 8);
+					ip += 2;
+					if( !offset || offset > static_cast<size_t>(op - dst) ) {
+						return -1;
+					}
+					size_t matchLen = token & 0x0f;
+					if( !readLength(ip, iend, matchLen) ) {
+						return -1;
+					}
+					matchLen += minMatch;
+					if( matchLen > static_cast<size_t>(oend - op) ) {
+						return -1;
+					}
+					// matches may overlap the output
+					const uint8_t* match = op - offset;
+					for( size_t n = 0; n < matchLen; ++n ) {
+						op[n] = match[n];
+					}
+					op += matchLen;
+				}
+				return static_cast<int>( op - dst );
+			}
+
+		private:
+
+			enum {
+				hashLog = 12,
+				minMatch = 4,
+				lastLiterals = 5,
+				matchFindLimit = 12,
+				minLength = matchFindLimit + 1,
+				maxOffset = 65535
+			};
+
+			static uint32_t read32( const uint8_t* p ) {
+				uint32_t v;
+				memcpy( &v, p, sizeof(v) );
+				return v;
+			}
+
+			static uint32_t hash( uint32_t seq ) {
+				return (seq * 2654435761U) >> (32 - hashLog);
+			}
+
+			static uint8_t* writeLength( uint8_t* op, uint8_t* token, int len, int shift ) {
+				if( len >= 15 ) {
+					*token |= static_cast<uint8_t>( 15 << shift );
+					for( len -= 15; len >= 255; len -= 255 ) {
+						*op++ = 255;
+					}
+					*op++ = static_cast<uint8_t>( len );
+				}
+				else {
+					*token |= static_cast<uint8_t>( len << shift );
+				}
+				return op;
+			}
+
+			static bool readLength( const uint8_t*& ip, const uint8_t* iend, size_t& len ) {
+				if( len == 15 ) {
+					uint8_t b;
+					do {
+						if( ip == iend ) {
+							return false;
+						}
+						b = *ip++;
+						len += b;
+					}
+					while( b == 255 );
+				}
+				return true;
+			}
+	};
+
+}
+
+#pragma managed( pop )
\ No newline at end of file
@@ -0,0 +1,59 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#include "stdafx.h"
+
+#include "Lz4ValueCodec.h"
+#include "Lz4.h"
+
+namespace Hypertable {
+	using namespace System;
+
+	int Lz4ValueCodec::GetMaxEncodedLength( int length ) {
+		if( length < 0 ) throw gcnew ArgumentException( L"Invalid parameter length (< 0)", L"length" );
+		return Lz4::maxCompressedLength( length );
+	}
+
+	int Lz4ValueCodec::GetMaxDecodedLength( int length ) {
+		if( length < 0 ) throw gcnew ArgumentException( L"Invalid parameter length (< 0)", L"length" );
+		return static_cast<int>( Math::Min(Lz4::maxDecompressedLength(length), static_cast<Int64>(Int32::MaxValue)) );
+	}
+
+	int Lz4ValueCodec::Encode( IntPtr source, int length, IntPtr target, int capacity ) {
+		if( source == IntPtr::Zero ) throw gcnew ArgumentNullException( L"source" );
+		if( target == IntPtr::Zero ) throw gcnew ArgumentNullException( L"target" );
+		if( length <= 0 || capacity <= 0 ) {
+			return 0;
+		}
+		return Lz4::compress( static_cast<const uint8_t*>(source.ToPointer()), length, static_cast<uint8_t*>(target.ToPointer()), capacity );
+	}
+
+	int Lz4ValueCodec::Decode( IntPtr source, int length, IntPtr target, int decodedLength ) {
+		if( source == IntPtr::Zero ) throw gcnew ArgumentNullException( L"source" );
+		if( target == IntPtr::Zero ) throw gcnew ArgumentNullException( L"target" );
+		if( length <= 0 || decodedLength < 0 ) {
+			return -1;
+		}
+		return Lz4::decompress( static_cast<const uint8_t*>(source.ToPointer()), length, static_cast<uint8_t*>(target.ToPointer()), decodedLength );
+	}
+
+}
\ No newline at end of file
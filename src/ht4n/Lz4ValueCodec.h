@@ -0,0 +1,94 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#pragma once
+
+#ifndef __cplusplus_cli
+#error "requires /clr"
+#endif
+
+#include "IValueCodec.h"
+
+namespace Hypertable {
+	using namespace System;
+
+	/// <summary>
+	/// Represents the built-in LZ4 value codec.
+	/// </summary>
+	/// <remarks>
+	/// Fast block compression, suitable for large text based values like JSON or XML.
+	/// </remarks>
+	/// <example>
+	/// The following example shows how to compress the values of a column family.
+	/// <code>
+	/// var mutatorSpec = new MutatorSpec();
+	/// mutatorSpec.ValueCodecs = new Dictionary&lt;string, IValueCodec&gt; { { "cf", Lz4ValueCodec.Instance } };
+	/// using( var mutator = table.CreateMutator(mutatorSpec) ) {
+	///    // do something
+	/// }
+	/// var scanSpec = new ScanSpec();
+	/// scanSpec.ValueCodecs = mutatorSpec.ValueCodecs;
+	/// using( var scanner = table.CreateScanner(scanSpec) ) {
+	///    // do something
+	/// }
+	/// </code>
+	/// </example>
+	/// <seealso cref="IValueCodec"/>
+	[Serializable]
+	public ref class Lz4ValueCodec sealed : public IValueCodec {
+
+		public:
+
+			/// <summary>
+			/// Gets the LZ4 value codec instance.
+			/// </summary>
+			static property Lz4ValueCodec^ Instance {
+				Lz4ValueCodec^ get( ) {
+					return instance;
+				}
+			}
+
+			#pragma region IValueCodec properties
+
+			property Byte Id {
+				virtual Byte get( ) {
+					return 1;
+				}
+			}
+
+			#pragma endregion
+
+			#pragma region IValueCodec methods
+
+			virtual int GetMaxEncodedLength( int length );
+			virtual int GetMaxDecodedLength( int length );
+			virtual int Encode( IntPtr source, int length, IntPtr target, int capacity );
+			virtual int Decode( IntPtr source, int length, IntPtr target, int decodedLength );
+
+			#pragma endregion
+
+		private:
+
+			static initonly Lz4ValueCodec^ instance = gcnew Lz4ValueCodec();
+	};
+
+}
\ No newline at end of file
@@ -50,7 +50,12 @@ namespace Hypertable {
 		/// <summary>
 		/// Chunked mutator, flushes a chunk of cells if a certain limit has been reached.
 		/// </summary>
-		Chunked
+		Chunked,
+
+		/// <summary>
+		/// Striped mutator, each thread appends to its own chunk of cells, full chunks are passed to the native mutator without a shared lock.
+		/// </summary>
+		Striped
 	};
 
 }
@@ -22,6 +22,7 @@
 #include "stdafx.h"
 
 #include "MutatorSpec.h"
+#include "IValueCodec.h"
 
 namespace Hypertable {
 	using namespace System;
@@ -31,12 +32,24 @@ namespace Hypertable {
 	MutatorSpec::MutatorSpec( ) {
 		MaxChunkSize = MaxChunkSizeDefault;
 		MaxCellCount = MaxCellCountDefault;
+		MinChunkSize = MinChunkSizeDefault;
+		TargetChunkLatency = TimeSpan::FromMilliseconds( 50 );
+		MaxBufferedCells = MaxBufferedCellsDefault;
+		BatchSize = BatchSizeDefault;
+		Consumers = 1;
+		SpillThreshold = 64 * 1024;
 	}
 
 	MutatorSpec::MutatorSpec( Hypertable::MutatorKind mutatorKind ) {
 		MutatorKind = mutatorKind;
 		MaxChunkSize = MaxChunkSizeDefault;
 		MaxCellCount = MaxCellCountDefault;
+		MinChunkSize = MinChunkSizeDefault;
+		TargetChunkLatency = TimeSpan::FromMilliseconds( 50 );
+		MaxBufferedCells = MaxBufferedCellsDefault;
+		BatchSize = BatchSizeDefault;
+		Consumers = 1;
+		SpillThreshold = 64 * 1024;
 	}
 
 	MutatorSpec::MutatorSpec( MutatorSpec^ other ) {
@@ -47,9 +60,23 @@ namespace Hypertable {
 		FlushInterval = other->FlushInterval;
 		MaxChunkSize = other->MaxChunkSize;
 		MaxCellCount = other->MaxCellCount;
+		AdaptiveChunkSize = other->AdaptiveChunkSize;
+		MinChunkSize = other->MinChunkSize;
+		TargetChunkLatency = other->TargetChunkLatency;
 		FlushEachChunk = other->FlushEachChunk;
+		SortChunks = other->SortChunks;
+		Coalesce = other->Coalesce;
+		MaxBufferedCells = other->MaxBufferedCells;
 		Queued = other->Queued;
 		Capacity = other->Capacity;
+		BatchSize = other->BatchSize;
+		Consumers = other->Consumers;
+		MaxPendingBytes = other->MaxPendingBytes;
+		SpillPath = other->SpillPath;
+		SpillThreshold = other->SpillThreshold;
+		if( other->ValueCodecs != nullptr ) {
+			ValueCodecs = gcnew Dictionary<String^, IValueCodec^>( other->ValueCodecs );
+		}
 		Flags = other->Flags;
 	}
 
@@ -67,9 +94,21 @@ namespace Hypertable {
 		APPEND_TIMESPAN( FlushInterval )
 		APPEND_INT( MaxChunkSize )
 		APPEND_INT( MaxCellCount )
+		APPEND_BOOL( AdaptiveChunkSize )
+		APPEND_INT( MinChunkSize )
+		APPEND_TIMESPAN( TargetChunkLatency )
 		APPEND_BOOL( FlushEachChunk )
+		APPEND_BOOL( SortChunks )
+		APPEND_BOOL( Coalesce )
+		APPEND_INT( MaxBufferedCells )
 		APPEND_BOOL( Queued )
 		APPEND_INT( Capacity )
+		APPEND_INT( BatchSize )
+		APPEND_INT( Consumers )
+		APPEND_INT( MaxPendingBytes )
+		if( SpillPath != nullptr ) sb->Append( String::Format(CultureInfo::InvariantCulture, L"SpillPath={0}, ", SpillPath) );
+		APPEND_INT( SpillThreshold )
+		if( ValueCodecs != nullptr && ValueCodecs->Count > 0 ) sb->Append( String::Format(CultureInfo::InvariantCulture, L"ValueCodecs={0}, ", ValueCodecs->Count) );
 		sb->Append( String::Format(CultureInfo::InvariantCulture, L"Flags={0}", Flags) );
 		sb->Append( L")" );
 
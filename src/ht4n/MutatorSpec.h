@@ -33,6 +33,9 @@
 
 namespace Hypertable {
 	using namespace System;
+	using namespace System::Collections::Generic;
+
+	interface class IValueCodec;
 
 	/// <summary>
 	/// Represents a table mutator specification.
@@ -77,14 +80,14 @@ namespace Hypertable {
 			property TimeSpan FlushInterval;
 
 			/// <summary>
-			/// Gets or sets the maximum chunk size in bytes, only for chunked mutator.
+			/// Gets or sets the maximum chunk size in bytes, only for chunked and striped mutator.
 			/// </summary>
 			/// <remarks>Defaults to 64kB</remarks>
 			/// <seealso cref="MutatorKind"/>
 			property UInt32 MaxChunkSize;
 
 			/// <summary>
-			/// Gets or sets the default value for the maximum chunk size in bytes, only for chunked mutator.
+			/// Gets or sets the default value for the maximum chunk size in bytes, only for chunked and striped mutator.
 			/// </summary>
 			/// <remarks>Defaults to 64kB</remarks>
 			/// <seealso cref="MutatorKind"/>
@@ -94,14 +97,14 @@ namespace Hypertable {
 			}
 
 			/// <summary>
-			/// Gets or sets the maximum cell count for a chunk, only for chunked mutator.
+			/// Gets or sets the maximum cell count for a chunk, only for chunked and striped mutator.
 			/// </summary>
 			/// <remarks>Defaults to 4096</remarks>
 			/// <seealso cref="MutatorKind"/>
 			property UInt32 MaxCellCount;
 
 			/// <summary>
-			/// Gets or sets the default maximum cell count for a chunk, only for chunked mutator.
+			/// Gets or sets the default maximum cell count for a chunk, only for chunked and striped mutator.
 			/// </summary>
 			/// <remarks>Defaults to 4096</remarks>
 			/// <seealso cref="MutatorKind"/>
@@ -110,12 +113,95 @@ namespace Hypertable {
 				void set(UInt32 value) { maxCellCountDefault = value; }
 			}
 
+			/// <summary>
+			/// Gets or sets a value that indicates whether the chunk size should be adjusted to the observed latency, only for chunked mutator.
+			/// </summary>
+			/// <remarks>
+			/// If enabled, the effective chunk size is halved whenever passing a chunk to the native mutator
+			/// takes longer than TargetChunkLatency and otherwise grows by MinChunkSize, always within
+			/// MinChunkSize and MaxChunkSize. The maximum cell count is scaled accordingly. The current
+			/// effective chunk size is reported by MutatorStatistics.ChunkSize.
+			/// </remarks>
+			/// <seealso cref="MutatorKind"/>
+			/// <seealso cref="MutatorStatistics"/>
+			property bool AdaptiveChunkSize;
+
+			/// <summary>
+			/// Gets or sets the minimum chunk size in bytes, only for adaptive chunked mutator.
+			/// </summary>
+			/// <remarks>Defaults to 4kB</remarks>
+			/// <seealso cref="AdaptiveChunkSize"/>
+			property UInt32 MinChunkSize;
+
+			/// <summary>
+			/// Gets or sets the default value for the minimum chunk size in bytes, only for adaptive chunked mutator.
+			/// </summary>
+			/// <remarks>Defaults to 4kB</remarks>
+			/// <seealso cref="AdaptiveChunkSize"/>
+			static property UInt32 MinChunkSizeDefault { 
+				UInt32 get() { return minChunkSizeDefault; }
+				void set(UInt32 value) { minChunkSizeDefault = value; }
+			}
+
+			/// <summary>
+			/// Gets or sets the target latency for passing a chunk to the native mutator, only for adaptive chunked mutator.
+			/// </summary>
+			/// <remarks>Defaults to 50ms</remarks>
+			/// <seealso cref="AdaptiveChunkSize"/>
+			property TimeSpan TargetChunkLatency;
+
 			/// <summary>
 			/// Gets or sets a value that indicates whether each chunk should be flushed or not, only for chunked mutator.
 			/// </summary>
 			/// <seealso cref="MutatorKind"/>
 			property bool FlushEachChunk;
 
+			/// <summary>
+			/// Gets or sets a value that indicates whether each chunk should be sorted by row, column family and column qualifier
+			/// before passing it to the underlying mutator, only for chunked mutator.
+			/// </summary>
+			/// <remarks>
+			/// Sorting is stable, cells with the same key keep their order. Chunks containing delete cells are sorted
+			/// by row only, so that inserts and deletes of the same row are applied in the order they have been added.
+			/// </remarks>
+			/// <seealso cref="MutatorKind"/>
+			property bool SortChunks;
+
+			/// <summary>
+			/// Gets or sets a value that indicates whether redundant cell versions should be coalesced, only for chunked and queued mutator.
+			/// </summary>
+			/// <remarks>
+			/// If enabled, only the latest value of cells having the same row, column family and column qualifier and
+			/// an automatically assigned timestamp will be passed within a chunk or batch. Cells with an explicit timestamp
+			/// are never coalesced, delete cells are passed unchanged and no cell will be coalesced across a delete cell.
+			/// Cells of counter column families are never coalesced, each insert is an increment or decrement,
+			/// the counter column families are taken from the table schema when the mutator gets created.
+			/// The number of elided cells is reported by MutatorStatistics.ElidedCells.
+			/// </remarks>
+			/// <seealso cref="MutatorKind"/>
+			/// <seealso cref="MutatorStatistics"/>
+			property bool Coalesce;
+
+			/// <summary>
+			/// Gets or sets the maximum number of cells retained by the reusable cell buffer, only for default mutator.
+			/// </summary>
+			/// <remarks>
+			/// Defaults to 8192. The cell buffer used by ITableMutator.Set(IEnumerable&lt;Cell&gt;) will be released
+			/// after a batch exceeding this cell count or 4 MB, set to zero to disable cell buffer reuse.
+			/// </remarks>
+			/// <seealso cref="MutatorKind"/>
+			property UInt32 MaxBufferedCells;
+
+			/// <summary>
+			/// Gets or sets the default maximum number of cells retained by the reusable cell buffer, only for default mutator.
+			/// </summary>
+			/// <remarks>Defaults to 8192</remarks>
+			/// <seealso cref="MutatorKind"/>
+			static property UInt32 MaxBufferedCellsDefault { 
+				UInt32 get() { return maxBufferedCellsDefault; }
+				void set(UInt32 value) { maxBufferedCellsDefault = value; }
+			}
+
 			/// <summary>
 			/// Gets or sets a value that indicates whether to create a queued or synchronous mutator.
 			/// </summary>
@@ -127,6 +213,76 @@ namespace Hypertable {
 			/// <remarks>Set to zero (default value) for an unbounded blocking queue.</remarks>
 			property int Capacity;
 
+			/// <summary>
+			/// Gets or sets the maximum number of queued cells passed to the underlying mutator at once, only for queued mutator.
+			/// </summary>
+			/// <remarks>Defaults to 1024</remarks>
+			property int BatchSize;
+
+			/// <summary>
+			/// Gets or sets the default maximum number of queued cells passed to the underlying mutator at once, only for queued mutator.
+			/// </summary>
+			/// <remarks>Defaults to 1024</remarks>
+			static property int BatchSizeDefault { 
+				int get() { return batchSizeDefault; }
+				void set(int value) { batchSizeDefault = value; }
+			}
+
+			/// <summary>
+			/// Gets or sets the number of consumers, only for queued mutator.
+			/// </summary>
+			/// <remarks>
+			/// Defaults to 1. If greater than one, cells are partitioned by row key and each consumer
+			/// owns its own underlying mutator, the per-row order is preserved. The capacity will be
+			/// split across the consumers. Will be ignored for asynchronous mutators.
+			/// </remarks>
+			property int Consumers;
+
+			/// <summary>
+			/// Gets or sets the maximum number of bytes queued or buffered, only for queued and chunked mutator.
+			/// </summary>
+			/// <remarks>
+			/// Set to zero (default value) for an unlimited budget. Key and value sizes of pending cells are
+			/// taken into account, producers block while the budget is exceeded. The pending bytes and the
+			/// time spent blocked are reported by MutatorStatistics. For a queued chunked mutator the budget
+			/// applies to the queue.
+			/// </remarks>
+			/// <seealso cref="MutatorStatistics"/>
+			property Int64 MaxPendingBytes;
+
+			/// <summary>
+			/// Gets or sets the spill journal file path, only for queued mutator.
+			/// </summary>
+			/// <remarks>
+			/// Defaults to null, which disables spilling. Once the number of queued cells exceeds the spill threshold,
+			/// further cells are appended to the journal instead of blocking the producers or growing the queue. The
+			/// consumer replays the journal in order after having caught up, the journal will be truncated once the
+			/// replayed cells have been flushed. A journal left behind by a crashed process is replayed by the next
+			/// queued mutator using the same path, cells might therefore be written more than once. With more than one
+			/// consumer each consumer owns its own journal, the consumer index is appended to the path.
+			/// </remarks>
+			/// <seealso cref="SpillThreshold"/>
+			property String^ SpillPath;
+
+			/// <summary>
+			/// Gets or sets the number of queued cells beyond which cells are spilled to the journal, only for queued mutator.
+			/// </summary>
+			/// <remarks>Defaults to 65536, should be less than the capacity. The threshold will be split across the consumers.</remarks>
+			/// <seealso cref="SpillPath"/>
+			property int SpillThreshold;
+
+			/// <summary>
+			/// Gets or sets the value codecs by column family, values of other column families are written verbatim.
+			/// </summary>
+			/// <remarks>
+			/// Values are encoded by the default, chunked and striped mutator before passing them to the native mutator.
+			/// Small values and values which do not shrink are written verbatim. Use ScanSpec.ValueCodecs to decode
+			/// the values on read.
+			/// </remarks>
+			/// <seealso cref="IValueCodec"/>
+			/// <seealso cref="Lz4ValueCodec"/>
+			property IDictionary<String^, IValueCodec^>^ ValueCodecs;
+
 			/// <summary>
 			/// Gets or sets the table mutator flags.
 			/// </summary>
@@ -184,6 +340,9 @@ namespace Hypertable {
 
 			static UInt32 maxChunkSizeDefault = 64 * 1024;
 			static UInt32 maxCellCountDefault =  4 * 1024;
+			static UInt32 minChunkSizeDefault =  4 * 1024;
+			static UInt32 maxBufferedCellsDefault = 8 * 1024;
+			static int batchSizeDefault = 1024;
 	};
 
 }
@@ -0,0 +1,110 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#include "stdafx.h"
+
+#include "MutatorStatistics.h"
+
+namespace Hypertable {
+	using namespace System;
+	using namespace System::Text;
+	using namespace System::Threading;
+	using namespace System::Globalization;
+
+	String^ MutatorStatistics::ToString() {
+
+		#define APPEND_INT( what ) if( what > 0 ) sb->Append( String::Format(CultureInfo::InvariantCulture, L#what L"={0}, ", what) );
+
+		StringBuilder^ sb = gcnew StringBuilder();
+		sb->Append( GetType() );
+		sb->Append( L"(" );
+
+		APPEND_INT( QueueDepth )
+		APPEND_INT( Batches )
+		APPEND_INT( BatchedCells )
+		APPEND_INT( MaxBatchSize )
+		APPEND_INT( Chunks )
+		APPEND_INT( ChunkSize )
+		APPEND_INT( BytesPerSecond )
+		APPEND_INT( PendingBytes )
+		if( BlockedTime.Ticks > 0 ) sb->Append( String::Format(CultureInfo::InvariantCulture, L"BlockedTime={0}, ", BlockedTime) );
+		APPEND_INT( ElidedCells )
+		APPEND_INT( CellBuffers )
+		if( sb[sb->Length - 1] == L' ' ) {
+			sb->Length -= 2;
+		}
+		sb->Append( L")" );
+
+		return sb->ToString();
+
+		#undef APPEND_INT
+	}
+
+	MutatorStatistics::MutatorStatistics( )
+	: queueDepth( 0 )
+	, batches( 0 )
+	, batchedCells( 0 )
+	, maxBatchSize( 0 )
+	, chunks( 0 )
+	, chunkSize( 0 )
+	, bytesPerSecond( 0 )
+	, pendingBytes( 0 )
+	, blockedTicks( 0 )
+	, elidedCells( 0 )
+	, cellBuffers( 0 )
+	{
+	}
+
+	void MutatorStatistics::AddQueued( int count ) {
+		Interlocked::Add( queueDepth, count );
+	}
+
+	void MutatorStatistics::AddBatch( int count ) {
+		Interlocked::Increment( batches );
+		Interlocked::Add( batchedCells, count );
+		int max;
+		while( (max = maxBatchSize) < count && Interlocked::CompareExchange(maxBatchSize, count, max) != max );
+	}
+
+	void MutatorStatistics::AddChunk( UInt32 _chunkSize, double _bytesPerSecond ) {
+		Interlocked::Increment( chunks );
+		chunkSize = _chunkSize;
+		bytesPerSecond = _bytesPerSecond;
+	}
+
+	void MutatorStatistics::AddPending( Int64 bytes ) {
+		Interlocked::Add( pendingBytes, bytes );
+	}
+
+	void MutatorStatistics::AddBlocked( Int64 elapsedTicks ) {
+		Interlocked::Add( blockedTicks, elapsedTicks );
+	}
+
+	void MutatorStatistics::AddElided( int count ) {
+		Interlocked::Add( elidedCells, count );
+	}
+
+	void MutatorStatistics::AddCellBuffer( ) {
+		Interlocked::Increment( cellBuffers );
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,200 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#pragma once
+
+#ifndef __cplusplus_cli
+#error "requires /clr"
+#endif
+
+namespace Hypertable {
+	using namespace System;
+
+	/// <summary>
+	/// Represents table mutator statistics.
+	/// </summary>
+	/// <remarks>
+	/// The statistics are updated while the mutator is in use, the values reflect the
+	/// current state. Values which are not applicable to the mutator kind remain zero.
+	/// </remarks>
+	/// <example>
+	/// The following example shows how to monitor a queued mutator.
+	/// <code>
+	/// using( var mutator = table.CreateMutator(MutatorSpec.CreateQueued()) ) {
+	///    // do something
+	///    Trace.WriteLine( mutator.Statistics );
+	/// }
+	/// </code>
+	/// </example>
+	/// <seealso cref="ITableMutator"/>
+	public ref class MutatorStatistics sealed {
+
+		public:
+
+			/// <summary>
+			/// Gets the number of cells queued but not yet passed to the underlying mutator, only for queued mutator.
+			/// </summary>
+			property Int64 QueueDepth {
+				Int64 get( ) {
+					return Threading::Interlocked::Read( queueDepth );
+				}
+			}
+
+			/// <summary>
+			/// Gets the number of batches passed to the underlying mutator, only for queued mutator.
+			/// </summary>
+			property Int64 Batches {
+				Int64 get( ) {
+					return Threading::Interlocked::Read( batches );
+				}
+			}
+
+			/// <summary>
+			/// Gets the number of cells passed to the underlying mutator in batches, only for queued mutator.
+			/// </summary>
+			property Int64 BatchedCells {
+				Int64 get( ) {
+					return Threading::Interlocked::Read( batchedCells );
+				}
+			}
+
+			/// <summary>
+			/// Gets the maximum batch size, only for queued mutator.
+			/// </summary>
+			property int MaxBatchSize {
+				int get( ) {
+					return maxBatchSize;
+				}
+			}
+
+			/// <summary>
+			/// Gets the average batch size, only for queued mutator.
+			/// </summary>
+			property double AverageBatchSize {
+				double get( ) {
+					Int64 n = Batches;
+					return n > 0 ? static_cast<double>( BatchedCells ) / n : 0.0;
+				}
+			}
+
+			/// <summary>
+			/// Gets the number of chunks passed to the native mutator, only for chunked and striped mutators.
+			/// </summary>
+			property Int64 Chunks {
+				Int64 get( ) {
+					return Threading::Interlocked::Read( chunks );
+				}
+			}
+
+			/// <summary>
+			/// Gets the current effective maximum chunk size in bytes, only for chunked and striped mutators.
+			/// </summary>
+			/// <seealso cref="MutatorSpec.AdaptiveChunkSize"/>
+			property UInt32 ChunkSize {
+				UInt32 get( ) {
+					return chunkSize;
+				}
+			}
+
+			/// <summary>
+			/// Gets the throughput in bytes per second observed for the most recent chunk, only for chunked and striped mutators.
+			/// </summary>
+			property double BytesPerSecond {
+				double get( ) {
+					return bytesPerSecond;
+				}
+			}
+
+			/// <summary>
+			/// Gets the number of bytes queued or buffered but not yet passed to the native mutator, only if a pending bytes budget has been specified.
+			/// </summary>
+			/// <seealso cref="MutatorSpec.MaxPendingBytes"/>
+			property Int64 PendingBytes {
+				Int64 get( ) {
+					return Threading::Interlocked::Read( pendingBytes );
+				}
+			}
+
+			/// <summary>
+			/// Gets the total time producers have been blocked because of exceeding the pending bytes budget.
+			/// </summary>
+			/// <seealso cref="MutatorSpec.MaxPendingBytes"/>
+			property TimeSpan BlockedTime {
+				TimeSpan get( ) {
+					return TimeSpan::FromTicks( static_cast<Int64>(Threading::Interlocked::Read(blockedTicks) * (static_cast<double>(TimeSpan::TicksPerSecond) / Diagnostics::Stopwatch::Frequency)) );
+				}
+			}
+
+			/// <summary>
+			/// Gets the number of cells elided by coalescing, only if coalescing has been enabled.
+			/// </summary>
+			/// <seealso cref="MutatorSpec.Coalesce"/>
+			property Int64 ElidedCells {
+				Int64 get( ) {
+					return Threading::Interlocked::Read( elidedCells );
+				}
+			}
+
+			/// <summary>
+			/// Gets the number of native cell buffers created for batches, only for default mutator.
+			/// </summary>
+			/// <seealso cref="MutatorSpec.MaxBufferedCells"/>
+			property Int64 CellBuffers {
+				Int64 get( ) {
+					return Threading::Interlocked::Read( cellBuffers );
+				}
+			}
+
+			/// <summary>
+			/// Returns a string that represents the current object.
+			/// </summary>
+			/// <returns>A string that represents the current object.</returns>
+			virtual String^ ToString() override;
+
+		internal:
+
+			MutatorStatistics( );
+
+			void AddQueued( int count );
+			void AddBatch( int count );
+			void AddChunk( UInt32 chunkSize, double bytesPerSecond );
+			void AddPending( Int64 bytes );
+			void AddBlocked( Int64 elapsedTicks );
+			void AddElided( int count );
+			void AddCellBuffer( );
+
+		private:
+
+			Int64 queueDepth;
+			Int64 batches;
+			Int64 batchedCells;
+			int maxBatchSize;
+			Int64 chunks;
+			UInt32 chunkSize;
+			double bytesPerSecond;
+			Int64 pendingBytes;
+			Int64 blockedTicks;
+			Int64 elidedCells;
+			Int64 cellBuffers;
+	};
+
+}
\ No newline at end of file
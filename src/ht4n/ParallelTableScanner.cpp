@@ -0,0 +1,805 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#include "stdafx.h"
+
+#include "ParallelTableScanner.h"
+#include "Table.h"
+#include "Key.h"
+#include "Cell.h"
+#include "BufferedCell.h"
+#include "PooledCell.h"
+#include "ScanBlock.h"
+#include "CellView.h"
+#include "ScanSpec.h"
+#include "RowInterval.h"
+#include "CellInterval.h"
+#include "StringCache.h"
+#include "ScannerStatistics.h"
+#include "ValueCodecMap.h"
+#include "IValueCodec.h"
+#include "HypertableEventSource.h"
+#include "Logging.h"
+#include "Exception.h"
+
+#include "ht4c.Common/TableScanner.h"
+#include "ht4c.Common/Cells.h"
+#include "ht4c.Common/Cell.h"
+
+#pragma managed( push, off )
+
+namespace {
+
+	/// <summary>
+	/// Reads the cells of a native table scanner chunk by chunk.
+	/// </summary>
+	class ChunkReader {
+
+		public:
+
+			explicit ChunkReader( ht4c::Common::TableScanner* _scanner )
+			: scanner( _scanner )
+			{
+			}
+
+			~ChunkReader( ) {
+				delete scanner;
+			}
+
+			bool read( ht4c::Common::Cells& chunk, size_t maxCells, size_t maxBytes ) {
+				ht4c::Common::Cell* cell;
+				size_t bytes = 0;
+				while( chunk.size() < maxCells && bytes < maxBytes && scanner->next(cell) ) {
+					chunk.add( cell->row(), cell->columnFamily(), cell->columnQualifier(), cell->timestamp(), cell->value(), cell->valueLength(), cell->flag() );
+					bytes += cell->valueLength() + 32;
+				}
+				return chunk.size() > 0;
+			}
+
+		private:
+
+			ht4c::Common::TableScanner* scanner;
+	};
+
+}
+
+#pragma managed( pop )
+
+namespace Hypertable {
+	using namespace System;
+	using namespace System::Buffers;
+	using namespace System::Diagnostics;
+	using namespace System::Globalization;
+	using namespace ht4c;
+
+	ref class ParallelTableScannerEnumerator sealed : public IEnumerator<Cell^> {
+
+		public:
+
+			virtual ~ParallelTableScannerEnumerator( ) {
+			}
+
+			virtual property Cell^ generic_Current {
+				Cell^ get( ) = IEnumerator<Cell^>::Current::get {
+					return cell;
+				}
+			}
+
+			virtual property Object^ Current {
+				Object^ get( ) = System::Collections::IEnumerator::Current::get {
+					return generic_Current;
+				}
+			}
+
+			virtual bool MoveNext( ) {
+				return tableScanner->MoveNext( cell );
+			}
+
+			virtual void Reset( ) {
+				throw gcnew InvalidOperationException(L"Unable to reset table scanner enumerator");
+			}
+
+		internal:
+
+			ParallelTableScannerEnumerator( ParallelTableScanner^ _tableScanner ) 
+			: tableScanner( _tableScanner ) {
+			}
+
+		private:
+
+			ParallelTableScanner^ tableScanner;
+			Cell^ cell;
+	};
+
+	ParallelTableScanner::~ParallelTableScanner( ) {
+		{
+			msclr::lock sync( syncRoot );
+			if( disposed ) {
+				return;
+			}
+			disposed = true;
+		}
+		cts->Cancel();
+		try {
+			Task::WaitAll( tasks );
+		}
+		catch( AggregateException^ ) {
+		}
+		GC::SuppressFinalize(this);
+		this->!ParallelTableScanner();
+	}
+
+	ParallelTableScanner::!ParallelTableScanner( ) {
+		HT4N_TRY {
+			if( current ) {
+				delete current;
+				current = 0;
+			}
+			if( queues != nullptr ) {
+				Chunk queued;
+				for each( BlockingCollection<Chunk>^ q in queues ) {
+					while( q->TryTake(queued) ) {
+						delete static_cast<Common::Cells*>( queued.cells.ToPointer() );
+					}
+				}
+				queues = nullptr;
+			}
+			IntPtr pooled;
+			while( chunkPool->TryDequeue(pooled) ) {
+				delete static_cast<Common::Cells*>( pooled.ToPointer() );
+			}
+			if( nativeCell ) {
+				delete nativeCell;
+				nativeCell = 0;
+				HypertableEventSource::ScannerClosed();
+			}
+		}
+		HT4N_RETHROW
+	}
+
+	bool ParallelTableScanner::Move( Cell^ cell ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		if( cell == nullptr ) throw gcnew ArgumentNullException( L"cell" );
+		HT4N_TRY {
+			msclr::lock sync( syncRoot );
+			if( NextCell() ) {
+				cell->From( *nativeCell, stringCache, valueCodecs );
+				HypertableEventSource::Scanned( *nativeCell );
+				return true;
+			}
+			return false;
+		}
+		HT4N_RETHROW
+	}
+
+	bool ParallelTableScanner::Move( BufferedCell^ cell ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		if( cell == nullptr ) throw gcnew ArgumentNullException( L"cell" );
+		HT4N_TRY {
+			msclr::lock sync( syncRoot );
+			if( NextCell() ) {
+				cell->From( *nativeCell, stringCache, valueCodecs );
+				HypertableEventSource::Scanned( *nativeCell );
+				return true;
+			}
+			return false;
+		}
+		HT4N_RETHROW
+	}
+
+	bool ParallelTableScanner::Move( PooledCell^ cell ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		if( cell == nullptr ) throw gcnew ArgumentNullException( L"cell" );
+		HT4N_TRY {
+			msclr::lock sync( syncRoot );
+			if( NextCell() ) {
+				cell->From( *nativeCell, stringCache, valueCodecs );
+				HypertableEventSource::Scanned( *nativeCell );
+				return true;
+			}
+			return false;
+		}
+		HT4N_RETHROW
+	}
+
+	bool ParallelTableScanner::MoveBatch( cli::array<BufferedCell^>^ cells, int% count ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		if( cells == nullptr ) throw gcnew ArgumentNullException( L"cells" );
+		count = 0;
+		HT4N_TRY {
+			int n = 0;
+			msclr::lock sync( syncRoot );
+			for( ; n < cells->Length && NextCell(); ++n ) {
+				BufferedCell^ cell = cells[n];
+				if( cell == nullptr ) {
+					cells[n] = cell = gcnew BufferedCell( 0 );
+				}
+				cell->From( *nativeCell, stringCache, valueCodecs );
+				HypertableEventSource::Scanned( *nativeCell );
+			}
+			count = n;
+			return n > 0;
+		}
+		HT4N_RETHROW
+	}
+
+	bool ParallelTableScanner::Move( ScanBlock^ block ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		if( block == nullptr ) throw gcnew ArgumentNullException( L"block" );
+		block->Clear();
+		HT4N_TRY {
+			msclr::lock sync( syncRoot );
+			while( !block->IsFull && NextCell() ) {
+				block->Add( *nativeCell );
+				HypertableEventSource::Scanned( *nativeCell );
+			}
+			return block->Count > 0;
+		}
+		HT4N_RETHROW
+	}
+
+	bool ParallelTableScanner::Next( Cell^% cell ) {
+		return MoveNext( cell );
+	}
+
+	bool ParallelTableScanner::Next( Func<Key^, IntPtr, int, bool>^ action ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		if( action == nullptr ) throw gcnew ArgumentNullException( L"action" );
+		HT4N_TRY {
+			msclr::lock sync( syncRoot );
+			if( NextCell() ) {
+				HypertableEventSource::Scanned( *nativeCell );
+				Key^ key = gcnew Key( *nativeCell, stringCache );
+				int length = static_cast<int>( nativeCell->valueLength() );
+				int decodedLength;
+				IValueCodec^ codec = valueCodecs != nullptr && length > 0 ? valueCodecs->GetEncoded( key->ColumnFamily, nativeCell->value(), length, decodedLength ) : nullptr;
+				if( codec != nullptr ) {
+					// decode into a pooled buffer, the value pointer is only valid during the action
+					cli::array<Byte>^ buffer = ArrayPool<Byte>::Shared->Rent( decodedLength );
+					try {
+						pin_ptr<Byte> pb = &buffer[0];
+						ValueCodecMap::Decode( codec, nativeCell->value(), length, pb, decodedLength );
+						return action( key, IntPtr(pb), decodedLength );
+					}
+					finally {
+						ArrayPool<Byte>::Shared->Return( buffer );
+					}
+				}
+				return action( key, IntPtr(const_cast<Common::uint8_t*>(nativeCell->value())), length );
+			}
+			return false;
+		}
+		HT4N_RETHROW
+	}
+
+	bool ParallelTableScanner::Visit( CellVisitor^ visitor ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		if( visitor == nullptr ) throw gcnew ArgumentNullException( L"visitor" );
+		cli::array<Byte>^ buffer = nullptr;
+		HT4N_TRY {
+			msclr::lock sync( syncRoot );
+			if( NextCell() ) {
+				HypertableEventSource::Scanned( *nativeCell );
+				return Visit( *nativeCell, visitor, buffer );
+			}
+			return false;
+		}
+		HT4N_RETHROW
+		finally {
+			if( buffer != nullptr ) {
+				ArrayPool<Byte>::Shared->Return( buffer );
+			}
+		}
+	}
+
+	bool ParallelTableScanner::VisitBatch( CellVisitor^ visitor, int maxCount, int% count ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		if( visitor == nullptr ) throw gcnew ArgumentNullException( L"visitor" );
+		if( maxCount <= 0 ) throw gcnew ArgumentException( L"Invalid parameter maxCount (maxCount must be greater than zero)", L"maxCount" );
+		count = 0;
+		cli::array<Byte>^ buffer = nullptr;
+		HT4N_TRY {
+			int n = 0;
+			bool more = true;
+			msclr::lock sync( syncRoot );
+			while( n < maxCount && (more = NextCell()) ) {
+				HypertableEventSource::Scanned( *nativeCell );
+				++n;
+				if( !Visit(*nativeCell, visitor, buffer) ) {
+					more = false;
+					break;
+				}
+			}
+			count = n;
+			return more;
+		}
+		HT4N_RETHROW
+		finally {
+			if( buffer != nullptr ) {
+				ArrayPool<Byte>::Shared->Return( buffer );
+			}
+		}
+	}
+
+	IEnumerator<Cell^>^ ParallelTableScanner::generic_GetEnumerator( ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		return gcnew ParallelTableScannerEnumerator( this );
+	}
+
+	ParallelTableScanner::ParallelTableScanner( Table^ _table, Hypertable::ScanSpec^ _scanSpec, int degree, bool _ordered )
+	: table( _table )
+	, scanSpec( _scanSpec )
+	, chunkPool( gcnew ConcurrentQueue<IntPtr>() )
+	, cts( gcnew CancellationTokenSource() )
+	, stringCache( nullptr )
+	, columnFamilyCache( nullptr )
+	, syncRoot( gcnew Object() )
+	, current( 0 )
+	, nativeCell( 0 )
+	, index( 0 )
+	, queue( 0 )
+	, nextPartition( 0 )
+	, ordered( _ordered )
+	, finished( false )
+	, disposed( false )
+	{
+		if( table == nullptr ) throw gcnew ArgumentNullException( L"table" );
+		if( degree <= 0 ) throw gcnew ArgumentException( L"Invalid parameter degree (degree must be greater than zero)", L"degree" );
+
+		// MaxRows and MaxCells apply to each row/cell interval, the partitions are split along the intervals
+		// and keep the limits, so the native scanners enforce them
+		partitions = Partition( table, scanSpec, degree );
+		if( degree > 1 && partitions->Length == 1 ) {
+			Logging::TraceEvent( TraceEventType::Warning, String::Format(CultureInfo::InvariantCulture, L"Parallel scan on table '{0}' of degree {1} has not been split, single partition", table->Name, degree) );
+		}
+		const int workers = Math::Min( degree, partitions->Length );
+		if( ordered ) {
+			// one queue per partition, the partitions are delivered in row order
+			queues = gcnew cli::array<BlockingCollection<Chunk>^>( partitions->Length );
+			for( int n = 0; n < queues->Length; ++n ) {
+				queues[n] = gcnew BlockingCollection<Chunk>( queuedChunks );
+			}
+		}
+		else {
+			queues = gcnew cli::array<BlockingCollection<Chunk>^>( 1 );
+			queues[0] = gcnew BlockingCollection<Chunk>( queuedChunks * workers );
+		}
+		statistics = gcnew ScannerStatistics( queuedChunks * workers );
+		statistics->SetPartitions( partitions->Length );
+		if( scanSpec != nullptr && (scanSpec->Flags & ScannerFlags::InternStrings) == ScannerFlags::InternStrings ) {
+			stringCache = gcnew StringCache();
+		}
+		if( scanSpec != nullptr ) {
+			valueCodecs = ValueCodecMap::Create( scanSpec->ValueCodecs );
+		}
+		HT4N_TRY {
+			nativeCell = Common::Cell::create();
+		}
+		HT4N_RETHROW
+		HypertableEventSource::ScannerOpened();
+
+		activeWorkers = workers;
+		tasks = gcnew cli::array<Task^>( workers );
+		for( int n = 0; n < workers; ++n ) {
+			tasks[n] = Task::Factory->StartNew( gcnew Action(this, &ParallelTableScanner::Scan), TaskCreationOptions::LongRunning );
+		}
+	}
+
+	bool ParallelTableScanner::MoveNext( Cell^% cell ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		HT4N_TRY {
+			msclr::lock sync( syncRoot );
+			if( NextCell() ) {
+				cell = gcnew Cell();
+				cell->From( *nativeCell, stringCache, valueCodecs );
+				HypertableEventSource::Scanned( *nativeCell );
+				return true;
+			}
+			cell = nullptr;
+			return false;
+		}
+		HT4N_RETHROW
+	}
+
+	cli::array<Hypertable::ScanSpec^>^ ParallelTableScanner::Partition( Table^ table, Hypertable::ScanSpec^ scanSpec, int degree ) {
+		if( scanSpec == nullptr ) {
+			scanSpec = gcnew Hypertable::ScanSpec();
+		}
+
+		// a scan without row predicates or with a single row interval gets split at sampled rows, the range
+		// boundaries are not exposed; MaxRows and MaxCells apply to the whole interval and prevent the split
+		if( degree > 1
+		 && scanSpec->RowCount == 0 && scanSpec->CellCount == 0 && scanSpec->CellIntervalCount == 0 && scanSpec->RowIntervalCount <= 1
+		 && scanSpec->MaxRows == 0 && scanSpec->MaxCells == 0 && scanSpec->RowOffset == 0 && scanSpec->CellOffset == 0 ) {
+			RowInterval^ interval = scanSpec->RowIntervalCount == 1 ? scanSpec->RowIntervals[0] : gcnew RowInterval( nullptr, nullptr );
+			List<String^>^ splitRows = SampleSplitRows( table, scanSpec, interval, degree );
+			if( splitRows->Count > 0 ) {
+				cli::array<Hypertable::ScanSpec^>^ result = gcnew cli::array<Hypertable::ScanSpec^>( splitRows->Count + 1 );
+				result[0] = scanSpec->CopyWithoutRows()->AddRowInterval( gcnew RowInterval(interval->StartRow, interval->IncludeStartRow, splitRows[0], false) );
+				for( int n = 1; n < splitRows->Count; ++n ) {
+					result[n] = scanSpec->CopyWithoutRows()->AddRowInterval( gcnew RowInterval(splitRows[n - 1], true, splitRows[n], false) );
+				}
+				result[splitRows->Count] = scanSpec->CopyWithoutRows()->AddRowInterval( gcnew RowInterval(splitRows[splitRows->Count - 1], true, interval->EndRow, interval->IncludeEndRow) );
+				return result;
+			}
+		}
+
+		// offsets cannot be applied across partitions, mixed row predicates are not split
+		const int kinds = (scanSpec->RowCount > 0 ? 1 : 0)
+										+ (scanSpec->CellCount > 0 ? 1 : 0)
+										+ (scanSpec->RowIntervalCount > 0 ? 1 : 0)
+										+ (scanSpec->CellIntervalCount > 0 ? 1 : 0);
+		if( degree <= 1 || kinds != 1 || scanSpec->RowOffset > 0 || scanSpec->CellOffset > 0 ) {
+			return gcnew cli::array<Hypertable::ScanSpec^>{ scanSpec };
+		}
+
+		List<Hypertable::ScanSpec^>^ result = gcnew List<Hypertable::ScanSpec^>();
+		if( scanSpec->RowCount > 0 ) {
+			cli::array<String^>^ rows = gcnew cli::array<String^>( scanSpec->RowCount );
+			scanSpec->Rows->CopyTo( rows, 0 );
+			Array::Sort( rows, StringComparer::Ordinal );
+			List<String^>^ items = gcnew List<String^>( rows );
+			List<int>^ starts = Split( rows, degree );
+			for( int n = 0; n < starts->Count - 1; ++n ) {
+				result->Add( scanSpec->CopyWithoutRows()->AddRow(items->GetRange(starts[n], starts[n + 1] - starts[n])) );
+			}
+		}
+		else if( scanSpec->CellCount > 0 ) {
+			cli::array<Key^>^ keys = gcnew cli::array<Key^>( scanSpec->CellCount );
+			scanSpec->Cells->CopyTo( keys, 0 );
+			cli::array<String^>^ rows = gcnew cli::array<String^>( keys->Length );
+			for( int n = 0; n < keys->Length; ++n ) {
+				rows[n] = keys[n]->Row;
+			}
+			Array::Sort<String^, Key^>( rows, keys, StringComparer::Ordinal );
+			List<Key^>^ items = gcnew List<Key^>( keys );
+			List<int>^ starts = Split( rows, degree );
+			for( int n = 0; n < starts->Count - 1; ++n ) {
+				result->Add( scanSpec->CopyWithoutRows()->AddCell(items->GetRange(starts[n], starts[n + 1] - starts[n])) );
+			}
+		}
+		else if( scanSpec->RowIntervalCount > 0 ) {
+			cli::array<RowInterval^>^ rowIntervals = gcnew cli::array<RowInterval^>( scanSpec->RowIntervalCount );
+			scanSpec->RowIntervals->CopyTo( rowIntervals, 0 );
+			cli::array<String^>^ rows = gcnew cli::array<String^>( rowIntervals->Length );
+			for( int n = 0; n < rowIntervals->Length; ++n ) {
+				rows[n] = rowIntervals[n]->StartRow;
+			}
+			Array::Sort<String^, RowInterval^>( rows, rowIntervals, StringComparer::Ordinal );
+			List<RowInterval^>^ items = gcnew List<RowInterval^>( rowIntervals );
+			List<int>^ starts = Split( rows, degree );
+			for( int n = 0; n < starts->Count - 1; ++n ) {
+				result->Add( scanSpec->CopyWithoutRows()->AddRowInterval(items->GetRange(starts[n], starts[n + 1] - starts[n])) );
+			}
+		}
+		else {
+			cli::array<CellInterval^>^ cellIntervals = gcnew cli::array<CellInterval^>( scanSpec->CellIntervalCount );
+			scanSpec->CellIntervals->CopyTo( cellIntervals, 0 );
+			cli::array<String^>^ rows = gcnew cli::array<String^>( cellIntervals->Length );
+			for( int n = 0; n < cellIntervals->Length; ++n ) {
+				rows[n] = cellIntervals[n]->StartRow;
+			}
+			Array::Sort<String^, CellInterval^>( rows, cellIntervals, StringComparer::Ordinal );
+			List<CellInterval^>^ items = gcnew List<CellInterval^>( cellIntervals );
+			List<int>^ starts = Split( rows, degree );
+			for( int n = 0; n < starts->Count - 1; ++n ) {
+				result->Add( scanSpec->CopyWithoutRows()->AddCellInterval(items->GetRange(starts[n], starts[n + 1] - starts[n])) );
+			}
+		}
+		return result->ToArray();
+	}
+
+	void ParallelTableScanner::Scan( ) {
+		try {
+			for( int partition = Interlocked::Increment(nextPartition) - 1; partition < partitions->Length && !cts->IsCancellationRequested; partition = Interlocked::Increment(nextPartition) - 1 ) {
+				ScanPartition( partition );
+			}
+		}
+		catch( OperationCanceledException^ ) {
+		}
+		catch( Exception^ e ) {
+			Fail( e );
+		}
+		finally {
+			if( Interlocked::Decrement(activeWorkers) == 0 ) {
+				// the partitions not scanned yet will never be completed otherwise
+				for each( BlockingCollection<Chunk>^ q in queues ) {
+					q->CompleteAdding();
+				}
+			}
+		}
+	}
+
+	void ParallelTableScanner::ScanPartition( int partition ) {
+		BlockingCollection<Chunk>^ target = queues[ordered ? partition : 0];
+		ChunkReader* reader = 0;
+		Common::Cells* cells = 0;
+		try {
+			reader = new ChunkReader( table->CreateTableScanner(partitions[partition]) );
+			HT4N_TRY {
+				for( ;; ) {
+					cells = RentChunk();
+					if( !reader->read(*cells, maxChunkCells, maxChunkBytes) ) {
+						break;
+					}
+					Chunk scanned;
+					scanned.cells = IntPtr( cells );
+					scanned.partition = partition;
+					statistics->AddChunk( static_cast<int>(cells->size()) );
+					try {
+						target->Add( scanned, cts->Token );
+					}
+					catch( OperationCanceledException^ ) {
+						statistics->RemoveChunk();
+						throw;
+					}
+					cells = 0;
+				}
+			}
+			HT4N_RETHROW
+		}
+		finally {
+			if( cells ) {
+				ReleaseChunk( cells );
+			}
+			if( reader ) {
+				delete reader;
+			}
+			if( ordered ) {
+				target->CompleteAdding();
+			}
+		}
+	}
+
+	bool ParallelTableScanner::NextCell( ) {
+		for( ;; ) {
+			if( finished ) {
+				return false;
+			}
+			if( current ) {
+				if( index < current->size() ) {
+					current->get_unchecked( index, nativeCell );
+					++index;
+					return true;
+				}
+				ReleaseChunk( current );
+				current = 0;
+			}
+			if( !TakeChunk() ) {
+				finished = true;
+				return false;
+			}
+			current = static_cast<Common::Cells*>( chunk.cells.ToPointer() );
+			index = 0;
+		}
+	}
+
+	bool ParallelTableScanner::TakeChunk( ) {
+		try {
+			while( queue < queues->Length ) {
+				BlockingCollection<Chunk>^ q = queues[queue];
+				if( !q->TryTake(chunk) ) {
+					if( q->IsCompleted ) {
+						++queue;
+						continue;
+					}
+					// the consumer is faster than the workers
+					Int64 started = Stopwatch::GetTimestamp();
+					bool taken = q->TryTake( chunk, Timeout::Infinite, cts->Token );
+					statistics->AddStall( Stopwatch::GetTimestamp() - started );
+					if( !taken ) {
+						++queue;
+						continue;
+					}
+				}
+				statistics->RemoveChunk();
+				return true;
+			}
+		}
+		catch( OperationCanceledException^ ) {
+		}
+		if( innerException != nullptr ) {
+			throw gcnew AggregateException( L"Parallel scan has been aborted", innerException );
+		}
+		return false;
+	}
+
+	Common::Cells* ParallelTableScanner::RentChunk( ) {
+		IntPtr pooled;
+		return chunkPool->TryDequeue( pooled ) ? static_cast<Common::Cells*>( pooled.ToPointer() ) : Common::Cells::create( maxChunkCells );
+	}
+
+	void ParallelTableScanner::ReleaseChunk( Common::Cells* cells ) {
+		cells->clear();
+		if( chunkPool->Count < queuedChunks * tasks->Length ) {
+			chunkPool->Enqueue( IntPtr(cells) );
+		}
+		else {
+			delete cells;
+		}
+	}
+
+	void ParallelTableScanner::Fail( Exception^ e ) {
+		Logging::TraceException( e );
+		Interlocked::CompareExchange<Exception^>( innerException, e, nullptr );
+		cts->Cancel();
+	}
+
+	bool ParallelTableScanner::Visit( const Common::Cell& cell, CellVisitor^ visitor, cli::array<Byte>^% buffer ) {
+		int length = static_cast<int>( cell.valueLength() );
+		IValueCodec^ codec = nullptr;
+		int decodedLength;
+		if( valueCodecs != nullptr && length > 0 ) {
+			if( columnFamilyCache == nullptr ) {
+				columnFamilyCache = gcnew StringCache();
+			}
+			codec = valueCodecs->GetEncoded( columnFamilyCache->Get(cell.columnFamily()), cell.value(), length, decodedLength );
+		}
+		if( codec != nullptr ) {
+			if( buffer == nullptr || buffer->Length < decodedLength ) {
+				if( buffer != nullptr ) {
+					ArrayPool<Byte>::Shared->Return( buffer );
+					buffer = nullptr;
+				}
+				buffer = ArrayPool<Byte>::Shared->Rent( decodedLength );
+			}
+			pin_ptr<Byte> pb = &buffer[0];
+			ValueCodecMap::Decode( codec, cell.value(), length, pb, decodedLength );
+			return visitor( CellView(cell, IntPtr(pb), decodedLength) );
+		}
+		return visitor( CellView(cell, IntPtr(const_cast<Common::uint8_t*>(cell.value())), length) );
+	}
+
+	List<String^>^ ParallelTableScanner::SampleSplitRows( Table^ table, Hypertable::ScanSpec^ scanSpec, RowInterval^ interval, int degree ) {
+		// probes the first row at or after interpolated keys by bounded keys only scans, bisects for the
+		// approximate last row and splits the populated key space evenly, the split rows are existing rows
+		List<String^>^ splitRows = gcnew List<String^>( degree );
+		String^ first = ProbeRow( table, scanSpec, interval, interval->StartRow != nullptr ? interval->StartRow : String::Empty, interval->IncludeStartRow );
+		if( first == nullptr ) {
+			return splitRows;
+		}
+
+		String^ lo = first;
+		String^ hi = !String::IsNullOrEmpty( interval->EndRow ) ? interval->EndRow : gcnew String( static_cast<wchar_t>(0xffff), 1 );
+		for( int n = 0; n < maxBisectProbes; ++n ) {
+			String^ mid = Interpolate( lo, hi, 0.5 );
+			if( CompareRows(mid, lo) <= 0 || CompareRows(mid, hi) >= 0 ) {
+				break;
+			}
+			String^ row = ProbeRow( table, scanSpec, interval, mid, true );
+			if( row != nullptr ) {
+				lo = row;
+			}
+			else {
+				hi = mid;
+			}
+		}
+
+		for( int n = 1; n < degree; ++n ) {
+			String^ row = ProbeRow( table, scanSpec, interval, Interpolate(first, hi, static_cast<double>(n) / degree), true );
+			if( row != nullptr && CompareRows(row, first) > 0 ) {
+				splitRows->Add( row );
+			}
+		}
+		splitRows->Sort( gcnew Comparison<String^>(&ParallelTableScanner::CompareRows) );
+		for( int n = splitRows->Count - 1; n > 0; --n ) {
+			if( CompareRows(splitRows[n - 1], splitRows[n]) == 0 ) {
+				splitRows->RemoveAt( n );
+			}
+		}
+		return splitRows;
+	}
+
+	String^ ParallelTableScanner::ProbeRow( Table^ table, Hypertable::ScanSpec^ scanSpec, RowInterval^ interval, String^ startRow, bool includeStartRow ) {
+		Hypertable::ScanSpec^ probe = scanSpec->CopyWithoutRows();
+		probe->AddRowInterval( gcnew RowInterval(startRow, includeStartRow, interval->EndRow, interval->IncludeEndRow) );
+		probe->KeysOnly = true;
+		probe->MaxVersions = 1;
+		probe->MaxRows = 1;
+		probe->Flags = probe->Flags & ~(ScannerFlags::Prefetch | ScannerFlags::InternStrings);
+		ITableScanner^ scanner = table->CreateScanner( probe );
+		try {
+			Cell^ cell;
+			return scanner->Next( cell ) ? cell->Key->Row : nullptr;
+		}
+		finally {
+			delete scanner;
+		}
+	}
+
+	String^ ParallelTableScanner::Interpolate( String^ lo, String^ hi, double fraction ) {
+		// interpolates three utf16 code units beyond the common prefix, which gives 48 bits of resolution
+		int prefix = 0;
+		while( prefix < lo->Length && prefix < hi->Length && lo[prefix] == hi[prefix] ) {
+			++prefix;
+		}
+		Int64 a = 0;
+		Int64 b = 0;
+		for( int n = prefix; n < prefix + 3; ++n ) {
+			a = (a << 16) | (n < lo->Length ? lo[n] : 0);
+			b = (b << 16) | (n < hi->Length ? hi[n] : 0);
+		}
+		Int64 m = a + static_cast<Int64>( (b - a) * fraction );
+		cli::array<wchar_t>^ digits = gcnew cli::array<wchar_t>( 3 );
+		int length = 0;
+		for( int n = 0; n < 3; ++n ) {
+			digits[n] = static_cast<wchar_t>( (m >> (16 * (2 - n))) & 0xffff );
+			if( digits[n] ) {
+				length = n + 1;
+			}
+		}
+		for( int n = 0; n < length; ++n ) {
+			// row keys are nul terminated utf8, the probe keys must not contain nul or unpaired surrogates
+			if( digits[n] == 0 ) {
+				digits[n] = 1;
+			}
+			else if( digits[n] >= 0xd800 && digits[n] < 0xe000 ) {
+				digits[n] = static_cast<wchar_t>( 0xe000 );
+			}
+		}
+		return lo->Substring( 0, prefix ) + gcnew String( digits, 0, length );
+	}
+
+	int ParallelTableScanner::CompareRows( String^ a, String^ b ) {
+		// compares in utf8 byte order (code point order), which differs from the ordinal utf16 order for surrogates
+		const int length = Math::Min( a->Length, b->Length );
+		for( int n = 0; n < length; ++n ) {
+			int x = a[n];
+			int y = b[n];
+			if( x != y ) {
+				if( x >= 0xd800 && y >= 0xd800 ) {
+					x = x >= 0xe000 ? x - 0x800 : x + 0x2000;
+					y = y >= 0xe000 ? y - 0x800 : y + 0x2000;
+				}
+				return x - y;
+			}
+		}
+		return a->Length - b->Length;
+	}
+
+	List<int>^ ParallelTableScanner::Split( cli::array<String^>^ rows, int degree ) {
+		// returns the start index of each group followed by the length, equal rows never span groups
+		List<int>^ starts = gcnew List<int>( degree + 1 );
+		const int size = (rows->Length + degree - 1) / degree;
+		for( int n = 0; n < rows->Length; ) {
+			starts->Add( n );
+			int end = Math::Min( n + size, rows->Length );
+			while( end < rows->Length && String::CompareOrdinal(rows[end - 1], rows[end]) == 0 ) {
+				++end;
+			}
+			n = end;
+		}
+		starts->Add( rows->Length );
+		return starts;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,178 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#pragma once
+
+#ifndef __cplusplus_cli
+#error "requires /clr"
+#endif
+
+#include "ITableScanner.h"
+
+namespace ht4c { namespace Common {
+	class Cell;
+	class Cells;
+	class TableScanner;
+} }
+
+namespace Hypertable {
+	using namespace System;
+	using namespace System::Collections::Generic;
+	using namespace System::Collections::Concurrent;
+	using namespace System::Runtime::InteropServices;
+	using namespace System::Threading;
+	using namespace System::Threading::Tasks;
+	using namespace ht4c;
+
+	ref class Table;
+	ref class StringCache;
+	ref class ScannerStatistics;
+	ref class ValueCodecMap;
+	ref class RowInterval;
+
+	/// <summary>
+	/// Represents a table scanner which scans row partitions concurrently.
+	/// </summary>
+	/// <remarks>
+	/// The scan specification gets split into disjoint row partitions, which are scanned by a number of worker
+	/// tasks into native cell chunks. The ordered scanner delivers the partitions one after another, which preserves
+	/// the key order, the unordered scanner delivers the chunks as they arrive. The partitions follow the row or
+	/// cell intervals of the scan specification, MaxRows and MaxCells therefore apply to each interval as for the
+	/// native scanner. A scan without row predicates or with a single row interval is split at rows sampled by
+	/// a few keys only probe scans. A parallel scanner of degree one serves as prefetching scanner.
+	/// </remarks>
+	/// <seealso cref="ITableScanner"/>
+	ref class ParallelTableScanner sealed : public ITableScanner {
+
+		public:
+
+			/// <summary>
+			/// Clean up all managed and unmanaged resources.
+			/// </summary>
+			virtual ~ParallelTableScanner( );
+
+			/// <summary>
+			/// Clean up all unmanaged resources.
+			/// </summary>
+			!ParallelTableScanner( );
+
+			#pragma region ITableScanner methods
+
+			property Hypertable::ScanSpec^ ScanSpec {
+				virtual Hypertable::ScanSpec^ get( ) {
+					return scanSpec;
+				}
+			}
+
+			property bool IsDisposed {
+				virtual bool get( ) {
+					return disposed;
+				}
+			}
+
+			property ScannerStatistics^ Statistics {
+				virtual ScannerStatistics^ get( ) {
+					return statistics;
+				}
+			}
+
+			virtual bool Move( Cell^ cell );
+			virtual bool Move( BufferedCell^ cell );
+			virtual bool Move( PooledCell^ cell );
+			virtual bool MoveBatch( cli::array<BufferedCell^>^ cells, [Out] int% count );
+			virtual bool Move( ScanBlock^ block );
+			virtual bool Next( [Out] Cell^% cell );
+			virtual bool Next( Func<Key^, IntPtr, int, bool>^ action );
+			virtual bool Visit( CellVisitor^ visitor );
+			virtual bool VisitBatch( CellVisitor^ visitor, int maxCount, [Out] int% count );
+
+			virtual IEnumerator<Cell^>^ generic_GetEnumerator( ) = IEnumerable<Cell^>::GetEnumerator;
+
+			virtual System::Collections::IEnumerator^ GetEnumerator( ) = System::Collections::IEnumerable::GetEnumerator {
+				return generic_GetEnumerator();
+			}
+
+			#pragma endregion
+
+		internal:
+
+			ParallelTableScanner( Table^ table, Hypertable::ScanSpec^ scanSpec, int degree, bool ordered );
+
+			bool MoveNext( [Out] Cell^% cell );
+
+			/// <summary>
+			/// Splits the scan specification into disjoint row partitions in row order.
+			/// </summary>
+			static cli::array<Hypertable::ScanSpec^>^ Partition( Table^ table, Hypertable::ScanSpec^ scanSpec, int degree );
+
+		private:
+
+			value struct Chunk {
+				IntPtr cells;
+				int partition;
+			};
+
+			void Scan( );
+			void ScanPartition( int partition );
+			bool NextCell( );
+			bool TakeChunk( );
+			Common::Cells* RentChunk( );
+			void ReleaseChunk( Common::Cells* cells );
+			void Fail( Exception^ e );
+			bool Visit( const Common::Cell& cell, CellVisitor^ visitor, cli::array<Byte>^% buffer );
+			static List<int>^ Split( cli::array<String^>^ rows, int degree );
+			static List<String^>^ SampleSplitRows( Table^ table, Hypertable::ScanSpec^ scanSpec, RowInterval^ interval, int degree );
+			static String^ ProbeRow( Table^ table, Hypertable::ScanSpec^ scanSpec, RowInterval^ interval, String^ startRow, bool includeStartRow );
+			static String^ Interpolate( String^ lo, String^ hi, double fraction );
+			static int CompareRows( String^ a, String^ b );
+
+			Table^ table;
+			Hypertable::ScanSpec^ scanSpec;
+			cli::array<Hypertable::ScanSpec^>^ partitions;
+			cli::array<BlockingCollection<Chunk>^>^ queues;
+			ConcurrentQueue<IntPtr>^ chunkPool;
+			CancellationTokenSource^ cts;
+			cli::array<Task^>^ tasks;
+			ScannerStatistics^ statistics;
+			StringCache^ stringCache;
+			StringCache^ columnFamilyCache;
+			ValueCodecMap^ valueCodecs;
+			Object^ syncRoot;
+			Exception^ innerException;
+			Common::Cells* current;
+			Common::Cell* nativeCell;
+			size_t index;
+			Chunk chunk;
+			int queue;
+			int nextPartition;
+			int activeWorkers;
+			initonly bool ordered;
+			bool finished;
+			bool disposed;
+
+			static const int maxChunkCells = 4096;
+			static const int maxChunkBytes = 1024 * 1024;
+			static const int queuedChunks = 4;
+			static const int maxBisectProbes = 16;
+	};
+
+}
\ No newline at end of file
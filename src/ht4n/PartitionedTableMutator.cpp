@@ -0,0 +1,220 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+#include "stdafx.h"
+
+#include "PartitionedTableMutator.h"
+#include "Key.h"
+#include "Cell.h"
+#include "Exception.h"
+#include "CM2U8.h"
+
+#include "ht4c.Common/KeyBuilder.h"
+
+namespace Hypertable {
+	using namespace System;
+	using namespace System::Threading;
+	using namespace System::Threading::Tasks;
+
+	PartitionedTableMutator::~PartitionedTableMutator( ) {
+		disposed = true;
+		GC::SuppressFinalize(this);
+		this->!PartitionedTableMutator();
+	}
+
+	PartitionedTableMutator::!PartitionedTableMutator( ) {
+		if( partitions != nullptr ) {
+			for each( ITableMutator^ partition in partitions ) {
+				delete partition;
+			}
+			partitions = nullptr;
+		}
+	}
+
+	void PartitionedTableMutator::Set( Key^ key, cli::array<Byte>^ value ) {
+		Set( key, value, false );
+	}
+
+	void PartitionedTableMutator::Set( Key^ key, cli::array<Byte>^ value, bool createRowKey ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		if( key == nullptr ) throw gcnew ArgumentNullException( L"key" );
+		if( createRowKey || String::IsNullOrEmpty(key->Row) ) {
+			key->Row = gcnew String( Common::KeyBuilder().c_str() );
+		}
+		Partition( key->Row )->Set( key, value, false );
+	}
+
+	void PartitionedTableMutator::Set( Cell^ cell ) {
+		if( cell == nullptr ) throw gcnew ArgumentNullException( L"cell" );
+		Set( cell, false );
+	}
+
+	void PartitionedTableMutator::Set( Cell^ cell, bool createRowKey ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		if( cell == nullptr ) throw gcnew ArgumentNullException( L"cell" );
+		Key^ key = cell->Key;
+		if( key == nullptr ) throw gcnew ArgumentException( L"Invalid parameter cell (cell.Key null)", L"cell" );
+		if( createRowKey || String::IsNullOrEmpty(key->Row) ) {
+			key->Row = gcnew String( Common::KeyBuilder().c_str() );
+		}
+		Partition( key->Row )->Set( cell, false );
+	}
+
+	void PartitionedTableMutator::Set( IEnumerable<Cell^>^ cells ) {
+		Set( cells, false );
+	}
+
+	void PartitionedTableMutator::Set( IEnumerable<Cell^>^ cells, bool createRowKey ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		if( cells == nullptr ) throw gcnew ArgumentNullException( L"cells" );
+		cli::array<List<Cell^>^>^ chunks = gcnew cli::array<List<Cell^>^>( partitions->Length );
+		for each( Cell^ cell in cells ) {
+			if( cell != nullptr ) {
+				Key^ key = cell->Key;
+				if( key != nullptr ) {
+					if( createRowKey || String::IsNullOrEmpty(key->Row) ) {
+						key->Row = gcnew String( Common::KeyBuilder().c_str() );
+					}
+					int n = PartitionIndex( key->Row );
+					if( chunks[n] == nullptr ) {
+						chunks[n] = gcnew List<Cell^>();
+					}
+					chunks[n]->Add( cell );
+				}
+			}
+		}
+		for( int n = 0; n < chunks->Length; ++n ) {
+			if( chunks[n] != nullptr ) {
+				partitions[n]->Set( chunks[n], false );
+			}
+		}
+	}
+
+	void PartitionedTableMutator::Delete( String^ row ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		if( String::IsNullOrEmpty(row) ) throw gcnew ArgumentException( L"Invalid parameter row (null or empty)", L"row" );
+		Partition( row )->Delete( row );
+	}
+
+	void PartitionedTableMutator::Delete( Key^ key ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		if( key == nullptr ) throw gcnew ArgumentNullException( L"key" );
+		Partition( key->Row )->Delete( key );
+	}
+
+	void PartitionedTableMutator::Delete( IEnumerable<Key^>^ keys ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		if( keys == nullptr ) throw gcnew ArgumentNullException( L"keys" );
+		for each( Key^ key in keys ) {
+			if( key != nullptr ) {
+				Delete( key );
+			}
+		}
+	}
+
+	void PartitionedTableMutator::Delete( IEnumerable<Cell^>^ cells ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		if( cells == nullptr ) throw gcnew ArgumentNullException( L"cells" );
+		for each( Cell^ cell in cells ) {
+			if( cell != nullptr && cell->Key != nullptr ) {
+				Delete( cell->Key );
+			}
+		}
+	}
+
+	void PartitionedTableMutator::Flush( ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		// wait for all partitions concurrently
+		Parallel::ForEach( partitions, gcnew Action<ITableMutator^>(&PartitionedTableMutator::FlushPartition) );
+	}
+
+	Task^ PartitionedTableMutator::SetAsync( IEnumerable<Cell^>^ cells ) {
+		return SetAsync( cells, CancellationToken::None );
+	}
+
+	Task^ PartitionedTableMutator::SetAsync( IEnumerable<Cell^>^ cells, CancellationToken cancellationToken ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		if( cells == nullptr ) throw gcnew ArgumentNullException( L"cells" );
+		if( cancellationToken.IsCancellationRequested ) {
+			return Task::FromCanceled( cancellationToken );
+		}
+		// the partitions are queued mutators, setting cells completes once queued
+		Set( cells );
+		return Task::CompletedTask;
+	}
+
+	Task^ PartitionedTableMutator::FlushAsync( ) {
+		return FlushAsync( CancellationToken::None );
+	}
+
+	Task^ PartitionedTableMutator::FlushAsync( CancellationToken cancellationToken ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		cli::array<Task^>^ tasks = gcnew cli::array<Task^>( partitions->Length );
+		for( int n = 0; n < partitions->Length; ++n ) {
+			tasks[n] = partitions[n]->FlushAsync( cancellationToken );
+		}
+		return Task::WhenAll( tasks );
+	}
+
+	PartitionedTableMutator::PartitionedTableMutator( cli::array<ITableMutator^>^ _partitions, MutatorStatistics^ _statistics )
+	: partitions( _partitions )
+	, statistics( _statistics )
+	, disposed( false )
+	{
+		if( partitions == nullptr ) throw gcnew ArgumentNullException( L"partitions" );
+		if( partitions->Length == 0 ) throw gcnew ArgumentException( L"Invalid parameter partitions (empty)", L"partitions" );
+	}
+
+	ITableMutator^ PartitionedTableMutator::Partition( String^ row ) {
+		return partitions[PartitionIndex(row)];
+	}
+
+	int PartitionedTableMutator::PartitionIndex( String^ row ) {
+		if( String::IsNullOrEmpty(row) ) {
+			return 0;
+		}
+
+		// FNV-1a over the utf8 row key, String::GetHashCode is randomized per process
+		// and would route rows to other partitions (and spill journals) after a restart
+		CM2U8 utf8( row );
+		uint32_t hash = 2166136261u;
+		for( const unsigned char* p = reinterpret_cast<const unsigned char*>(utf8.c_str()); *p; ++p ) {
+			hash ^= *p;
+			hash *= 16777619u;
+		}
+		return static_cast<int>( hash % static_cast<uint32_t>(partitions->Length) );
+	}
+
+	void PartitionedTableMutator::FlushPartition( ITableMutator^ partition ) {
+		partition->Flush();
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+#pragma once
+
+#ifndef __cplusplus_cli
+#error "requires /clr"
+#endif
+
+#include "ITableMutator.h"
+
+namespace Hypertable {
+	using namespace System;
+	using namespace System::Collections::Generic;
+
+	ref class MutatorStatistics;
+
+	/// <summary>
+	/// Represents a partitioned asynchronous table mutator.
+	/// </summary>
+	/// <remarks>
+	/// Cells are routed to the partitions by a stable hash of the row key, each partition owns
+	/// its own queue, consumer and underlying mutator. The per-row order is preserved, also
+	/// across process restarts when replaying spill journals.
+	/// </remarks>
+	/// <seealso cref="ITableMutator"/>
+	ref class PartitionedTableMutator sealed : public ITableMutator {
+
+		public:
+
+			/// <summary>
+			/// Clean up all managed and unmanaged resources.
+			/// </summary>
+			virtual ~PartitionedTableMutator( );
+
+			/// <summary>
+			/// Clean up all unmanaged resources.
+			/// </summary>
+			!PartitionedTableMutator( );
+
+			#pragma region ITableMutator methods
+
+			property bool IsDisposed {
+				virtual bool get( ) {
+					return disposed;
+				}
+			}
+
+			property MutatorStatistics^ Statistics {
+				virtual MutatorStatistics^ get( ) {
+					return statistics;
+				}
+			}
+
+			virtual void Set( Key^ key, cli::array<Byte>^ value );
+			virtual void Set( Key^ key, cli::array<Byte>^ value, bool createRowKey );
+
+			virtual void Set( Cell^ cell );
+			virtual void Set( Cell^ cell, bool createRowKey );
+
+			virtual void Set( IEnumerable<Cell^>^ cells );
+			virtual void Set( IEnumerable<Cell^>^ cells, bool createRowKey );
+
+			virtual void Delete( String^ row );
+			virtual void Delete( Key^ key );
+			virtual void Delete( IEnumerable<Key^>^ keys );
+			virtual void Delete( IEnumerable<Cell^>^ cells );
+
+			virtual void Flush();
+			virtual System::Threading::Tasks::Task^ SetAsync( IEnumerable<Cell^>^ cells );
+			virtual System::Threading::Tasks::Task^ SetAsync( IEnumerable<Cell^>^ cells, System::Threading::CancellationToken cancellationToken );
+			virtual System::Threading::Tasks::Task^ FlushAsync( );
+			virtual System::Threading::Tasks::Task^ FlushAsync( System::Threading::CancellationToken cancellationToken );
+
+			#pragma endregion
+
+		internal:
+
+			PartitionedTableMutator( cli::array<ITableMutator^>^ partitions, MutatorStatistics^ statistics );
+
+		private:
+
+			ITableMutator^ Partition( String^ row );
+			int PartitionIndex( String^ row );
+			static void FlushPartition( ITableMutator^ partition );
+
+			cli::array<ITableMutator^>^ partitions;
+			MutatorStatistics^ statistics;
+			bool disposed;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+#include "stdafx.h"
+
+#include "PendingBytesBudget.h"
+#include "MutatorStatistics.h"
+#include "Key.h"
+#include "CM2U8.h"
+
+namespace Hypertable {
+	using namespace System;
+	using namespace System::Threading;
+	using namespace System::Diagnostics;
+
+	PendingBytesBudget::PendingBytesBudget( Int64 _maxPendingBytes, MutatorStatistics^ _statistics )
+	: syncRoot( gcnew Object() )
+	, pendingBytes( 0 )
+	, disabled( false )
+	, statistics( _statistics )
+	, maxPendingBytes( _maxPendingBytes )
+	{
+		if( maxPendingBytes <= 0 ) throw gcnew ArgumentException( L"Invalid parameter maxPendingBytes (maxPendingBytes <= 0)", L"maxPendingBytes" );
+		if( statistics == nullptr ) throw gcnew ArgumentNullException( L"statistics" );
+	}
+
+	void PendingBytesBudget::Acquire( Int64 bytes ) {
+		msclr::lock sync( syncRoot );
+		if( Exceeds(bytes) ) {
+			Int64 started = Stopwatch::GetTimestamp();
+			do {
+				Monitor::Wait( syncRoot );
+			}
+			while( Exceeds(bytes) );
+			statistics->AddBlocked( Stopwatch::GetTimestamp() - started );
+		}
+		pendingBytes += bytes;
+		statistics->AddPending( bytes );
+	}
+
+	bool PendingBytesBudget::TryAcquire( Int64 bytes ) {
+		msclr::lock sync( syncRoot );
+		if( Exceeds(bytes) ) {
+			return false;
+		}
+		pendingBytes += bytes;
+		statistics->AddPending( bytes );
+		return true;
+	}
+
+	void PendingBytesBudget::Release( Int64 bytes ) {
+		msclr::lock sync( syncRoot );
+		pendingBytes -= bytes;
+		statistics->AddPending( -bytes );
+		Monitor::PulseAll( syncRoot );
+	}
+
+	void PendingBytesBudget::Disable( ) {
+		msclr::lock sync( syncRoot );
+		disabled = true;
+		Monitor::PulseAll( syncRoot );
+	}
+
+	Int64 PendingBytesBudget::SizeOf( Key^ key, cli::array<Byte>^ value ) {
+		Int64 size = cellOverhead;
+		if( key != nullptr ) {
+			size += CM2U8::Utf8Length( key->Row );
+			size += CM2U8::Utf8Length( key->ColumnFamily );
+			size += CM2U8::Utf8Length( key->ColumnQualifier );
+		}
+		return size + (value != nullptr ? value->Length : 0);
+	}
+
+	bool PendingBytesBudget::Exceeds( Int64 bytes ) {
+		return !disabled && pendingBytes > 0 && pendingBytes + bytes > maxPendingBytes;
+	}
+
+}
\ No newline at end of file
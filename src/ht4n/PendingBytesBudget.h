@@ -0,0 +1,68 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+#pragma once
+
+#ifndef __cplusplus_cli
+#error "requires /clr"
+#endif
+
+namespace Hypertable {
+	using namespace System;
+
+	ref class Key;
+	ref class MutatorStatistics;
+
+	/// <summary>
+	/// Represents a byte based budget for cells queued or buffered by a table mutator.
+	/// </summary>
+	/// <remarks>
+	/// Producers acquiring bytes block as long as the budget is exceeded, a single cell
+	/// larger than the budget passes if nothing else is pending. Once disabled, for example
+	/// because the consumer has failed, producers do not block anymore.
+	/// </remarks>
+	ref class PendingBytesBudget sealed {
+
+		internal:
+
+			PendingBytesBudget( Int64 maxPendingBytes, MutatorStatistics^ statistics );
+
+			void Acquire( Int64 bytes );
+			bool TryAcquire( Int64 bytes );
+			void Release( Int64 bytes );
+			void Disable( );
+
+			static Int64 SizeOf( Key^ key, cli::array<Byte>^ value );
+
+		private:
+
+			bool Exceeds( Int64 bytes );
+
+			Object^ syncRoot;
+			Int64 pendingBytes;
+			bool disabled;
+			MutatorStatistics^ statistics;
+			const Int64 maxPendingBytes;
+
+			static const int cellOverhead = 32;
+	};
+
+}
\ No newline at end of file
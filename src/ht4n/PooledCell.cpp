@@ -24,6 +24,8 @@
 #include "PooledCell.h"
 #include "Cell.h"
 #include "Key.h"
+#include "ValueCodecMap.h"
+#include "IValueCodec.h"
 
 #include "ht4c.Common/Cell.h"
 
@@ -48,14 +50,36 @@ namespace Hypertable {
 
 	PooledCell::PooledCell( const Common::Cell* cell ) {
 		if( cell ) {
-			From( *cell );
+			From( *cell, nullptr );
+		}
+	}
+
+	PooledCell::PooledCell( const Common::Cell* cell, StringCache^ stringCache ) {
+		if( cell ) {
+			From( *cell, stringCache );
 		}
 	}
 
 	void PooledCell::From( const Common::Cell& cell ) {
-		Key = gcnew Hypertable::Key( cell );
+		From( cell, nullptr );
+	}
 
-		if( (valueLength = static_cast<int>(cell.valueLength())) > 0 ) {
+	void PooledCell::From( const Common::Cell& cell, StringCache^ stringCache ) {
+		From( cell, stringCache, nullptr );
+	}
+
+	void PooledCell::From( const Common::Cell& cell, StringCache^ stringCache, ValueCodecMap^ valueCodecs ) {
+		Key = gcnew Hypertable::Key( cell, stringCache );
+
+		int decodedLength;
+		IValueCodec^ codec;
+		if( (valueLength = static_cast<int>(cell.valueLength())) > 0 && valueCodecs != nullptr && (codec = valueCodecs->GetEncoded(Key->ColumnFamily, cell.value(), valueLength, decodedLength)) != nullptr ) {
+			value = decodedLength <= smallPoolSize ? smallPool->Rent( decodedLength ) : largePool->Rent( decodedLength );
+			pin_ptr<Byte> pv = &value[0];
+			ValueCodecMap::Decode( codec, cell.value(), valueLength, pv, decodedLength );
+			valueLength = decodedLength;
+		}
+		else if( valueLength > 0 ) {
 			value = valueLength <= smallPoolSize ? smallPool->Rent( valueLength ) : largePool->Rent( valueLength );
 			pin_ptr<Byte> pv = &value[0];
 			memcpy( pv, cell.value(), valueLength );
@@ -38,6 +38,8 @@ namespace Hypertable {
 	using namespace ht4c;
 
 	ref class Key;
+	ref class StringCache;
+	ref class ValueCodecMap;
 	ref class Counter;
 
 	/// <summary>
@@ -124,7 +126,10 @@ namespace Hypertable {
 		internal:
 
 			PooledCell( const Common::Cell* cell );
+			PooledCell( const Common::Cell* cell, StringCache^ stringCache );
 			void From( const Common::Cell& cell );
+			void From( const Common::Cell& cell, StringCache^ stringCache );
+			void From( const Common::Cell& cell, StringCache^ stringCache, ValueCodecMap^ valueCodecs );
 
 		private:
 
@@ -26,6 +26,11 @@
 #include "Cell.h"
 #include "Exception.h"
 #include "Logging.h"
+#include "MutatorSpec.h"
+#include "MutatorStatistics.h"
+#include "PendingBytesBudget.h"
+#include "HypertableEventSource.h"
+#include "SpillJournal.h"
 
 #include "ht4c.Common/KeyBuilder.h"
 
@@ -40,11 +45,13 @@ namespace Hypertable {
 	}
 
 	QueuedTableMutator::!QueuedTableMutator( ) {
+		EnqueuePending( );
 		bc->CompleteAdding();
 		task->Wait();
 		delete bc;
 		delete task;
 		delete mre;
+		delete journal;
 		delete inner;
 	}
 
@@ -87,17 +94,22 @@ namespace Hypertable {
 		HT4N_THROW_OBJECTDISPOSED( );
 
 		if( cells == nullptr ) throw gcnew ArgumentNullException( L"cells" );
+		List<Cell^>^ l = gcnew List<Cell^>();
 		for each( Cell^ cell in cells ) {
 			if( cell != nullptr ) {
 				Key^ key = cell->Key;
 				if( key != nullptr ) {
+					if( cell->Value != nullptr && cell->Value->Length > Cell::MaxSize ) {
+						throw gcnew System::ArgumentException("cell value exceeds the limit", "cells");
+					}
 					if( createRowKey || String::IsNullOrEmpty(key->Row) ) {
 						key->Row = gcnew String( Common::KeyBuilder().c_str() );
 					}
-					AddCell( gcnew Cell(key, cell->Value, cell->Flag, true) );
+					l->Add( gcnew Cell(key, cell->Value, cell->Flag, true) );
 				}
 			}
 		}
+		AddCells( l );
 	}
 
 	void QueuedTableMutator::Delete( String^ row ) {
@@ -141,19 +153,100 @@ namespace Hypertable {
 
 		ThrowIfInnerExceptionOccurred();
 
+		EnqueuePending( );
 		mre->WaitOne();
+		ThrowIfInnerExceptionOccurred();
 		inner->Flush();
 	}
 
-	QueuedTableMutator::QueuedTableMutator( ITableMutator^ _inner, int capacity )
+	Task^ QueuedTableMutator::SetAsync( IEnumerable<Cell^>^ cells ) {
+		return SetAsync( cells, CancellationToken::None );
+	}
+
+	Task^ QueuedTableMutator::SetAsync( IEnumerable<Cell^>^ cells, CancellationToken cancellationToken ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		if( cells == nullptr ) throw gcnew ArgumentNullException( L"cells" );
+		if( cancellationToken.IsCancellationRequested ) {
+			return Task::FromCanceled( cancellationToken );
+		}
+		Set( cells );
+		return Task::CompletedTask;
+	}
+
+	Task^ QueuedTableMutator::FlushAsync( ) {
+		return FlushAsync( CancellationToken::None );
+	}
+
+	Task^ QueuedTableMutator::FlushAsync( CancellationToken cancellationToken ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		ThrowIfInnerExceptionOccurred();
+
+		if( cancellationToken.IsCancellationRequested ) {
+			return Task::FromCanceled( cancellationToken );
+		}
+
+		// completed by the consumer, continuations must not run on the consumer
+		PendingFlush flush;
+		flush.tcs = gcnew TaskCompletionSource<bool>( TaskCreationOptions::RunContinuationsAsynchronously );
+		if( cancellationToken.CanBeCanceled ) {
+			// disposed on completion, otherwise the registration keeps the flush alive as long as the token
+			flush.registration = cancellationToken.Register( gcnew Action<Object^>(&QueuedTableMutator::CancelFlush), flush.tcs );
+		}
+		{
+			msclr::lock sync( pendingRoot );
+			flushes->Add( flush );
+		}
+		if( !EnqueuePending() ) {
+			// wake up an idle consumer
+			bc->TryAdd( RentBatch() );
+		}
+		return flush.tcs->Task;
+	}
+
+	QueuedTableMutator::QueuedTableMutator( ITableMutator^ _inner, int capacity, int _batchSize, Int64 maxPendingBytes, bool coalesce, cli::array<String^>^ _counterColumnFamilies, String^ spillPath, int _spillThreshold, MutatorStatistics^ _statistics )
 	: task( nullptr )
-	, bc( capacity > 0 ? gcnew BlockingCollection<Cell^>(capacity) : gcnew BlockingCollection<Cell^>() )
+	, batchPool( gcnew ConcurrentQueue<List<Cell^>^>() )
+	, pendingRoot( gcnew Object() )
+	, flushes( gcnew List<PendingFlush>() )
+	, queued( 0 )
 	, mre( gcnew ManualResetEvent(true) )
 	, inner( _inner )
+	, batchSize( Math::Max(1, capacity > 0 ? Math::Min(_batchSize > 0 ? _batchSize : MutatorSpec::BatchSizeDefault, capacity) : (_batchSize > 0 ? _batchSize : MutatorSpec::BatchSizeDefault)) )
+	, spillThreshold( Math::Max(1, capacity > 0 ? Math::Min(_spillThreshold, capacity) : _spillThreshold) )
+	, spilling( false )
 	, disposed( false )
 	{
 		if( inner == nullptr ) throw gcnew ArgumentNullException( L"inner" );
-		task = Task::Factory->StartNew( gcnew Action(this, &Hypertable::QueuedTableMutator::SetCell) );
+		statistics = _statistics != nullptr ? _statistics : inner->Statistics;
+		if( statistics == nullptr ) {
+			statistics = gcnew MutatorStatistics();
+		}
+		HypertableEventSource::RegisterQueue( statistics );
+		if( maxPendingBytes > 0 ) {
+			budget = gcnew PendingBytesBudget( maxPendingBytes, statistics );
+		}
+		if( coalesce ) {
+			coalesceIndex = gcnew Dictionary<Key^, int>( batchSize );
+			if( _counterColumnFamilies != nullptr && _counterColumnFamilies->Length > 0 ) {
+				counterColumnFamilies = gcnew HashSet<String^>( _counterColumnFamilies, StringComparer::Ordinal );
+			}
+		}
+		pending = RentBatch();
+		bc = capacity > 0 ? gcnew BlockingCollection<List<Cell^>^>( Math::Max(1, capacity / batchSize) ) : gcnew BlockingCollection<List<Cell^>^>();
+		if( !String::IsNullOrEmpty(spillPath) ) {
+			journal = gcnew SpillJournal( spillPath );
+			if( journal->Count > 0 ) {
+				// replay the cells left behind by a previous instance first
+				spilling = true;
+				queued = journal->Count;
+				statistics->AddQueued( queued );
+				mre->Reset();
+				bc->Add( RentBatch() );
+			}
+		}
+		task = Task::Factory->StartNew( gcnew Action(this, &Hypertable::QueuedTableMutator::SetCells) );
 	}
 
 	void QueuedTableMutator::AddCell( Cell^ cell ) {
@@ -163,21 +256,145 @@ namespace Hypertable {
 
 		ThrowIfInnerExceptionOccurred();
 
-		mre->Reset();
-		bc->Add( cell );
+		if( journal != nullptr && Spill(cell) ) {
+			return;
+		}
+
+		if( budget != nullptr ) {
+			budget->Acquire( PendingBytesBudget::SizeOf(cell->Key, cell->Value) );
+		}
+
+		List<Cell^>^ batch = nullptr;
+		{
+			msclr::lock sync( pendingRoot );
+			mre->Reset();
+			pending->Add( cell );
+			++queued;
+			statistics->AddQueued( 1 );
+			// hand over the pending cells if the batch is complete or the consumer is idle
+			if( pending->Count >= batchSize || bc->Count == 0 ) {
+				batch = pending;
+				pending = RentBatch();
+			}
+		}
+		if( batch != nullptr ) {
+			bc->Add( batch );
+		}
 	}
 
-	void QueuedTableMutator::SetCell() {
+	void QueuedTableMutator::AddCells( List<Cell^>^ cells ) {
+		ThrowIfInnerExceptionOccurred();
+
+		for( int n = 0; n < cells->Count; ) {
+			int end = Math::Min( n + batchSize, cells->Count );
+			if( journal != nullptr && Spill(cells, n, end) ) {
+				n = end;
+				continue;
+			}
+			if( budget != nullptr ) {
+				budget->Acquire( SizeOf(cells, n, end) );
+			}
+
+			List<Cell^>^ full = nullptr;
+			List<Cell^>^ batch = nullptr;
+			{
+				msclr::lock sync( pendingRoot );
+				mre->Reset();
+				queued += end - n;
+				statistics->AddQueued( end - n );
+				for( ; n < end; ++n ) {
+					pending->Add( cells[n] );
+					if( pending->Count >= batchSize ) {
+						full = pending;
+						pending = RentBatch();
+					}
+				}
+				// hand over the remaining cells as well, the cell order must be preserved
+				if( pending->Count > 0 && (full != nullptr || bc->Count == 0) ) {
+					batch = pending;
+					pending = RentBatch();
+				}
+			}
+			if( full != nullptr ) {
+				bc->Add( full );
+			}
+			if( batch != nullptr ) {
+				bc->Add( batch );
+			}
+		}
+	}
+
+	bool QueuedTableMutator::EnqueuePending( ) {
+		List<Cell^>^ batch = nullptr;
+		{
+			msclr::lock sync( pendingRoot );
+			if( pending->Count > 0 ) {
+				batch = pending;
+				pending = RentBatch();
+			}
+		}
+		if( batch != nullptr ) {
+			bc->Add( batch );
+			return true;
+		}
+		return false;
+	}
+
+	void QueuedTableMutator::SetCells() {
 		try {
-			while( !bc->IsCompleted ) {
-				for each( Cell^ cell in bc->GetConsumingEnumerable() ) {
-					inner->Set(cell);
-					if( bc->Count == 0 ) {
-						mre->Set();
+			List<Cell^>^ cells = gcnew List<Cell^>( batchSize );
+			List<Cell^>^ batch = nullptr;
+			while( batch != nullptr || bc->TryTake(batch, Timeout::Infinite) ) {
+				// drain all available batches up to the batch size
+				do {
+					cells->AddRange( batch );
+					batch->Clear();
+					if( batchPool->Count < 16 ) {
+						batchPool->Enqueue( batch );
 					}
+					batch = nullptr;
+				}
+				while( cells->Count < batchSize && bc->TryTake(batch) && cells->Count + batch->Count <= batchSize );
+
+				const int count = cells->Count;
+				if( count > 0 ) {
+					Int64 bytes = budget != nullptr ? SizeOf( cells, 0, count ) : 0;
+					if( coalesceIndex != nullptr && count > 1 ) {
+						statistics->AddElided( Coalesce(cells) );
+					}
+					inner->Set( cells );
+					statistics->AddBatch( cells->Count );
+					if( budget != nullptr ) {
+						budget->Release( bytes );
+					}
+				}
+				List<Cell^>^ next = CellsSet( count, batch == nullptr );
+				if( next != nullptr ) {
+					batch = next;
+				}
+				cells->Clear();
+				if( batch == nullptr && journal != nullptr ) {
+					batch = Replay( cells );
+				}
+				if( batch == nullptr ) {
+					CompleteFlushes();
+				}
+			}
+			if( journal != nullptr ) {
+				// replay the remaining spilled cells before terminating
+				List<Cell^>^ rest = Replay( cells );
+				if( rest != nullptr ) {
+					Int64 bytes = budget != nullptr ? SizeOf( rest, 0, rest->Count ) : 0;
+					inner->Set( rest );
+					statistics->AddBatch( rest->Count );
+					if( budget != nullptr ) {
+						budget->Release( bytes );
+					}
+					CellsSet( rest->Count, false );
 				}
 			}
 			mre->Set();
+			CompleteFlushes();
 		}
 		catch( InvalidOperationException^ ) {
 		}
@@ -186,13 +403,203 @@ namespace Hypertable {
 						Logging::TraceException( e );
 				}
 				innerException = aggregateException;
+				if( budget != nullptr ) {
+					budget->Disable();
+				}
+				FailFlushes( aggregateException );
+				mre->Set();
 				throw;
 		}
 		catch( Exception^ e ) {
 			Logging::TraceException( e );
 			innerException = e;
+			if( budget != nullptr ) {
+				budget->Disable();
+			}
+			FailFlushes( e );
+			mre->Set();
 			throw;
 		}
 	}
 
+	bool QueuedTableMutator::Spill( Cell^ cell ) {
+		bool wake;
+		{
+			msclr::lock sync( pendingRoot );
+			if( !spilling && queued < spillThreshold ) {
+				return false;
+			}
+			// once spilling, cells go to the journal until the consumer has replayed it
+			wake = !spilling;
+			spilling = true;
+			mre->Reset();
+			journal->Append( cell );
+			++queued;
+			statistics->AddQueued( 1 );
+		}
+		if( wake ) {
+			bc->TryAdd( RentBatch() );
+		}
+		return true;
+	}
+
+	bool QueuedTableMutator::Spill( List<Cell^>^ cells, int start, int end ) {
+		bool wake;
+		{
+			msclr::lock sync( pendingRoot );
+			if( !spilling && queued < spillThreshold ) {
+				return false;
+			}
+			wake = !spilling;
+			spilling = true;
+			mre->Reset();
+			journal->Append( cells, start, end );
+			queued += end - start;
+			statistics->AddQueued( end - start );
+		}
+		if( wake ) {
+			bc->TryAdd( RentBatch() );
+		}
+		return true;
+	}
+
+	List<Cell^>^ QueuedTableMutator::Replay( List<Cell^>^ cells ) {
+		// the queued cells precede the spilled cells
+		int replayed = 0;
+		for( ;; ) {
+			{
+				msclr::lock sync( pendingRoot );
+				if( !spilling || bc->Count > 0 ) {
+					if( replayed == 0 ) {
+						return nullptr;
+					}
+					break;
+				}
+				if( journal->IsDrained ) {
+					spilling = false;
+					break;
+				}
+			}
+			int count = journal->Read( cells, batchSize );
+			inner->Set( cells );
+			statistics->AddBatch( count );
+			cells->Clear();
+			replayed += count;
+		}
+
+		// truncate the journal once the replayed cells have been flushed, unless spilling has been resumed meanwhile
+		inner->Flush();
+		{
+			msclr::lock sync( pendingRoot );
+			if( !spilling ) {
+				journal->Truncate();
+			}
+		}
+		return CellsSet( replayed, true );
+	}
+
+	List<Cell^>^ QueuedTableMutator::CellsSet( int count, bool handOver ) {
+		msclr::lock sync( pendingRoot );
+		queued -= count;
+		statistics->AddQueued( -count );
+		if( handOver && bc->Count == 0 && pending->Count > 0 ) {
+			List<Cell^>^ batch = pending;
+			pending = RentBatch();
+			return batch;
+		}
+		if( queued == 0 ) {
+			mre->Set();
+		}
+		return nullptr;
+	}
+
+	void QueuedTableMutator::CompleteFlushes( ) {
+		List<PendingFlush>^ completed;
+		{
+			msclr::lock sync( pendingRoot );
+			if( flushes->Count == 0 || queued > 0 ) {
+				return;
+			}
+			completed = flushes;
+			flushes = gcnew List<PendingFlush>();
+		}
+		try {
+			inner->Flush();
+		}
+		catch( Exception^ e ) {
+			for each( PendingFlush flush in completed ) {
+				flush.registration.Dispose();
+				flush.tcs->TrySetException( e );
+			}
+			return;
+		}
+		for each( PendingFlush flush in completed ) {
+			flush.registration.Dispose();
+			flush.tcs->TrySetResult( true );
+		}
+	}
+
+	void QueuedTableMutator::FailFlushes( Exception^ e ) {
+		List<PendingFlush>^ failed;
+		{
+			msclr::lock sync( pendingRoot );
+			failed = flushes;
+			flushes = gcnew List<PendingFlush>();
+		}
+		for each( PendingFlush flush in failed ) {
+			flush.registration.Dispose();
+			flush.tcs->TrySetException( e );
+		}
+	}
+
+	void QueuedTableMutator::CancelFlush( Object^ state ) {
+		safe_cast<TaskCompletionSource<bool>^>( state )->TrySetCanceled();
+	}
+
+	int QueuedTableMutator::Coalesce( List<Cell^>^ cells ) {
+		// keeps the latest insert per key with an automatically assigned timestamp, deletes reset the index,
+		// counter inserts are increments and must all be passed
+		coalesceIndex->Clear();
+		int elided = 0;
+		for( int n = 0; n < cells->Count; ++n ) {
+			Cell^ cell = cells[n];
+			if( cell->Flag != CellFlag::Default ) {
+				coalesceIndex->Clear();
+			}
+			else if( cell->Key->Timestamp == 0 && (counterColumnFamilies == nullptr || !counterColumnFamilies->Contains(cell->Key->ColumnFamily)) ) {
+				int index;
+				if( coalesceIndex->TryGetValue(cell->Key, index) ) {
+					cells[index] = nullptr;
+					++elided;
+				}
+				coalesceIndex[cell->Key] = n;
+			}
+		}
+		coalesceIndex->Clear();
+
+		if( elided > 0 ) {
+			int count = 0;
+			for( int n = 0; n < cells->Count; ++n ) {
+				if( cells[n] != nullptr ) {
+					cells[count++] = cells[n];
+				}
+			}
+			cells->RemoveRange( count, cells->Count - count );
+		}
+		return elided;
+	}
+
+	Int64 QueuedTableMutator::SizeOf( List<Cell^>^ cells, int start, int end ) {
+		Int64 bytes = 0;
+		for( int n = start; n < end; ++n ) {
+			bytes += PendingBytesBudget::SizeOf( cells[n]->Key, cells[n]->Value );
+		}
+		return bytes;
+	}
+
+	List<Cell^>^ QueuedTableMutator::RentBatch( ) {
+		List<Cell^>^ batch;
+		return batchPool->TryDequeue( batch ) ? batch : gcnew List<Cell^>( batchSize );
+	}
+
 }
\ No newline at end of file
@@ -31,8 +31,13 @@ namespace Hypertable {
 	using namespace System;
 	using namespace System::Threading;
 	using namespace System::Threading::Tasks;
+	using namespace System::Collections::Generic;
 	using namespace System::Collections::Concurrent;
 
+	ref class MutatorStatistics;
+	ref class PendingBytesBudget;
+	ref class SpillJournal;
+
 	/// <summary>
 	/// Represents a asynchronous table mutator.
 	/// </summary>
@@ -59,6 +64,12 @@ namespace Hypertable {
 				}
 			}
 
+			property MutatorStatistics^ Statistics {
+				virtual MutatorStatistics^ get( ) {
+					return statistics;
+				}
+			}
+
 			virtual void Set( Key^ key, cli::array<Byte>^ value );
 			virtual void Set( Key^ key, cli::array<Byte>^ value, bool createRowKey );
 
@@ -74,23 +85,57 @@ namespace Hypertable {
 			virtual void Delete( IEnumerable<Cell^>^ cells );
 
 			virtual void Flush();
+			virtual Task^ SetAsync( IEnumerable<Cell^>^ cells );
+			virtual Task^ SetAsync( IEnumerable<Cell^>^ cells, CancellationToken cancellationToken );
+			virtual Task^ FlushAsync( );
+			virtual Task^ FlushAsync( CancellationToken cancellationToken );
 
 			#pragma endregion
 
 		internal:
 
-			QueuedTableMutator( ITableMutator^ inner, int capacity );
+			QueuedTableMutator( ITableMutator^ inner, int capacity, int batchSize, Int64 maxPendingBytes, bool coalesce, cli::array<String^>^ counterColumnFamilies, String^ spillPath, int spillThreshold, MutatorStatistics^ statistics );
 
 		private:
 
+			value struct PendingFlush {
+				TaskCompletionSource<bool>^ tcs;
+				CancellationTokenRegistration registration;
+			};
+
 			void AddCell( Cell^ cell );
-			void SetCell();
+			void AddCells( List<Cell^>^ cells );
+			bool EnqueuePending( );
+			bool Spill( Cell^ cell );
+			bool Spill( List<Cell^>^ cells, int start, int end );
+			List<Cell^>^ Replay( List<Cell^>^ cells );
+			void SetCells();
+			List<Cell^>^ CellsSet( int count, bool handOver );
+			List<Cell^>^ RentBatch( );
+			void CompleteFlushes( );
+			void FailFlushes( Exception^ e );
+			static void CancelFlush( Object^ state );
+			int Coalesce( List<Cell^>^ cells );
+			static Int64 SizeOf( List<Cell^>^ cells, int start, int end );
 
 			Task^ task;
-			BlockingCollection<Cell^>^ bc;
+			BlockingCollection<List<Cell^>^>^ bc;
+			ConcurrentQueue<List<Cell^>^>^ batchPool;
+			List<Cell^>^ pending;
+			Object^ pendingRoot;
+			List<PendingFlush>^ flushes;
+			int queued;
 			ManualResetEvent^ mre;
 			ITableMutator^ inner;
+			MutatorStatistics^ statistics;
+			PendingBytesBudget^ budget;
+			Dictionary<Key^, int>^ coalesceIndex;
+			HashSet<String^>^ counterColumnFamilies;
+			SpillJournal^ journal;
+			int spillThreshold;
+			bool spilling;
 			Exception^ innerException;
+			initonly int batchSize;
 			bool disposed;
 
 			void ThrowIfInnerExceptionOccurred( ) {
@@ -0,0 +1,193 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+
+#include "stdafx.h"
+
+#include "Row.h"
+#include "CellView.h"
+#include "CM2U8.h"
+
+namespace Hypertable {
+	using namespace System;
+	using namespace System::Globalization;
+
+	String^ Row::RowKey::get( ) {
+		if( decodedRowKey == nullptr && rowKey != nullptr ) {
+			if( rowKeyLength > 0 ) {
+				pin_ptr<Byte> pk = &rowKey[0];
+				decodedRowKey = CM2U8::ToString( reinterpret_cast<const char*>(pk), rowKeyLength );
+			}
+			else {
+				decodedRowKey = String::Empty;
+			}
+		}
+		return decodedRowKey;
+	}
+
+	ArraySegment<Byte> Row::GetRowKeyBytes( ) {
+		return rowKeyLength > 0 ? ArraySegment<Byte>( rowKey, 0, rowKeyLength ) : ArraySegment<Byte>( Array::Empty<Byte>(), 0, 0 );
+	}
+
+	String^ Row::GetColumnFamily( int index ) {
+		CheckIndex( index );
+		return columnFamilies[index];
+	}
+
+	String^ Row::GetColumnQualifier( int index ) {
+		CheckIndex( index );
+		return columnQualifiers[index];
+	}
+
+	UInt64 Row::GetTimestamp( int index ) {
+		CheckIndex( index );
+		return timestamps[index];
+	}
+
+	CellFlag Row::GetFlag( int index ) {
+		CheckIndex( index );
+		return static_cast<CellFlag>( flags[index] );
+	}
+
+	ArraySegment<Byte> Row::GetValue( int index ) {
+		CheckIndex( index );
+		int len = valueOffsets[index + 1] - valueOffsets[index];
+		return len > 0 ? ArraySegment<Byte>( values, valueOffsets[index], len ) : ArraySegment<Byte>( Array::Empty<Byte>(), 0, 0 );
+	}
+
+	String^ Row::ToString() {
+		return String::Format( CultureInfo::InvariantCulture
+												 , L"{0}(RowKey={1}, Count={2}, Values.Length={3})"
+												 , GetType()
+												 , RowKey
+												 , count
+												 , valuesLength );
+	}
+
+	Row::Row( )
+	: rowKey( nullptr )
+	, rowKeyLength( 0 )
+	, decodedRowKey( nullptr )
+	, count( 0 )
+	, columnFamilies( gcnew cli::array<String^>(initialCapacity) )
+	, columnQualifiers( gcnew cli::array<String^>(initialCapacity) )
+	, timestamps( gcnew cli::array<UInt64>(initialCapacity) )
+	, flags( gcnew cli::array<Byte>(initialCapacity) )
+	, valueOffsets( gcnew cli::array<int>(initialCapacity + 1) )
+	, values( nullptr )
+	, valuesLength( 0 )
+	{
+	}
+
+	bool Row::IsRowKey( const char* row, int length ) {
+		if( rowKey == nullptr || length != rowKeyLength ) {
+			return false;
+		}
+		if( length == 0 ) {
+			return true;
+		}
+		pin_ptr<Byte> pk = &rowKey[0];
+		return memcmp( pk, row, length ) == 0;
+	}
+
+	bool Row::IsRowKey( ArraySegment<Byte> row ) {
+		if( row.Count == 0 ) {
+			return IsRowKey( 0, 0 );
+		}
+		pin_ptr<Byte> pr = &row.Array[row.Offset];
+		return IsRowKey( reinterpret_cast<const char*>(pr), row.Count );
+	}
+
+	void Row::Reset( const char* row, int length ) {
+		Clear();
+		if( rowKey == nullptr || rowKey->Length < length ) {
+			rowKey = gcnew cli::array<Byte>( __max(length, 64) );
+		}
+		if( length > 0 ) {
+			pin_ptr<Byte> pk = &rowKey[0];
+			memcpy( pk, row, length );
+		}
+		rowKeyLength = length;
+	}
+
+	void Row::Reset( ArraySegment<Byte> row ) {
+		if( row.Count == 0 ) {
+			Reset( 0, 0 );
+			return;
+		}
+		pin_ptr<Byte> pr = &row.Array[row.Offset];
+		Reset( reinterpret_cast<const char*>(pr), row.Count );
+	}
+
+	void Row::Add( CellView% cell, String^ columnFamily, String^ columnQualifier ) {
+		Add( columnFamily, columnQualifier, cell.Timestamp, cell.Flag, cell.Value.ToPointer(), cell.ValueLength );
+	}
+
+	void Row::Add( String^ columnFamily, String^ columnQualifier, UInt64 timestamp, CellFlag flag, ArraySegment<Byte> value ) {
+		if( value.Count == 0 ) {
+			Add( columnFamily, columnQualifier, timestamp, flag, 0, 0 );
+			return;
+		}
+		pin_ptr<Byte> pv = &value.Array[value.Offset];
+		Add( columnFamily, columnQualifier, timestamp, flag, pv, value.Count );
+	}
+
+	void Row::Add( String^ columnFamily, String^ columnQualifier, UInt64 timestamp, CellFlag flag, const void* value, int len ) {
+		if( count == columnFamilies->Length ) {
+			int capacity = 2 * count;
+			cli::array<String^>::Resize( columnFamilies, capacity );
+			cli::array<String^>::Resize( columnQualifiers, capacity );
+			cli::array<UInt64>::Resize( timestamps, capacity );
+			cli::array<Byte>::Resize( flags, capacity );
+			cli::array<int>::Resize( valueOffsets, capacity + 1 );
+		}
+
+		if( len > 0 ) {
+			if( values == nullptr || values->Length - valuesLength < len ) {
+				int size = values != nullptr ? values->Length : 0;
+				size = __max( __max(2 * size, valuesLength + len), 4096 );
+				cli::array<Byte>::Resize( values, size );
+			}
+			pin_ptr<Byte> pv = &values[valuesLength];
+			memcpy( pv, value, len );
+			valuesLength += len;
+		}
+
+		columnFamilies[count] = columnFamily;
+		columnQualifiers[count] = columnQualifier;
+		timestamps[count] = timestamp;
+		flags[count] = static_cast<Byte>( flag );
+		valueOffsets[++count] = valuesLength;
+	}
+
+	void Row::Clear( ) {
+		decodedRowKey = nullptr;
+		rowKeyLength = 0;
+		valuesLength = 0;
+		count = 0;
+	}
+
+	void Row::CheckIndex( int index ) {
+		if( index < 0 || index >= count ) throw gcnew ArgumentOutOfRangeException( L"index" );
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,151 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+
+#pragma once
+
+#ifndef __cplusplus_cli
+#error "requires /clr"
+#endif
+
+#include "CellFlag.h"
+
+namespace Hypertable {
+	using namespace System;
+
+	value struct CellView;
+
+	/// <summary>
+	/// Represents a scanned row, the row key and the cells of the row.
+	/// </summary>
+	/// <remarks>
+	/// The row key is kept as utf8 bytes and decoded only if requested, the cell values are stored in a single
+	/// value buffer. Row instances are pooled by the row scanner, the buffers are retained and reused for
+	/// subsequent rows.
+	/// </remarks>
+	/// <seealso cref="RowScanner"/>
+	public ref class Row sealed {
+
+		public:
+
+			/// <summary>
+			/// Gets the row key.
+			/// </summary>
+			property String^ RowKey {
+				String^ get( );
+			}
+
+			/// <summary>
+			/// Gets the number of cells in this row.
+			/// </summary>
+			property int Count {
+				int get( ) {
+					return count;
+				}
+			}
+
+			/// <summary>
+			/// Gets the utf8 encoded row key.
+			/// </summary>
+			/// <returns>Segment of the row key buffer.</returns>
+			ArraySegment<Byte> GetRowKeyBytes( );
+
+			/// <summary>
+			/// Gets the column family of the cell at the specified index.
+			/// </summary>
+			/// <param name="index">Cell index.</param>
+			/// <returns>Column family.</returns>
+			String^ GetColumnFamily( int index );
+
+			/// <summary>
+			/// Gets the column qualifier of the cell at the specified index.
+			/// </summary>
+			/// <param name="index">Cell index.</param>
+			/// <returns>Column qualifier, might be null.</returns>
+			String^ GetColumnQualifier( int index );
+
+			/// <summary>
+			/// Gets the timestamp of the cell at the specified index.
+			/// </summary>
+			/// <param name="index">Cell index.</param>
+			/// <returns>Timestamp in nanoseconds since 1970-01-01 00:00:00.0 UTC.</returns>
+			UInt64 GetTimestamp( int index );
+
+			/// <summary>
+			/// Gets the cell flag of the cell at the specified index.
+			/// </summary>
+			/// <param name="index">Cell index.</param>
+			/// <returns>Cell flag.</returns>
+			/// <seealso cref="CellFlag"/>
+			CellFlag GetFlag( int index );
+
+			/// <summary>
+			/// Gets the value of the cell at the specified index.
+			/// </summary>
+			/// <param name="index">Cell index.</param>
+			/// <returns>Segment of the value buffer.</returns>
+			ArraySegment<Byte> GetValue( int index );
+
+			/// <summary>
+			/// Returns a string that represents the current object.
+			/// </summary>
+			/// <returns>A string that represents the current object.</returns>
+			virtual String^ ToString() override;
+
+		internal:
+
+			Row( );
+
+			/// <summary>
+			/// Returns true if the specified utf8 row key equals the row key of this row, compares the bytes.
+			/// </summary>
+			bool IsRowKey( const char* row, int length );
+			bool IsRowKey( ArraySegment<Byte> row );
+
+			void Reset( const char* row, int length );
+			void Reset( ArraySegment<Byte> row );
+			void Add( CellView% cell, String^ columnFamily, String^ columnQualifier );
+			void Add( String^ columnFamily, String^ columnQualifier, UInt64 timestamp, CellFlag flag, ArraySegment<Byte> value );
+			void Clear( );
+
+		private:
+
+			void CheckIndex( int index );
+			void Add( String^ columnFamily, String^ columnQualifier, UInt64 timestamp, CellFlag flag, const void* value, int len );
+
+			cli::array<Byte>^ rowKey;
+			int rowKeyLength;
+			String^ decodedRowKey;
+			int count;
+
+			cli::array<String^>^ columnFamilies;
+			cli::array<String^>^ columnQualifiers;
+			cli::array<UInt64>^ timestamps;
+			cli::array<Byte>^ flags;
+			cli::array<int>^ valueOffsets;
+			cli::array<Byte>^ values;
+			int valuesLength;
+
+			static const int initialCapacity = 16;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+
+#include "stdafx.h"
+
+#include "RowScanner.h"
+#include "Row.h"
+#include "CellView.h"
+#include "StringCache.h"
+#include "Exception.h"
+
+namespace Hypertable {
+	using namespace System;
+	using namespace ht4c;
+
+	ref class RowScannerEnumerator sealed : public IEnumerator<Row^> {
+
+		public:
+
+			virtual ~RowScannerEnumerator( ) {
+			}
+
+			virtual property Row^ generic_Current {
+				Row^ get( ) = IEnumerator<Row^>::Current::get {
+					return row;
+				}
+			}
+
+			virtual property Object^ Current {
+				Object^ get( ) = System::Collections::IEnumerator::Current::get {
+					return generic_Current;
+				}
+			}
+
+			virtual bool MoveNext( ) {
+				return rowScanner->Next( row );
+			}
+
+			virtual void Reset( ) {
+				throw gcnew InvalidOperationException(L"Unable to reset row scanner enumerator");
+			}
+
+		internal:
+
+			RowScannerEnumerator( RowScanner^ _rowScanner ) 
+			: rowScanner( _rowScanner ) {
+			}
+
+		private:
+
+			RowScanner^ rowScanner;
+			Row^ row;
+	};
+
+	RowScanner::RowScanner( ITableScanner^ _tableScanner )
+	: tableScanner( _tableScanner )
+	, stringCache( gcnew StringCache() )
+	, pool( gcnew Stack<Row^>() )
+	, pending( nullptr )
+	, current( nullptr )
+	, eos( false )
+	, disposed( false )
+	{
+		if( tableScanner == nullptr ) throw gcnew ArgumentNullException( L"tableScanner" );
+		visitor = gcnew CellVisitor( this, &RowScanner::Visit );
+		building = Rent();
+	}
+
+	RowScanner::~RowScanner( ) {
+		if( !disposed ) {
+			disposed = true;
+			delete tableScanner;
+			pool->Clear();
+			building = pending = current = nullptr;
+		}
+	}
+
+	bool RowScanner::Next( Row^% row ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		if( current != nullptr ) {
+			current->Clear();
+			pool->Push( current );
+			current = nullptr;
+		}
+
+		while( pending == nullptr && !eos ) {
+			int count;
+			if( !tableScanner->VisitBatch(visitor, batchSize, count) && pending == nullptr ) {
+				eos = true;
+			}
+		}
+
+		if( pending != nullptr ) {
+			current = building;
+			building = pending;
+			pending = nullptr;
+		}
+		else if( building->Count > 0 ) {
+			current = building;
+			building = Rent();
+		}
+
+		row = current;
+		return current != nullptr;
+	}
+
+	IEnumerator<Row^>^ RowScanner::generic_GetEnumerator( ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		return gcnew RowScannerEnumerator( this );
+	}
+
+	bool RowScanner::Visit( CellView cell ) {
+		const char* row = static_cast<const char*>( cell.Row.ToPointer() );
+		if( building->Count == 0 ) {
+			building->Reset( row, cell.RowLength );
+		}
+		else if( !building->IsRowKey(row, cell.RowLength) ) {
+			// the cell starts the next row, stop visiting until the current row has been consumed
+			pending = Rent();
+			pending->Reset( row, cell.RowLength );
+			Add( pending, cell );
+			return false;
+		}
+		Add( building, cell );
+		return true;
+	}
+
+	void RowScanner::Add( Row^ row, CellView% cell ) {
+		const char* cf = static_cast<const char*>( cell.ColumnFamily.ToPointer() );
+		const char* cq = static_cast<const char*>( cell.ColumnQualifier.ToPointer() );
+		row->Add( cell, cf ? stringCache->Get(cf) : nullptr, cq ? stringCache->Get(cq) : nullptr );
+	}
+
+	Row^ RowScanner::Rent( ) {
+		return pool->Count > 0 ? pool->Pop() : gcnew Row();
+	}
+
+}
\ No newline at end of file
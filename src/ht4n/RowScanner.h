@@ -0,0 +1,134 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+
+#pragma once
+
+#ifndef __cplusplus_cli
+#error "requires /clr"
+#endif
+
+#include "ITableScanner.h"
+#include "CellVisitor.h"
+
+namespace Hypertable {
+	using namespace System;
+	using namespace System::Collections::Generic;
+	using namespace System::Runtime::InteropServices;
+
+	ref class Row;
+	ref class StringCache;
+
+	/// <summary>
+	/// Represents a scanner which groups the scanned cells into rows.
+	/// </summary>
+	/// <remarks>
+	/// The row scanner visits the cells of the underlying table scanner and detects the row boundaries
+	/// by comparing the utf8 encoded row keys before any managed conversion. The row instances are pooled,
+	/// a row returned by the row scanner is valid until the subsequent call to Next. The row scanner owns
+	/// the underlying table scanner. Asynchronous scans are grouped into rows by ITable.BeginRowScan.
+	/// </remarks>
+	/// <example>
+	/// The following example shows how to scan all rows of a table.
+	/// <code>
+	/// using( var scanner = new RowScanner(table.CreateScanner()) ) {
+	///    Row row;
+	///    while( scanner.Next(out row) ) {
+	///       for( int n = 0; n &lt; row.Count; ++n ) {
+	///          ArraySegment&lt;byte&gt; value = row.GetValue(n);
+	///          // process cell
+	///       }
+	///    }
+	/// }
+	/// </code>
+	/// </example>
+	/// <seealso cref="Row"/>
+	/// <seealso cref="ITableScanner"/>
+	public ref class RowScanner sealed : public IEnumerable<Row^>, public IDisposable {
+
+		public:
+
+			/// <summary>
+			/// Initializes a new instance of the RowScanner class using the specified table scanner.
+			/// </summary>
+			/// <param name="tableScanner">Table scanner.</param>
+			RowScanner( ITableScanner^ tableScanner );
+
+			/// <summary>
+			/// Clean up all managed resources.
+			/// </summary>
+			virtual ~RowScanner( );
+
+			/// <summary>
+			/// Gets the underlying table scanner.
+			/// </summary>
+			property ITableScanner^ TableScanner {
+				ITableScanner^ get( ) {
+					return tableScanner;
+				}
+			}
+
+			/// <summary>
+			/// Gets a value indicating whether the row scanner has been disposed.
+			/// </summary>
+			property bool IsDisposed {
+				bool get( ) {
+					return disposed;
+				}
+			}
+
+			/// <summary>
+			/// Gets the next available row.
+			/// </summary>
+			/// <param name="row">Scanned row. This parameter is passed uninitialized.</param>
+			/// <returns>true if there are more rows available, otherwise false.</returns>
+			/// <remarks>
+			/// The row instance gets reused by subsequent calls.
+			/// </remarks>
+			bool Next( [Out] Row^% row );
+
+			virtual IEnumerator<Row^>^ generic_GetEnumerator( ) = IEnumerable<Row^>::GetEnumerator;
+
+			virtual System::Collections::IEnumerator^ GetEnumerator( ) = System::Collections::IEnumerable::GetEnumerator {
+				return generic_GetEnumerator();
+			}
+
+		private:
+
+			bool Visit( CellView cell );
+			void Add( Row^ row, CellView% cell );
+			Row^ Rent( );
+
+			ITableScanner^ tableScanner;
+			CellVisitor^ visitor;
+			StringCache^ stringCache;
+			Stack<Row^>^ pool;
+			Row^ building;
+			Row^ pending;
+			Row^ current;
+			bool eos;
+			bool disposed;
+
+			static const int batchSize = 1024;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,218 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#include "stdafx.h"
+
+#include "ScanBlock.h"
+#include "Key.h"
+#include "Cell.h"
+#include "StringCache.h"
+#include "CM2U8.h"
+
+#include "ht4c.Common/Cell.h"
+
+namespace Hypertable {
+	using namespace System;
+	using namespace System::Globalization;
+	using namespace ht4c;
+
+	ScanBlock::ScanBlock( )
+	: capacity( 0 )
+	, count( 0 )
+	, keysLength( 0 )
+	, valuesLength( 0 )
+	{
+		capacity = CapacityDefault > 0 ? CapacityDefault : 1024;
+		keyOffsets = gcnew cli::array<int>( 4 * capacity );
+		valueOffsets = gcnew cli::array<int>( capacity + 1 );
+		timestamps = gcnew cli::array<UInt64>( capacity );
+		flags = gcnew cli::array<Byte>( capacity );
+	}
+
+	ScanBlock::ScanBlock( int _capacity )
+	: capacity( _capacity )
+	, count( 0 )
+	, keysLength( 0 )
+	, valuesLength( 0 )
+	{
+		if( capacity <= 0 ) throw gcnew ArgumentException( L"Invalid capacity specified", L"capacity" );
+		keyOffsets = gcnew cli::array<int>( 4 * capacity );
+		valueOffsets = gcnew cli::array<int>( capacity + 1 );
+		timestamps = gcnew cli::array<UInt64>( capacity );
+		flags = gcnew cli::array<Byte>( capacity );
+	}
+
+	String^ ScanBlock::GetRow( int index ) {
+		CheckIndex( index );
+		int n = 4 * index;
+		return Decode( keyOffsets[n], keyOffsets[n + 1] - keyOffsets[n] );
+	}
+
+	String^ ScanBlock::GetColumnFamily( int index ) {
+		CheckIndex( index );
+		int n = 4 * index;
+		int end = keyOffsets[n + 2] >= 0 ? keyOffsets[n + 2] : keyOffsets[n + 3];
+		return Decode( keyOffsets[n + 1], end - keyOffsets[n + 1] );
+	}
+
+	String^ ScanBlock::GetColumnQualifier( int index ) {
+		CheckIndex( index );
+		int n = 4 * index;
+		return keyOffsets[n + 2] >= 0 ? Decode( keyOffsets[n + 2], keyOffsets[n + 3] - keyOffsets[n + 2] ) : nullptr;
+	}
+
+	ArraySegment<Byte> ScanBlock::GetRowBytes( int index ) {
+		CheckIndex( index );
+		int n = 4 * index;
+		return ArraySegment<Byte>( keys, keyOffsets[n], keyOffsets[n + 1] - keyOffsets[n] );
+	}
+
+	ArraySegment<Byte> ScanBlock::GetColumnFamilyBytes( int index ) {
+		CheckIndex( index );
+		int n = 4 * index;
+		int end = keyOffsets[n + 2] >= 0 ? keyOffsets[n + 2] : keyOffsets[n + 3];
+		return ArraySegment<Byte>( keys, keyOffsets[n + 1], end - keyOffsets[n + 1] );
+	}
+
+	ArraySegment<Byte> ScanBlock::GetColumnQualifierBytes( int index ) {
+		CheckIndex( index );
+		int n = 4 * index;
+		return keyOffsets[n + 2] >= 0
+				 ? ArraySegment<Byte>( keys, keyOffsets[n + 2], keyOffsets[n + 3] - keyOffsets[n + 2] )
+				 : ArraySegment<Byte>( keys, keyOffsets[n + 3], 0 );
+	}
+
+	UInt64 ScanBlock::GetTimestamp( int index ) {
+		CheckIndex( index );
+		return timestamps[index];
+	}
+
+	CellFlag ScanBlock::GetFlag( int index ) {
+		CheckIndex( index );
+		return (CellFlag)flags[index];
+	}
+
+	ArraySegment<Byte> ScanBlock::GetValue( int index ) {
+		CheckIndex( index );
+		int len = valueOffsets[index + 1] - valueOffsets[index];
+		return len > 0 ? ArraySegment<Byte>( values, valueOffsets[index], len ) : ArraySegment<Byte>( Array::Empty<Byte>(), 0, 0 );
+	}
+
+	Hypertable::Key^ ScanBlock::GetKey( int index ) {
+		Hypertable::Key^ key = gcnew Hypertable::Key( GetRow(index), GetColumnFamily(index), GetColumnQualifier(index) );
+		key->Timestamp = timestamps[index];
+		return key;
+	}
+
+	Hypertable::Cell^ ScanBlock::GetCell( int index ) {
+		ArraySegment<Byte> value = GetValue( index );
+		cli::array<Byte>^ v = nullptr;
+		if( value.Count > 0 ) {
+			v = gcnew cli::array<Byte>( value.Count );
+			Buffer::BlockCopy( value.Array, value.Offset, v, 0, value.Count );
+		}
+		return gcnew Hypertable::Cell( GetKey(index), v, (CellFlag)flags[index] );
+	}
+
+	void ScanBlock::Clear( ) {
+		count = 0;
+		keysLength = 0;
+		valuesLength = 0;
+	}
+
+	String^ ScanBlock::ToString() {
+		return String::Format( CultureInfo::InvariantCulture
+												 , L"{0}(Count={1}, Capacity={2}, Keys.Length={3}, Values.Length={4})"
+												 , GetType()
+												 , count
+												 , capacity
+												 , keysLength
+												 , valuesLength );
+	}
+
+	void ScanBlock::Add( const Common::Cell& cell ) {
+		if( count >= capacity ) throw gcnew InvalidOperationException( L"Scan block is full" );
+
+		int n = 4 * count;
+		const char* cq = cell.columnQualifier();
+		keyOffsets[n] = Append( keys, keysLength, cell.row(), static_cast<int>(strlen(cell.row())) );
+		keyOffsets[n + 1] = Append( keys, keysLength, cell.columnFamily(), static_cast<int>(strlen(cell.columnFamily())) );
+		keyOffsets[n + 2] = cq ? Append( keys, keysLength, cq, static_cast<int>(strlen(cq)) ) : -1;
+		keyOffsets[n + 3] = keysLength;
+
+		valueOffsets[count] = Append( values, valuesLength, cell.value(), static_cast<int>(cell.valueLength()) );
+		valueOffsets[count + 1] = valuesLength;
+
+		timestamps[count] = cell.timestamp();
+		flags[count] = cell.flag();
+		++count;
+	}
+
+	String^ ScanBlock::GetColumnFamily( int index, StringCache^ stringCache ) {
+		CheckIndex( index );
+		int n = 4 * index;
+		int end = keyOffsets[n + 2] >= 0 ? keyOffsets[n + 2] : keyOffsets[n + 3];
+		return Intern( stringCache, keyOffsets[n + 1], end - keyOffsets[n + 1] );
+	}
+
+	String^ ScanBlock::GetColumnQualifier( int index, StringCache^ stringCache ) {
+		CheckIndex( index );
+		int n = 4 * index;
+		return keyOffsets[n + 2] >= 0 ? Intern( stringCache, keyOffsets[n + 2], keyOffsets[n + 3] - keyOffsets[n + 2] ) : nullptr;
+	}
+
+	void ScanBlock::CheckIndex( int index ) {
+		if( index < 0 || index >= count ) throw gcnew ArgumentOutOfRangeException( L"index" );
+	}
+
+	int ScanBlock::Append( cli::array<Byte>^% buffer, int% length, const void* p, int len ) {
+		int offset = length;
+		if( len > 0 ) {
+			if( buffer == nullptr || buffer->Length - length < len ) {
+				int size = buffer != nullptr ? buffer->Length : 0;
+				size = __max( __max(2 * size, length + len), 4096 );
+				cli::array<Byte>::Resize( buffer, size );
+			}
+			pin_ptr<Byte> pb = &buffer[offset];
+			memcpy( pb, p, len );
+			length += len;
+		}
+		return offset;
+	}
+
+	String^ ScanBlock::Decode( int offset, int length ) {
+		if( length > 0 ) {
+			pin_ptr<Byte> pk = &keys[offset];
+			return CM2U8::ToString( reinterpret_cast<const char*>(pk), length );
+		}
+		return String::Empty;
+	}
+
+	String^ ScanBlock::Intern( StringCache^ stringCache, int offset, int length ) {
+		if( length > 0 ) {
+			pin_ptr<Byte> pk = &keys[offset];
+			return stringCache->Get( reinterpret_cast<const char*>(pk), length );
+		}
+		return String::Empty;
+	}
+
+}
\ No newline at end of file
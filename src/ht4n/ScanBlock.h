@@ -0,0 +1,243 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#pragma once
+
+#ifndef __cplusplus_cli
+#error "requires /clr"
+#endif
+
+#include "CellFlag.h"
+
+namespace ht4c { namespace Common {
+	class Cell;
+} }
+
+namespace Hypertable {
+	using namespace System;
+	using namespace ht4c;
+
+	ref class Key;
+	ref class Cell;
+	ref class StringCache;
+
+	/// <summary>
+	/// Represents a block of scanned cells, the cell keys and values are stored in contiguous buffers.
+	/// </summary>
+	/// <remarks>
+	/// The row keys, column families and column qualifiers are kept as utf8 bytes in a single key buffer,
+	/// the values in a single value buffer. Strings are decoded only if requested. The buffers are retained
+	/// and reused if the block gets re-filled.
+	/// </remarks>
+	/// <example>
+	/// The following example shows how to scan all cells of a table block by block.
+	/// <code>
+	/// using( var scanner = table.CreateScanner() ) {
+	///    ScanBlock block = new ScanBlock(1024);
+	///    while( scanner.Move(block) ) {
+	///       for( int n = 0; n &lt; block.Count; ++n ) {
+	///          ArraySegment&lt;byte&gt; row = block.GetRowBytes(n);
+	///          ArraySegment&lt;byte&gt; value = block.GetValue(n);
+	///          // process cell
+	///       }
+	///    }
+	/// }
+	/// </code>
+	/// </example>
+	/// <seealso cref="Cell"/>
+	public ref class ScanBlock sealed {
+
+		public:
+
+			/// <summary>
+			/// Initializes a new instance of the ScanBlock class using the default capacity.
+			/// </summary>
+			ScanBlock( );
+
+			/// <summary>
+			/// Initializes a new instance of the ScanBlock class using the specified capacity.
+			/// </summary>
+			/// <param name="capacity">Maximum number of cells per block.</param>
+			ScanBlock( int capacity );
+
+			/// <summary>
+			/// Gets the number of cells in this block.
+			/// </summary>
+			property int Count {
+				int get( ) {
+					return count;
+				}
+			}
+
+			/// <summary>
+			/// Gets the maximum number of cells in this block.
+			/// </summary>
+			property int Capacity {
+				int get( ) {
+					return capacity;
+				}
+			}
+
+			/// <summary>
+			/// Gets the row key of the cell at the specified index.
+			/// </summary>
+			/// <param name="index">Cell index.</param>
+			/// <returns>Row key.</returns>
+			String^ GetRow( int index );
+
+			/// <summary>
+			/// Gets the column family of the cell at the specified index.
+			/// </summary>
+			/// <param name="index">Cell index.</param>
+			/// <returns>Column family.</returns>
+			String^ GetColumnFamily( int index );
+
+			/// <summary>
+			/// Gets the column qualifier of the cell at the specified index.
+			/// </summary>
+			/// <param name="index">Cell index.</param>
+			/// <returns>Column qualifier, might be null.</returns>
+			String^ GetColumnQualifier( int index );
+
+			/// <summary>
+			/// Gets the utf8 encoded row key of the cell at the specified index.
+			/// </summary>
+			/// <param name="index">Cell index.</param>
+			/// <returns>Segment of the key buffer.</returns>
+			ArraySegment<Byte> GetRowBytes( int index );
+
+			/// <summary>
+			/// Gets the utf8 encoded column family of the cell at the specified index.
+			/// </summary>
+			/// <param name="index">Cell index.</param>
+			/// <returns>Segment of the key buffer.</returns>
+			ArraySegment<Byte> GetColumnFamilyBytes( int index );
+
+			/// <summary>
+			/// Gets the utf8 encoded column qualifier of the cell at the specified index.
+			/// </summary>
+			/// <param name="index">Cell index.</param>
+			/// <returns>Segment of the key buffer, empty if the column qualifier is null.</returns>
+			ArraySegment<Byte> GetColumnQualifierBytes( int index );
+
+			/// <summary>
+			/// Gets the timestamp of the cell at the specified index.
+			/// </summary>
+			/// <param name="index">Cell index.</param>
+			/// <returns>Timestamp in nanoseconds since 1970-01-01 00:00:00.0 UTC.</returns>
+			UInt64 GetTimestamp( int index );
+
+			/// <summary>
+			/// Gets the cell flag of the cell at the specified index.
+			/// </summary>
+			/// <param name="index">Cell index.</param>
+			/// <returns>Cell flag.</returns>
+			/// <seealso cref="CellFlag"/>
+			CellFlag GetFlag( int index );
+
+			/// <summary>
+			/// Gets the value of the cell at the specified index.
+			/// </summary>
+			/// <param name="index">Cell index.</param>
+			/// <returns>Segment of the value buffer.</returns>
+			ArraySegment<Byte> GetValue( int index );
+
+			/// <summary>
+			/// Creates a new key instance for the cell at the specified index.
+			/// </summary>
+			/// <param name="index">Cell index.</param>
+			/// <returns>New key instance.</returns>
+			/// <seealso cref="Key"/>
+			Hypertable::Key^ GetKey( int index );
+
+			/// <summary>
+			/// Creates a new cell instance for the cell at the specified index.
+			/// </summary>
+			/// <param name="index">Cell index.</param>
+			/// <returns>New cell instance.</returns>
+			/// <seealso cref="Cell"/>
+			Hypertable::Cell^ GetCell( int index );
+
+			/// <summary>
+			/// Removes all cells from this block, the buffers are retained.
+			/// </summary>
+			void Clear( );
+
+			/// <summary>
+			/// Returns a string that represents the current object.
+			/// </summary>
+			/// <returns>A string that represents the current object.</returns>
+			virtual String^ ToString() override;
+
+			/// <summary>
+			/// Gets or sets the default capacity.
+			/// </summary>
+			/// <remarks>Defaults to 1024</remarks>
+			static property int CapacityDefault { 
+				int get() { return capacityDefault; }
+				void set(int value) { capacityDefault = value; }
+			}
+
+		internal:
+
+			property bool IsFull {
+				bool get( ) {
+					return count >= capacity;
+				}
+			}
+
+			void Add( const Common::Cell& cell );
+
+			/// <summary>
+			/// Gets the column family of the cell at the specified index, interned by the specified string cache.
+			/// </summary>
+			String^ GetColumnFamily( int index, StringCache^ stringCache );
+
+			/// <summary>
+			/// Gets the column qualifier of the cell at the specified index, interned by the specified string cache.
+			/// </summary>
+			String^ GetColumnQualifier( int index, StringCache^ stringCache );
+
+		private:
+
+			void CheckIndex( int index );
+			int Append( cli::array<Byte>^% buffer, int% length, const void* p, int len );
+			String^ Decode( int offset, int length );
+			String^ Intern( StringCache^ stringCache, int offset, int length );
+
+			int capacity;
+			int count;
+
+			cli::array<Byte>^ keys;
+			int keysLength;
+			cli::array<Byte>^ values;
+			int valuesLength;
+
+			cli::array<int>^ keyOffsets; // row, column family, column qualifier (-1 if null), end
+			cli::array<int>^ valueOffsets;
+			cli::array<UInt64>^ timestamps;
+			cli::array<Byte>^ flags;
+
+			static int capacityDefault = 1024;
+	};
+
+}
@@ -26,6 +26,7 @@
 #include "ColumnPredicate.h"
 #include "RowInterval.h"
 #include "CellInterval.h"
+#include "IValueCodec.h"
 #include "Exception.h"
 #include "CM2U8.h"
 
@@ -81,6 +82,16 @@ namespace Hypertable {
 
 	ScanSpec::ScanSpec( ScanSpec^ scanSpec ) {
 		if( scanSpec == nullptr ) throw gcnew ArgumentNullException( L"scanSpec" );
+		CopyFrom( scanSpec, true );
+	}
+
+	ScanSpec^ ScanSpec::CopyWithoutRows( ) {
+		ScanSpec^ scanSpec = gcnew ScanSpec();
+		scanSpec->CopyFrom( this, false );
+		return scanSpec;
+	}
+
+	void ScanSpec::CopyFrom( ScanSpec^ scanSpec, bool copyRows ) {
 		MaxRows = scanSpec->MaxRows;
 		MaxVersions = scanSpec->MaxVersions;
 		MaxCells = scanSpec->MaxCells;
@@ -96,28 +107,34 @@ namespace Hypertable {
 		RowRegex = scanSpec->RowRegex;
 		ValueRegex = scanSpec->ValueRegex;
 		Timeout = scanSpec->Timeout;
+		ConsumerTimeout = scanSpec->ConsumerTimeout;
 		Flags = scanSpec->Flags;
+		if( scanSpec->ValueCodecs != nullptr ) {
+			ValueCodecs = gcnew Dictionary<String^, IValueCodec^>( scanSpec->ValueCodecs );
+		}
 		isSorted = scanSpec->isSorted;
 
-		if( scanSpec->rows != nullptr ) {
-			AddRow(scanSpec->rows);
-		}
 		if( scanSpec->columns != nullptr ) {
 			AddColumn(scanSpec->columns);
 		}
-		if( scanSpec->keys != nullptr ) {
-			AddCell(scanSpec->keys);
-		}
 		if( scanSpec->columnPredicates != nullptr ) {
 			AddColumnPredicate(scanSpec->columnPredicates);
 		}
+		if( !copyRows ) {
+			return;
+		}
+		if( scanSpec->rows != nullptr ) {
+			AddRow(scanSpec->rows);
+		}
+		if( scanSpec->keys != nullptr ) {
+			AddCell(scanSpec->keys);
+		}
 		if( scanSpec->rowIntervals != nullptr ) {
 			AddRowInterval(scanSpec->rowIntervals);
 		}
 		if( scanSpec->cellIntervals != nullptr ) {
 			AddCellInterval(scanSpec->cellIntervals);
 		}
-
 	}
 
 	DateTime ScanSpec::StartDateTime::get( ) {
@@ -471,6 +488,7 @@ namespace Hypertable {
 		APPEND_STRING( RowRegex )
 		APPEND_STRING( ValueRegex )
 		APPEND_TIMESPAN( Timeout )
+		APPEND_TIMESPAN( ConsumerTimeout )
 		APPEND_INT( RowCount )
 		APPEND_INT( ColumnCount )
 		if( ColumnCount > 0 ) {
@@ -494,6 +512,7 @@ namespace Hypertable {
 		APPEND_INT( CellCount )
 		APPEND_INT( RowIntervalCount )
 		APPEND_INT( CellIntervalCount )
+		if( ValueCodecs != nullptr && ValueCodecs->Count > 0 ) sb->Append( String::Format(CultureInfo::InvariantCulture, L"ValueCodecs={0}, ", ValueCodecs->Count) );
 		sb->Append( String::Format(CultureInfo::InvariantCulture, L"Flags={0}", Flags) );
 		sb->Append( L")" );
 
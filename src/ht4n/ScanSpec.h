@@ -45,6 +45,7 @@ namespace Hypertable {
 	ref class RowInterval;
 	ref class CellInterval;
 	ref class ColumnPredicate;
+	interface class IValueCodec;
 
 	/// <summary>
 	/// Represents a table scanner specification.
@@ -274,11 +275,28 @@ namespace Hypertable {
 			/// </summary>
 			property TimeSpan Timeout;
 
+			/// <summary>
+			/// Gets or sets the maximum time an asynchronous scan waits for a consumer which does not keep up before the scan
+			/// fails with a TimeoutException, if zero the scan waits until the enumerator gets disposed or cancelled.
+			/// </summary>
+			/// <remarks>Managed only, applies to ITable.ScanAsync and ITable.ScanBatchesAsync.</remarks>
+			property TimeSpan ConsumerTimeout;
+
 			/// <summary>
 			/// Gets or sets the table scanner flags.
 			/// </summary>
 			property ScannerFlags Flags;
 
+			/// <summary>
+			/// Gets or sets the value codecs by column family, used to decode values written by a mutator with value codecs.
+			/// </summary>
+			/// <remarks>
+			/// Values without a codec header are read verbatim, so column families can be switched to a codec at any time.
+			/// </remarks>
+			/// <seealso cref="IValueCodec"/>
+			/// <seealso cref="MutatorSpec.ValueCodecs"/>
+			property IDictionary<String^, IValueCodec^>^ ValueCodecs;
+
 			/// <summary>
 			/// Gets the number of rows.
 			/// </summary>
@@ -596,8 +614,15 @@ namespace Hypertable {
 
 			void To( Common::ScanSpec& scanSpec );
 
+			/// <summary>
+			/// Returns a copy of this scan specification without rows, cells, row intervals and cell intervals.
+			/// </summary>
+			ScanSpec^ CopyWithoutRows( );
+
 		private:
 
+			void CopyFrom( ScanSpec^ scanSpec, bool copyRows );
+
 			generic< typename T > inline
 			ICollection<T>^ CreateCollection( ) {
 				return  isSorted
@@ -58,7 +58,21 @@ namespace Hypertable {
 		/// <summary>
 		/// Do not refresh table cache automatically.
 		/// </summary>
-		NoAutoTableRefresh = ht4c::Common::SF_NoAutoTableRefresh
+		NoAutoTableRefresh = ht4c::Common::SF_NoAutoTableRefresh,
+
+		/// <summary>
+		/// Intern column families and column qualifiers per scanner, repeated values are returned as the same string instance.
+		/// </summary>
+		/// <remarks>Managed only, the flag will not be passed to the native scanner.</remarks>
+		InternStrings = 0x10000,
+
+		/// <summary>
+		/// Prefetch the cells by a background task into a bounded buffer of native chunks, the native fetch overlaps
+		/// with the processing of the previous chunk.
+		/// </summary>
+		/// <remarks>Managed only, the flag will not be passed to the native scanner.</remarks>
+		/// <seealso cref="ScannerStatistics"/>
+		Prefetch = 0x20000
 	};
 
 }
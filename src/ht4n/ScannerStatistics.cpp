@@ -0,0 +1,88 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#include "stdafx.h"
+
+#include "ScannerStatistics.h"
+
+namespace Hypertable {
+	using namespace System;
+	using namespace System::Text;
+	using namespace System::Threading;
+	using namespace System::Globalization;
+
+	String^ ScannerStatistics::ToString() {
+
+		#define APPEND_INT( what ) if( what > 0 ) sb->Append( String::Format(CultureInfo::InvariantCulture, L#what L"={0}, ", what) );
+
+		StringBuilder^ sb = gcnew StringBuilder();
+		sb->Append( GetType() );
+		sb->Append( L"(" );
+
+		APPEND_INT( BufferedChunks )
+		APPEND_INT( BufferCapacity )
+		APPEND_INT( Chunks )
+		APPEND_INT( FetchedCells )
+		APPEND_INT( Stalls )
+		if( StallTime.Ticks > 0 ) sb->Append( String::Format(CultureInfo::InvariantCulture, L"StallTime={0}, ", StallTime) );
+		APPEND_INT( Partitions )
+		if( sb[sb->Length - 1] == L' ' ) {
+			sb->Length -= 2;
+		}
+		sb->Append( L")" );
+
+		return sb->ToString();
+
+		#undef APPEND_INT
+	}
+
+	ScannerStatistics::ScannerStatistics( int _bufferCapacity )
+	: bufferedChunks( 0 )
+	, bufferCapacity( _bufferCapacity )
+	, chunks( 0 )
+	, fetchedCells( 0 )
+	, stalls( 0 )
+	, stallTicks( 0 )
+	, partitions( 0 )
+	{
+	}
+
+	void ScannerStatistics::AddChunk( int cells ) {
+		Interlocked::Increment( bufferedChunks );
+		Interlocked::Increment( chunks );
+		Interlocked::Add( fetchedCells, cells );
+	}
+
+	void ScannerStatistics::RemoveChunk( ) {
+		Interlocked::Decrement( bufferedChunks );
+	}
+
+	void ScannerStatistics::AddStall( Int64 elapsedTicks ) {
+		Interlocked::Increment( stalls );
+		Interlocked::Add( stallTicks, elapsedTicks );
+	}
+
+	void ScannerStatistics::SetPartitions( int _partitions ) {
+		partitions = _partitions;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,151 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#pragma once
+
+#ifndef __cplusplus_cli
+#error "requires /clr"
+#endif
+
+namespace Hypertable {
+	using namespace System;
+
+	/// <summary>
+	/// Represents table scanner statistics.
+	/// </summary>
+	/// <remarks>
+	/// The statistics are updated while the scanner is in use, the values reflect the
+	/// current state. Values which are not applicable to the scanner remain zero.
+	/// </remarks>
+	/// <example>
+	/// The following example shows how to monitor a prefetching scanner.
+	/// <code>
+	/// using( var scanner = table.CreateScanner(new ScanSpec { Flags = ScannerFlags.Prefetch }) ) {
+	///    // do something
+	///    Trace.WriteLine( scanner.Statistics );
+	/// }
+	/// </code>
+	/// </example>
+	/// <seealso cref="ITableScanner"/>
+	public ref class ScannerStatistics sealed {
+
+		public:
+
+			/// <summary>
+			/// Gets the number of prefetched chunks not yet consumed, only for prefetching and parallel scanners.
+			/// </summary>
+			property Int64 BufferedChunks {
+				Int64 get( ) {
+					return Threading::Interlocked::Read( bufferedChunks );
+				}
+			}
+
+			/// <summary>
+			/// Gets the maximum number of prefetched chunks, only for prefetching and parallel scanners.
+			/// </summary>
+			property int BufferCapacity {
+				int get( ) {
+					return bufferCapacity;
+				}
+			}
+
+			/// <summary>
+			/// Gets the buffer occupancy between 0 and 1, only for prefetching and parallel scanners.
+			/// </summary>
+			property double BufferOccupancy {
+				double get( ) {
+					return bufferCapacity > 0 ? static_cast<double>( BufferedChunks ) / bufferCapacity : 0.0;
+				}
+			}
+
+			/// <summary>
+			/// Gets the number of chunks fetched from the native scanners, only for prefetching and parallel scanners.
+			/// </summary>
+			property Int64 Chunks {
+				Int64 get( ) {
+					return Threading::Interlocked::Read( chunks );
+				}
+			}
+
+			/// <summary>
+			/// Gets the number of cells fetched from the native scanners, only for prefetching and parallel scanners.
+			/// </summary>
+			property Int64 FetchedCells {
+				Int64 get( ) {
+					return Threading::Interlocked::Read( fetchedCells );
+				}
+			}
+
+			/// <summary>
+			/// Gets the number of times the consumer had to wait for a prefetched chunk.
+			/// </summary>
+			property Int64 Stalls {
+				Int64 get( ) {
+					return Threading::Interlocked::Read( stalls );
+				}
+			}
+
+			/// <summary>
+			/// Gets the total time the consumer has been waiting for prefetched chunks.
+			/// </summary>
+			property TimeSpan StallTime {
+				TimeSpan get( ) {
+					return TimeSpan::FromTicks( static_cast<Int64>(Threading::Interlocked::Read(stallTicks) * (static_cast<double>(TimeSpan::TicksPerSecond) / Diagnostics::Stopwatch::Frequency)) );
+				}
+			}
+
+			/// <summary>
+			/// Gets the number of row partitions, only for parallel scanners.
+			/// </summary>
+			property int Partitions {
+				int get( ) {
+					return partitions;
+				}
+			}
+
+			/// <summary>
+			/// Returns a string that represents the current object.
+			/// </summary>
+			/// <returns>A string that represents the current object.</returns>
+			virtual String^ ToString() override;
+
+		internal:
+
+			ScannerStatistics( int bufferCapacity );
+
+			void AddChunk( int cells );
+			void RemoveChunk( );
+			void AddStall( Int64 elapsedTicks );
+			void SetPartitions( int partitions );
+
+		private:
+
+			Int64 bufferedChunks;
+			int bufferCapacity;
+			Int64 chunks;
+			Int64 fetchedCells;
+			Int64 stalls;
+			Int64 stallTicks;
+			int partitions;
+	};
+
+}
\ No newline at end of file
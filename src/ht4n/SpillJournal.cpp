@@ -0,0 +1,158 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#include "stdafx.h"
+
+#include "SpillJournal.h"
+#include "Cell.h"
+#include "Key.h"
+
+namespace Hypertable {
+	using namespace System;
+	using namespace System::IO;
+	using namespace System::Text;
+
+	SpillJournal::~SpillJournal( ) {
+		msclr::lock sync( syncRoot );
+		if( stream != nullptr ) {
+			delete reader;
+			delete recordWriter;
+			delete stream;
+			stream = nullptr;
+		}
+	}
+
+	SpillJournal::SpillJournal( String^ path )
+	: readPosition( 0 )
+	, writePosition( 0 )
+	, count( 0 )
+	, syncRoot( gcnew Object() )
+	{
+		if( String::IsNullOrEmpty(path) ) throw gcnew ArgumentNullException( L"path" );
+
+		stream = gcnew FileStream( path, FileMode::OpenOrCreate, FileAccess::ReadWrite, FileShare::None, 64 * 1024 );
+		reader = gcnew BinaryReader( stream, Encoding::UTF8, true );
+		record = gcnew MemoryStream();
+		recordWriter = gcnew BinaryWriter( record, Encoding::UTF8 );
+
+		// recover the records left behind, discard an incomplete record at the end
+		Int64 length = stream->Length;
+		while( writePosition + prefixSize <= length ) {
+			stream->Seek( writePosition, SeekOrigin::Begin );
+			int recordLength = reader->ReadInt32();
+			if( recordLength < 0 || writePosition + prefixSize + recordLength > length ) {
+				break;
+			}
+			writePosition += prefixSize + recordLength;
+			++count;
+		}
+		if( writePosition < length ) {
+			stream->SetLength( writePosition );
+		}
+	}
+
+	void SpillJournal::Append( Cell^ cell ) {
+		msclr::lock sync( syncRoot );
+		stream->Seek( writePosition, SeekOrigin::Begin );
+		Write( cell );
+		stream->Flush();
+	}
+
+	void SpillJournal::Append( List<Cell^>^ cells, int start, int end ) {
+		msclr::lock sync( syncRoot );
+		stream->Seek( writePosition, SeekOrigin::Begin );
+		for( int n = start; n < end; ++n ) {
+			Write( cells[n] );
+		}
+		stream->Flush();
+	}
+
+	int SpillJournal::Read( List<Cell^>^ cells, int maxCount ) {
+		msclr::lock sync( syncRoot );
+		stream->Seek( readPosition, SeekOrigin::Begin );
+		int n = 0;
+		for( ; n < maxCount && readPosition < writePosition; ++n ) {
+			int recordLength = reader->ReadInt32();
+			Key^ key = gcnew Key();
+			key->Row = ReadString();
+			key->ColumnFamily = ReadString();
+			key->ColumnQualifier = ReadString();
+			key->Timestamp = reader->ReadUInt64();
+			CellFlag flag = static_cast<CellFlag>( reader->ReadByte() );
+			int valueLength = reader->ReadInt32();
+			cli::array<Byte>^ value = valueLength >= 0 ? reader->ReadBytes( valueLength ) : nullptr;
+			cells->Add( gcnew Cell(key, value, flag) );
+			readPosition += prefixSize + recordLength;
+		}
+		count -= n;
+		return n;
+	}
+
+	void SpillJournal::Truncate( ) {
+		msclr::lock sync( syncRoot );
+		stream->SetLength( 0 );
+		stream->Flush();
+		readPosition = 0;
+		writePosition = 0;
+		count = 0;
+	}
+
+	void SpillJournal::Write( Cell^ cell ) {
+		// length prefix, key, flag and value
+		record->SetLength( 0 );
+		recordWriter->Write( 0 );
+		Key^ key = cell->Key;
+		WriteString( key->Row );
+		WriteString( key->ColumnFamily );
+		WriteString( key->ColumnQualifier );
+		recordWriter->Write( key->Timestamp );
+		recordWriter->Write( static_cast<Byte>(cell->Flag) );
+		if( cell->Value != nullptr ) {
+			recordWriter->Write( cell->Value->Length );
+			recordWriter->Write( cell->Value );
+		}
+		else {
+			recordWriter->Write( -1 );
+		}
+		recordWriter->Flush();
+		int length = static_cast<int>( record->Length );
+		record->Position = 0;
+		recordWriter->Write( length - prefixSize );
+		recordWriter->Flush();
+
+		stream->Write( record->GetBuffer(), 0, length );
+		writePosition += length;
+		++count;
+	}
+
+	void SpillJournal::WriteString( String^ s ) {
+		recordWriter->Write( s != nullptr );
+		if( s != nullptr ) {
+			recordWriter->Write( s );
+		}
+	}
+
+	String^ SpillJournal::ReadString( ) {
+		return reader->ReadBoolean() ? reader->ReadString() : nullptr;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#pragma once
+
+#ifndef __cplusplus_cli
+#error "requires /clr"
+#endif
+
+namespace Hypertable {
+	using namespace System;
+	using namespace System::Collections::Generic;
+
+	ref class Cell;
+
+	/// <summary>
+	/// Represents an append-only journal of length-prefixed cell records.
+	/// </summary>
+	/// <remarks>
+	/// Records are appended at the end and read in order from the read position, the journal
+	/// will be truncated once all records have been read. Records left behind by a crashed process
+	/// are recovered on open, an incomplete record at the end is discarded.
+	/// </remarks>
+	/// <seealso cref="QueuedTableMutator"/>
+	ref class SpillJournal sealed {
+
+		public:
+
+			/// <summary>
+			/// Clean up all managed resources.
+			/// </summary>
+			~SpillJournal( );
+
+		internal:
+
+			SpillJournal( String^ path );
+
+			/// <summary>
+			/// Gets the number of records not yet read.
+			/// </summary>
+			property int Count {
+				int get( ) {
+					return count;
+				}
+			}
+
+			/// <summary>
+			/// Gets a value indicating whether all records have been read.
+			/// </summary>
+			property bool IsDrained {
+				bool get( ) {
+					return readPosition == writePosition;
+				}
+			}
+
+			void Append( Cell^ cell );
+			void Append( List<Cell^>^ cells, int start, int end );
+			int Read( List<Cell^>^ cells, int maxCount );
+			void Truncate( );
+
+		private:
+
+			void Write( Cell^ cell );
+			void WriteString( String^ s );
+			String^ ReadString( );
+
+			IO::FileStream^ stream;
+			IO::BinaryReader^ reader;
+			IO::MemoryStream^ record;
+			IO::BinaryWriter^ recordWriter;
+			Int64 readPosition;
+			Int64 writePosition;
+			int count;
+			Object^ syncRoot;
+
+			static const int prefixSize = sizeof(int);
+	};
+
+}
\ No newline at end of file
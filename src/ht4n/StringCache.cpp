@@ -0,0 +1,87 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#include "stdafx.h"
+
+#include "StringCache.h"
+#include "CM2U8.h"
+
+namespace Hypertable {
+	using namespace System;
+
+	StringCache::StringCache( )
+	: buckets( gcnew cli::array<Entry^>(bucketCount) )
+	, count( 0 )
+	{
+	}
+
+	String^ StringCache::Get( const char* sz ) {
+		return Get( sz, static_cast<int>(strlen(sz)) );
+	}
+
+	String^ StringCache::Get( const char* sz, int len ) {
+		if( len > maxLength ) {
+			return CM2U8::ToString( sz, len );
+		}
+
+		// FNV-1a
+		UInt32 hash = 2166136261;
+		for( int n = 0; n < len; ++n ) {
+			hash = (hash ^ static_cast<unsigned char>(sz[n])) * 16777619;
+		}
+
+		int bucket = static_cast<int>( hash & (bucketCount - 1) );
+		for( Entry^ entry = buckets[bucket]; entry != nullptr; entry = entry->next ) {
+			if( entry->hash == hash && entry->bytes->Length == len ) {
+				if( len == 0 ) {
+					return entry->value;
+				}
+				pin_ptr<Byte> pb = &entry->bytes[0];
+				if( memcmp(pb, sz, len) == 0 ) {
+					return entry->value;
+				}
+			}
+		}
+
+		String^ value = CM2U8::ToString( sz, len );
+		if( count < maxEntries ) {
+			Entry^ entry = gcnew Entry();
+			entry->bytes = gcnew cli::array<Byte>( len );
+			if( len > 0 ) {
+				pin_ptr<Byte> pb = &entry->bytes[0];
+				memcpy( pb, sz, len );
+			}
+			entry->value = value;
+			entry->hash = hash;
+			entry->next = buckets[bucket];
+			buckets[bucket] = entry;
+			++count;
+		}
+		return value;
+	}
+
+	void StringCache::Clear( ) {
+		Array::Clear( buckets, 0, buckets->Length );
+		count = 0;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#pragma once
+
+#ifndef __cplusplus_cli
+#error "requires /clr"
+#endif
+
+namespace Hypertable {
+	using namespace System;
+
+	/// <summary>
+	/// Represents a cache of decoded strings, keyed on the utf8 encoded bytes.
+	/// </summary>
+	/// <remarks>
+	/// Returns the same string instance for repeated utf8 strings, used to intern column families
+	/// and column qualifiers while scanning. The number of cached strings is limited, strings not fitting
+	/// into the cache are decoded as usual. The class is not thread safe.
+	/// </remarks>
+	ref class StringCache sealed {
+
+		internal:
+
+			StringCache( );
+
+			String^ Get( const char* sz );
+			String^ Get( const char* p, int len );
+			void Clear( );
+
+		private:
+
+			ref class Entry sealed {
+
+				internal:
+
+					cli::array<Byte>^ bytes;
+					String^ value;
+					UInt32 hash;
+					Entry^ next;
+			};
+
+			cli::array<Entry^>^ buckets;
+			int count;
+
+			static const int bucketCount = 1024;
+			static const int maxEntries = 4096;
+			static const int maxLength = 256;
+	};
+
+}
\ No newline at end of file
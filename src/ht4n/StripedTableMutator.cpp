@@ -0,0 +1,270 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+#include "stdafx.h"
+
+#include "StripedTableMutator.h"
+#include "Key.h"
+#include "Cell.h"
+#include "Exception.h"
+#include "CM2U8.h"
+#include "MutatorStatistics.h"
+#include "ValueCodecMap.h"
+#include "HypertableEventSource.h"
+#include "ChunkRegistry.h"
+
+#include "ht4c.Common/TableMutator.h"
+#include "ht4c.Common/Cells.h"
+#include "ht4c.Common/KeyBuilder.h"
+
+namespace Hypertable {
+	using namespace System;
+	using namespace System::Diagnostics;
+
+	StripedTableMutator::~StripedTableMutator( ) {
+		try {
+			HT4N_TRY {
+				if( stripes != nullptr ) {
+					// pass the pending chunks, the managed state is only accessible on dispose
+					CollectStripes();
+					msclr::lock sync( syncRoot );
+					SetChunks();
+				}
+			}
+			HT4N_RETHROW
+		}
+		finally {
+			delete stripes;
+			stripes = nullptr;
+			GC::SuppressFinalize(this);
+			this->!StripedTableMutator();
+		}
+	}
+
+	StripedTableMutator::!StripedTableMutator( ) {
+		// the registry owns all chunks, whether striped, queued or pooled
+		if( chunkRegistry ) {
+			delete chunkRegistry;
+			chunkRegistry = 0;
+		}
+	}
+
+	void StripedTableMutator::Set( Key^ key, cli::array<Byte>^ value, bool createRowKey ) {
+		if( key == nullptr ) throw gcnew ArgumentNullException( L"key" );
+		if( createRowKey || String::IsNullOrEmpty(key->Row) ) {
+			key->Row = gcnew String( Common::KeyBuilder().c_str() );
+		}
+		HT4N_TRY {
+			AddCell( key, value, CellFlag::Default );
+		}
+		HT4N_RETHROW
+	}
+
+	void StripedTableMutator::Set( Cell^ cell, bool createRowKey ) {
+		if( cell == nullptr ) throw gcnew ArgumentNullException( L"cell" );
+		Key^ key = cell->Key;
+		if( key == nullptr ) throw gcnew ArgumentException( L"Invalid parameter cell (cell.Key null)", L"cell" );
+		if( createRowKey || String::IsNullOrEmpty(key->Row) ) {
+			key->Row = gcnew String( Common::KeyBuilder().c_str() );
+		}
+		HT4N_TRY {
+			AddCell( key, cell->Value, cell->Flag );
+		}
+		HT4N_RETHROW
+	}
+
+	void StripedTableMutator::Set( IEnumerable<Cell^>^ cells, bool createRowKey ) {
+		if( cells == nullptr ) throw gcnew ArgumentNullException( L"cells" );
+		HT4N_TRY {
+			for each( Cell^ cell in cells ) {
+				if( cell != nullptr ) {
+					Key^ key = cell->Key;
+					if( key != nullptr ) {
+						if( createRowKey || String::IsNullOrEmpty(key->Row) ) {
+							key->Row = gcnew String( Common::KeyBuilder().c_str() );
+						}
+						AddCell( key, cell->Value, cell->Flag );
+					}
+				}
+			}
+		}
+		HT4N_RETHROW
+	}
+
+	void StripedTableMutator::Delete( String^ row ) {
+		if( String::IsNullOrEmpty(row) ) throw gcnew ArgumentException( L"Invalid parameter row (null or empty)", L"row" );
+		Set( gcnew Cell(gcnew Key(row), CellFlag::DeleteRow) );
+	}
+
+	void StripedTableMutator::Delete( Key^ key ) {
+		if( key == nullptr ) throw gcnew ArgumentNullException( L"key" );
+		Set( gcnew Cell(key, Cell::DeleteFlagFromKey(key), true) );
+	}
+
+	void StripedTableMutator::Delete( IEnumerable<Key^>^ keys ) {
+		if( keys == nullptr ) throw gcnew ArgumentNullException( L"keys" );
+		for each( Key^ key in keys ) {
+			if( key != nullptr ) {
+				Delete( key );
+			}
+		}
+	}
+
+	void StripedTableMutator::Delete( IEnumerable<Cell^>^ cells ) {
+		if( cells == nullptr ) throw gcnew ArgumentNullException( L"cells" );
+		for each( Cell^ cell in cells ) {
+			if( cell != nullptr && cell->Key != nullptr ) {
+				Delete( cell->Key );
+			}
+		}
+	}
+
+	void StripedTableMutator::Flush( ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		HT4N_TRY {
+			CollectStripes();
+			msclr::lock sync( syncRoot );
+			SetChunks();
+			Int64 started = HypertableEventSource::Start();
+			tableMutator->flush();
+			HypertableEventSource::Flushed( started );
+		}
+		HT4N_RETHROW
+	}
+
+	StripedTableMutator::StripedTableMutator( Common::TableMutator* _tableMutator, UInt32 _maxChunkSize, UInt32 _maxCellCount, ValueCodecMap^ _valueCodecs )
+	: TableMutator( _tableMutator, 0, _valueCodecs )
+	, chunks( gcnew ConcurrentQueue<QueuedChunk>() )
+	, chunkPool( gcnew ConcurrentQueue<IntPtr>() )
+	, chunkRegistry( new ChunkRegistry() )
+	, maxChunkSize( _maxChunkSize )
+	, maxCellCount( _maxCellCount )
+	, maxQueuedChunks( 2 * Environment::ProcessorCount )
+	{
+		stripes = gcnew ThreadLocal<Stripe^>( gcnew Func<Stripe^>(this, &StripedTableMutator::CreateStripe), true );
+	}
+
+	StripedTableMutator::Stripe^ StripedTableMutator::CreateStripe( ) {
+		Stripe^ stripe = gcnew Stripe();
+		stripe->cellChunk = RentChunk();
+		stripe->lenTotal = 0;
+		return stripe;
+	}
+
+	void StripedTableMutator::AddCell( Key^ key, cli::array<Byte>^ value, CellFlag cellFlag ) {
+		Stripe^ stripe = stripes->Value;
+		Common::Cells* chunk = 0;
+		UInt32 len = 0;
+		cli::array<Byte>^ buffer = nullptr;
+		try {
+			int encodedLength = Encode( key, value, buffer );
+			// the stripe is only contended by concurrent flushes
+			msclr::lock sync( stripe );
+			stripe->lenTotal += Add( stripe->cellChunk, key, value, cellFlag, buffer, encodedLength );
+			if( stripe->lenTotal >= maxChunkSize || stripe->cellChunk->size() >= maxCellCount ) {
+				chunk = stripe->cellChunk;
+				len = stripe->lenTotal;
+				stripe->cellChunk = RentChunk();
+				stripe->lenTotal = 0;
+			}
+		}
+		finally {
+			ValueCodecMap::Release( buffer );
+		}
+		if( chunk ) {
+			EnqueueChunk( chunk, len );
+		}
+	}
+
+	void StripedTableMutator::CollectStripes( ) {
+		for each( Stripe^ stripe in stripes->Values ) {
+			msclr::lock sync( stripe );
+			if( stripe->cellChunk->size() ) {
+				QueuedChunk queued;
+				queued.cells = IntPtr( stripe->cellChunk );
+				queued.len = stripe->lenTotal;
+				chunks->Enqueue( queued );
+				stripe->cellChunk = RentChunk();
+				stripe->lenTotal = 0;
+			}
+		}
+	}
+
+	void StripedTableMutator::EnqueueChunk( Common::Cells* chunk, UInt32 len ) {
+		QueuedChunk queued;
+		queued.cells = IntPtr( chunk );
+		queued.len = len;
+		chunks->Enqueue( queued );
+		if( chunks->Count > maxQueuedChunks ) {
+			// throttle the producers if the native mutator falls behind
+			msclr::lock sync( syncRoot );
+			SetChunks();
+		}
+		else {
+			// pass the queued chunks unless another thread already does so
+			while( !chunks->IsEmpty && Monitor::TryEnter(syncRoot) ) {
+				try {
+					SetChunks();
+				}
+				finally {
+					Monitor::Exit( syncRoot );
+				}
+			}
+		}
+	}
+
+	void StripedTableMutator::SetChunks( ) {
+		QueuedChunk queued;
+		while( chunks->TryDequeue(queued) ) {
+			Common::Cells* chunk = static_cast<Common::Cells*>( queued.cells.ToPointer() );
+			try {
+				Int64 started = Stopwatch::GetTimestamp();
+				HypertableEventSource::Written( *chunk );
+				tableMutator->set( *chunk );
+				Int64 elapsedTicks = Stopwatch::GetTimestamp() - started;
+				if( HypertableEventSource::IsInstrumented ) {
+					HypertableEventSource::ChunkSent( started );
+				}
+				statistics->AddChunk( maxChunkSize, elapsedTicks > 0 ? static_cast<double>(queued.len) * Stopwatch::Frequency / elapsedTicks : 0.0 );
+			}
+			finally {
+				ReleaseChunk( chunk );
+			}
+		}
+	}
+
+	Common::Cells* StripedTableMutator::RentChunk( ) {
+		IntPtr chunk;
+		return chunkPool->TryDequeue( chunk ) ? static_cast<Common::Cells*>( chunk.ToPointer() ) : chunkRegistry->create( __min(maxCellCount, 64 * 1024) );
+	}
+
+	void StripedTableMutator::ReleaseChunk( Common::Cells* chunk ) {
+		chunk->clear();
+		if( chunkPool->Count < maxQueuedChunks ) {
+			chunkPool->Enqueue( IntPtr(chunk) );
+		}
+		else {
+			chunkRegistry->destroy( chunk );
+		}
+	}
+
+}
\ No newline at end of file
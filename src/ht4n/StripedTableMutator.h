@@ -0,0 +1,116 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+#pragma once
+
+#ifndef __cplusplus_cli
+#error "requires /clr"
+#endif
+
+#include "TableMutator.h"
+
+namespace ht4c { namespace Common {
+	class Cells;
+} }
+
+namespace Hypertable {
+	class ChunkRegistry;
+}
+
+namespace Hypertable {
+	using namespace System;
+	using namespace System::Threading;
+	using namespace System::Collections::Concurrent;
+	using namespace ht4c;
+
+	/// <summary>
+	/// Represents a striped table mutator.
+	/// </summary>
+	/// <remarks>
+	/// Each thread appends to its own chunk of cells, full chunks are passed to the native
+	/// mutator through a lock-free queue by whichever thread acquires the mutator first.
+	/// </remarks>
+	/// <seealso cref="ITableMutator"/>
+	ref class StripedTableMutator sealed : public TableMutator {
+
+		public:
+
+			/// <summary>
+			/// Clean up all managed and unmanaged resources.
+			/// </summary>
+			virtual ~StripedTableMutator( );
+
+			/// <summary>
+			/// Clean up all unmanaged resources.
+			/// </summary>
+			!StripedTableMutator( );
+
+			#pragma region ITableMutator methods
+
+			virtual void Set( Key^ key, cli::array<Byte>^ value, bool createRowKey ) override;
+			virtual void Set( Cell^ cell, bool createRowKey ) override;
+			virtual void Set( IEnumerable<Cell^>^ cells, bool createRowKey ) override;
+			virtual void Delete( String^ row ) override;
+			virtual void Delete( Key^ key ) override;
+			virtual void Delete( IEnumerable<Key^>^ keys ) override;
+			virtual void Delete( IEnumerable<Cell^>^ cells ) override;
+			virtual void Flush() override;
+
+			#pragma endregion
+
+		internal:
+
+			StripedTableMutator( Common::TableMutator* tableMutator, UInt32 maxChunkSize, UInt32 maxCellCount, ValueCodecMap^ valueCodecs );
+
+		private:
+
+			value struct QueuedChunk {
+				IntPtr cells;
+				UInt32 len;
+			};
+
+			ref class Stripe sealed {
+
+				public:
+
+					Common::Cells* cellChunk;
+					UInt32 lenTotal;
+			};
+
+			Stripe^ CreateStripe( );
+			void AddCell( Key^ key, cli::array<Byte>^ value, CellFlag cellFlag );
+			void CollectStripes( );
+			void EnqueueChunk( Common::Cells* chunk, UInt32 len );
+			void SetChunks( );
+			Common::Cells* RentChunk( );
+			void ReleaseChunk( Common::Cells* chunk );
+
+			ThreadLocal<Stripe^>^ stripes;
+			ConcurrentQueue<QueuedChunk>^ chunks;
+			ConcurrentQueue<IntPtr>^ chunkPool;
+			ChunkRegistry* chunkRegistry;
+
+			const UInt32 maxChunkSize;
+			const UInt32 maxCellCount;
+			const int maxQueuedChunks;
+	};
+
+}
\ No newline at end of file
@@ -25,9 +25,19 @@
 #include "MutatorSpec.h"
 #include "TableMutator.h"
 #include "ChunkedTableMutator.h"
+#include "StripedTableMutator.h"
 #include "QueuedTableMutator.h"
+#include "PartitionedTableMutator.h"
+#include "MutatorStatistics.h"
+#include "ValueCodecMap.h"
+#include "BulkLoadOptions.h"
+#include "BulkLoadStatistics.h"
+#include "BulkLoader.h"
 #include "ScanSpec.h"
 #include "TableScanner.h"
+#include "ParallelTableScanner.h"
+#include "AsyncScanEnumerable.h"
+#include "AsyncRowGrouper.h"
 #include "AsyncResult.h"
 #include "BlockingAsyncResult.h"
 #include "AsyncScannerContext.h"
@@ -106,23 +116,39 @@ namespace Hypertable {
 
 				flags = (uint32_t) mutatorSpec->Flags;
 
+				if( mutatorSpec->Queued && mutatorSpec->Consumers > 1 ) {
+					return CreatePartitionedMutator( mutatorSpec );
+				}
+
+				cli::array<String^>^ counterColumnFamilies = CounterColumnFamilies( mutatorSpec );
 				ITableMutator^ mutator = nullptr;
 				switch( mutatorSpec->MutatorKind ) {
 					case MutatorKind::Default:
-						mutator = gcnew TableMutator( table->createMutator(timeout, flags, flushInterval) );
+						mutator = gcnew TableMutator( table->createMutator(timeout, flags, flushInterval), mutatorSpec->MaxBufferedCells, ValueCodecMap::Create(mutatorSpec->ValueCodecs) );
 						break;
 					case MutatorKind::Chunked:
-						mutator = gcnew ChunkedTableMutator( table->createMutator(timeout, flags, flushInterval), mutatorSpec->MaxChunkSize, mutatorSpec->MaxCellCount, mutatorSpec->FlushEachChunk );
+						mutator = gcnew ChunkedTableMutator( table->createMutator(timeout, flags, flushInterval), mutatorSpec->MaxChunkSize, mutatorSpec->MaxCellCount, mutatorSpec->FlushEachChunk, mutatorSpec->AdaptiveChunkSize, mutatorSpec->MinChunkSize, mutatorSpec->TargetChunkLatency, mutatorSpec->Queued ? 0 : mutatorSpec->MaxPendingBytes, mutatorSpec->SortChunks, mutatorSpec->Coalesce, counterColumnFamilies, ValueCodecMap::Create(mutatorSpec->ValueCodecs) );
+						break;
+					case MutatorKind::Striped:
+						mutator = gcnew StripedTableMutator( table->createMutator(timeout, flags, flushInterval), mutatorSpec->MaxChunkSize, mutatorSpec->MaxCellCount, ValueCodecMap::Create(mutatorSpec->ValueCodecs) );
 						break;
 				}
 
 				if( mutatorSpec->Queued ) {
-					mutator = gcnew QueuedTableMutator( mutator, mutatorSpec->Capacity );
+					ITableMutator^ inner = mutator;
+					try {
+						mutator = gcnew QueuedTableMutator( inner, mutatorSpec->Capacity, mutatorSpec->BatchSize, mutatorSpec->MaxPendingBytes, mutatorSpec->Coalesce && mutatorSpec->MutatorKind != MutatorKind::Chunked, counterColumnFamilies, mutatorSpec->SpillPath, mutatorSpec->SpillThreshold, nullptr );
+					}
+					catch( Exception^ ) {
+						// e.g. the spill journal is in use by another mutator
+						delete inner;
+						throw;
+					}
 				}
 
 				return mutator;
 			}
-			return gcnew TableMutator( table->createMutator(timeout, flags, flushInterval) );
+			return gcnew TableMutator( table->createMutator(timeout, flags, flushInterval), MutatorSpec::MaxBufferedCellsDefault, nullptr );
 		} 
 		HT4N_RETHROW
 	}
@@ -145,23 +171,35 @@ namespace Hypertable {
 
 				flags = (uint32_t) mutatorSpec->Flags;
 
+				cli::array<String^>^ counterColumnFamilies = CounterColumnFamilies( mutatorSpec );
 				asyncMutator = table->createAsyncMutator( asyncResult->get(contextKind), timeout, flags );
 				switch( mutatorSpec->MutatorKind ) {
 					case MutatorKind::Default:
-						mutator = gcnew TableMutator( asyncMutator );
+						mutator = gcnew TableMutator( asyncMutator, mutatorSpec->MaxBufferedCells, ValueCodecMap::Create(mutatorSpec->ValueCodecs) );
 						break;
 					case MutatorKind::Chunked:
-						mutator = gcnew ChunkedTableMutator( asyncMutator, mutatorSpec->MaxChunkSize, mutatorSpec->MaxCellCount, mutatorSpec->FlushEachChunk );
+						mutator = gcnew ChunkedTableMutator( asyncMutator, mutatorSpec->MaxChunkSize, mutatorSpec->MaxCellCount, mutatorSpec->FlushEachChunk, mutatorSpec->AdaptiveChunkSize, mutatorSpec->MinChunkSize, mutatorSpec->TargetChunkLatency, mutatorSpec->Queued ? 0 : mutatorSpec->MaxPendingBytes, mutatorSpec->SortChunks, mutatorSpec->Coalesce, counterColumnFamilies, ValueCodecMap::Create(mutatorSpec->ValueCodecs) );
+						break;
+					case MutatorKind::Striped:
+						mutator = gcnew StripedTableMutator( asyncMutator, mutatorSpec->MaxChunkSize, mutatorSpec->MaxCellCount, ValueCodecMap::Create(mutatorSpec->ValueCodecs) );
 						break;
 				}
 
 				if( mutatorSpec->Queued ) {
-					mutator = gcnew QueuedTableMutator( mutator, mutatorSpec->Capacity );
+					ITableMutator^ inner = mutator;
+					try {
+						mutator = gcnew QueuedTableMutator( inner, mutatorSpec->Capacity, mutatorSpec->BatchSize, mutatorSpec->MaxPendingBytes, mutatorSpec->Coalesce && mutatorSpec->MutatorKind != MutatorKind::Chunked, counterColumnFamilies, mutatorSpec->SpillPath, mutatorSpec->SpillThreshold, nullptr );
+					}
+					catch( Exception^ ) {
+						// e.g. the spill journal is in use by another mutator
+						delete inner;
+						throw;
+					}
 				}
 			}
 			else {
 				asyncMutator = table->createAsyncMutator( asyncResult->get(contextKind), timeout, flags );
-				mutator = gcnew TableMutator( asyncMutator );
+				mutator = gcnew TableMutator( asyncMutator, MutatorSpec::MaxBufferedCellsDefault, nullptr );
 			}
 			asyncResult->AttachAsyncMutator( gcnew AsyncMutatorContext(contextKind, asyncMutator->id(), this, mutatorSpec), mutator );
 			return mutator;
@@ -174,20 +212,23 @@ namespace Hypertable {
 	}
 
 	ITableScanner^ Table::CreateScanner( ScanSpec^ scanSpec ) {
-		HT4N_THROW_OBJECTDISPOSED( );
+		if( scanSpec != nullptr && (scanSpec->Flags & ScannerFlags::Prefetch) == ScannerFlags::Prefetch ) {
+			// a single partition, scanned by one background task
+			HT4N_THROW_OBJECTDISPOSED( );
+			return gcnew ParallelTableScanner( this, scanSpec, 1, true );
+		}
+		return gcnew TableScanner( CreateTableScanner(scanSpec), scanSpec );
+	}
 
-		Common::ScanSpec* _scanSpec = 0;
-		HT4N_TRY {
-			uint32_t timeout;
-			uint32_t flags;
-			_scanSpec = From( scanSpec, timeout, flags );
+	ITableScanner^ Table::CreateParallelScanner( ScanSpec^ scanSpec, int degree ) {
+		return CreateParallelScanner( scanSpec, degree, true );
+	}
 
-			return gcnew TableScanner( table->createScanner(*_scanSpec, timeout, flags), scanSpec );
-		}
-		HT4N_RETHROW
-		finally {
-			if( _scanSpec ) delete _scanSpec;
-		}
+	ITableScanner^ Table::CreateParallelScanner( ScanSpec^ scanSpec, int degree, bool ordered ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		if( degree <= 0 ) throw gcnew ArgumentException( L"Invalid parameter degree (degree must be greater than zero)", L"degree" );
+		return gcnew ParallelTableScanner( this, scanSpec, degree, ordered );
 	}
 
 	int64_t Table::BeginScan( AsyncResult^ asyncResult ) {
@@ -236,6 +277,65 @@ namespace Hypertable {
 		return 0;
 	}
 
+	int64_t Table::BeginBlockScan( AsyncResult^ asyncResult, ScanSpec^ scanSpec, Object^ param, AsyncScanBlockCallback^ callback ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		if( asyncResult == nullptr ) throw gcnew ArgumentNullException( L"asyncResult" );
+		if( callback == nullptr ) throw gcnew ArgumentNullException( L"callback" );
+		if( dynamic_cast<BlockingAsyncResult^>(asyncResult) != nullptr ) throw gcnew ArgumentException( L"Blocking async results are not supported", L"asyncResult" );
+		Common::ScanSpec* _scanSpec = 0;
+		HT4N_TRY {
+			const Common::ContextKind contextKind = table->getContextKind();
+			uint32_t timeout;
+			uint32_t flags;
+			_scanSpec = From( scanSpec, timeout, flags );
+			int64_t asyncScannerId = table->createAsyncScannerId( *_scanSpec, asyncResult->get(contextKind), timeout, flags );
+			if( asyncScannerId ) {
+				asyncResult->AttachAsyncScanner( gcnew AsyncScannerContext(contextKind, asyncScannerId, this, scanSpec, param), callback );
+				return asyncScannerId;
+			}
+		}
+		HT4N_RETHROW
+		finally {
+			if( _scanSpec ) delete _scanSpec;
+		}
+		return 0;
+	}
+
+	int64_t Table::BeginRowScan( AsyncResult^ asyncResult, ScanSpec^ scanSpec, Object^ param, AsyncRowCallback^ callback ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		if( asyncResult == nullptr ) throw gcnew ArgumentNullException( L"asyncResult" );
+		if( callback == nullptr ) throw gcnew ArgumentNullException( L"callback" );
+		if( dynamic_cast<BlockingAsyncResult^>(asyncResult) != nullptr ) throw gcnew ArgumentException( L"Blocking async results are not supported", L"asyncResult" );
+		AsyncRowGrouper^ grouper = gcnew AsyncRowGrouper( asyncResult, callback );
+		try {
+			grouper->Id = BeginBlockScan( asyncResult, scanSpec, param, gcnew AsyncScanBlockCallback(grouper, &AsyncRowGrouper::Scanned) );
+		}
+		finally {
+			if( grouper->Id == 0 ) {
+				grouper->Detached( 0 );
+			}
+		}
+		return grouper->Id;
+	}
+
+	#ifdef NETCORE
+
+	IAsyncEnumerable<Cell^>^ Table::ScanAsync( ScanSpec^ scanSpec, Threading::CancellationToken cancellationToken ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		return gcnew AsyncScanEnumerable( this, scanSpec, cancellationToken );
+	}
+
+	IAsyncEnumerable<IReadOnlyList<Cell^>^>^ Table::ScanBatchesAsync( ScanSpec^ scanSpec, Threading::CancellationToken cancellationToken ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		return gcnew AsyncScanBatchEnumerable( this, scanSpec, cancellationToken );
+	}
+
+	#endif
+
 	Xml::TableSchema^ Table::GetTableSchema( ) {
 		HT4N_THROW_OBJECTDISPOSED( );
 
@@ -245,6 +345,27 @@ namespace Hypertable {
 		HT4N_RETHROW
 	}
 
+	BulkLoadStatistics^ Table::BulkLoad( String^ path, BulkLoadOptions^ options ) {
+		if( String::IsNullOrEmpty(path) ) throw gcnew ArgumentNullException( L"path" );
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		IO::FileStream^ stream = gcnew IO::FileStream( path, IO::FileMode::Open, IO::FileAccess::Read, IO::FileShare::Read, 64 * 1024, IO::FileOptions::SequentialScan );
+		try {
+			return BulkLoad( stream, options );
+		}
+		finally {
+			delete stream;
+		}
+	}
+
+	BulkLoadStatistics^ Table::BulkLoad( IO::Stream^ stream, BulkLoadOptions^ options ) {
+		if( stream == nullptr ) throw gcnew ArgumentNullException( L"stream" );
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		BulkLoader^ bulkLoader = gcnew BulkLoader( table, options != nullptr ? options : gcnew BulkLoadOptions() );
+		return bulkLoader->Load( stream );
+	}
+
 	String^ Table::ToString() {
 		HT4N_THROW_OBJECTDISPOSED( );
 
@@ -254,6 +375,23 @@ namespace Hypertable {
 												 , Name != nullptr ? Name : L"null");
 	}
 
+	Common::TableScanner* Table::CreateTableScanner( ScanSpec^ scanSpec ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		Common::ScanSpec* _scanSpec = 0;
+		HT4N_TRY {
+			uint32_t timeout;
+			uint32_t flags;
+			_scanSpec = From( scanSpec, timeout, flags );
+
+			return table->createScanner( *_scanSpec, timeout, flags );
+		}
+		HT4N_RETHROW
+		finally {
+			if( _scanSpec ) delete _scanSpec;
+		}
+	}
+
 	Table::Table( Common::Table* _table )
 	: table( _table )
 	, disposed( false )
@@ -261,6 +399,72 @@ namespace Hypertable {
 		if( table == 0 ) throw gcnew ArgumentNullException( L"table" );
 	}
 
+	ITableMutator^ Table::CreatePartitionedMutator( MutatorSpec^ mutatorSpec ) {
+		const int consumers = mutatorSpec->Consumers;
+		const int capacity = mutatorSpec->Capacity > 0 ? Math::Max( 1, (mutatorSpec->Capacity + consumers - 1) / consumers ) : 0;
+
+		const Int64 maxPendingBytes = mutatorSpec->MaxPendingBytes > 0 ? Math::Max( 1LL, mutatorSpec->MaxPendingBytes / consumers ) : 0;
+		const int spillThreshold = Math::Max( 1, mutatorSpec->SpillThreshold / consumers );
+
+		MutatorSpec^ partitionSpec = gcnew MutatorSpec( mutatorSpec );
+		partitionSpec->Queued = false;
+		partitionSpec->MaxPendingBytes = 0;
+
+		cli::array<String^>^ counterColumnFamilies = CounterColumnFamilies( mutatorSpec );
+		MutatorStatistics^ statistics = gcnew MutatorStatistics();
+		cli::array<ITableMutator^>^ partitions = gcnew cli::array<ITableMutator^>( consumers );
+		try {
+			for( int n = 0; n < consumers; ++n ) {
+				ITableMutator^ inner = CreateMutator( partitionSpec );
+				try {
+					partitions[n] = gcnew QueuedTableMutator( inner, capacity, mutatorSpec->BatchSize, maxPendingBytes, mutatorSpec->Coalesce && mutatorSpec->MutatorKind != MutatorKind::Chunked, counterColumnFamilies, mutatorSpec->SpillPath != nullptr ? String::Format(CultureInfo::InvariantCulture, L"{0}.{1}", mutatorSpec->SpillPath, n) : nullptr, spillThreshold, statistics );
+				}
+				catch( Exception^ ) {
+					delete inner;
+					throw;
+				}
+			}
+		}
+		catch( Exception^ ) {
+			for each( ITableMutator^ partition in partitions ) {
+				delete partition;
+			}
+			throw;
+		}
+		return gcnew PartitionedTableMutator( partitions, statistics );
+	}
+
+	cli::array<String^>^ Table::CounterColumnFamilies( MutatorSpec^ mutatorSpec ) {
+		// each insert into a counter column is an increment, which must never be coalesced
+		if( !mutatorSpec->Coalesce ) {
+			return nullptr;
+		}
+
+		Xml::TableSchema^ schema = GetTableSchema();
+		bool counterDefault = schema->ColumnFamilyDefaults != nullptr && schema->ColumnFamilyDefaults->CounterSpecified && schema->ColumnFamilyDefaults->Counter;
+		List<String^>^ counterColumnFamilies = gcnew List<String^>();
+		if( schema->AccessGroups != nullptr ) {
+			for each( Xml::AccessGroup^ accessGroup in schema->AccessGroups ) {
+				bool accessGroupDefault = counterDefault;
+				if( accessGroup->ColumnFamilyDefaults != nullptr && accessGroup->ColumnFamilyDefaults->CounterSpecified ) {
+					accessGroupDefault = accessGroup->ColumnFamilyDefaults->Counter;
+				}
+				if( accessGroup->ColumnFamilies != nullptr ) {
+					for each( Xml::ColumnFamily^ columnFamily in accessGroup->ColumnFamilies ) {
+						bool counter = accessGroupDefault;
+						if( columnFamily->Options != nullptr && columnFamily->Options->CounterSpecified ) {
+							counter = columnFamily->Options->Counter;
+						}
+						if( counter && !String::IsNullOrEmpty(columnFamily->Name) ) {
+							counterColumnFamilies->Add( columnFamily->Name );
+						}
+					}
+				}
+			}
+		}
+		return counterColumnFamilies->Count > 0 ? counterColumnFamilies->ToArray() : nullptr;
+	}
+
 	Common::ScanSpec* Table::From( ScanSpec^ scanSpec, UInt32& timeout, UInt32& flags ) {
 		timeout = 0;
 		flags = ht4c::Common::SF_Default;
@@ -272,7 +476,7 @@ namespace Hypertable {
 				if( scanSpec->Timeout.TotalMilliseconds < 0 ) throw gcnew ArgumentException( L"Invalid parameter scanSpec (Timeout < 0)", L"scanSpec" );
 				timeout = (uint32_t)scanSpec->Timeout.TotalMilliseconds;
 			}
-			flags = (uint32_t)scanSpec->Flags;
+			flags = (uint32_t)(scanSpec->Flags & ~(ScannerFlags::InternStrings | ScannerFlags::Prefetch));
 		}
 		return _scanSpec;
 	}
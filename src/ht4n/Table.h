@@ -27,9 +27,12 @@
 
 #include "ITable.h"
 #include "AsyncScannerCallback.h"
+#include "AsyncScanBlockCallback.h"
+#include "AsyncRowCallback.h"
 
 namespace ht4c { namespace Common {
 	class Table;
+	class TableScanner;
 	class ScanSpec;
 } }
 
@@ -44,6 +47,8 @@ namespace Hypertable {
 	ref class ScanSpec;
 	ref class Cell;
 	ref class AsyncResult;
+	ref class BulkLoadOptions;
+	ref class BulkLoadStatistics;
 
 	namespace Xml {
 
@@ -94,13 +99,23 @@ namespace Hypertable {
 			virtual ITableMutator^ CreateAsyncMutator( AsyncResult^ asyncResult, MutatorSpec^ mutatorSpec );
 			virtual ITableScanner^ CreateScanner( );
 			virtual ITableScanner^ CreateScanner( ScanSpec^ scanSpec );
+			virtual ITableScanner^ CreateParallelScanner( ScanSpec^ scanSpec, int degree );
+			virtual ITableScanner^ CreateParallelScanner( ScanSpec^ scanSpec, int degree, bool ordered );
 			virtual int64_t BeginScan( AsyncResult^ asyncResult );
 			virtual int64_t BeginScan( AsyncResult^ asyncResult, ScanSpec^ scanSpec );
 			virtual int64_t BeginScan( AsyncResult^ asyncResult, ScanSpec^ scanSpec, Object^ param );
 			virtual int64_t BeginScan( AsyncResult^ asyncResult, AsyncScannerCallback^ callback );
 			virtual int64_t BeginScan( AsyncResult^ asyncResult, ScanSpec^ scanSpec, AsyncScannerCallback^ callback );
 			virtual int64_t BeginScan( AsyncResult^ asyncResult, ScanSpec^ scanSpec, Object^ param, AsyncScannerCallback^ callback );
+			virtual int64_t BeginBlockScan( AsyncResult^ asyncResult, ScanSpec^ scanSpec, Object^ param, AsyncScanBlockCallback^ callback );
+			virtual int64_t BeginRowScan( AsyncResult^ asyncResult, ScanSpec^ scanSpec, Object^ param, AsyncRowCallback^ callback );
+			#ifdef NETCORE
+			virtual IAsyncEnumerable<Cell^>^ ScanAsync( ScanSpec^ scanSpec, Threading::CancellationToken cancellationToken );
+			virtual IAsyncEnumerable<IReadOnlyList<Cell^>^>^ ScanBatchesAsync( ScanSpec^ scanSpec, Threading::CancellationToken cancellationToken );
+			#endif
 			virtual Xml::TableSchema^ GetTableSchema( );
+			virtual BulkLoadStatistics^ BulkLoad( String^ path, BulkLoadOptions^ options );
+			virtual BulkLoadStatistics^ BulkLoad( IO::Stream^ stream, BulkLoadOptions^ options );
 
 			#pragma endregion
 
@@ -114,8 +129,12 @@ namespace Hypertable {
 
 			Table( Common::Table* table );
 
+			Common::TableScanner* CreateTableScanner( ScanSpec^ scanSpec );
+
 		private:
 
+			ITableMutator^ CreatePartitionedMutator( MutatorSpec^ mutatorSpec );
+			cli::array<String^>^ CounterColumnFamilies( MutatorSpec^ mutatorSpec );
 			static Common::ScanSpec* From( ScanSpec^ scanSpec, UInt32& timeout, UInt32& flags );
 
 			Common::Table* table;
@@ -26,6 +26,10 @@
 #include "Cell.h"
 #include "Exception.h"
 #include "CM2U8.h"
+#include "MutatorStatistics.h"
+#include "ValueCodecMap.h"
+#include "IValueCodec.h"
+#include "HypertableEventSource.h"
 
 #include "ht4c.Common/TableMutator.h"
 #include "ht4c.Common/Cells.h"
@@ -33,6 +37,8 @@
 
 namespace Hypertable {
 	using namespace System;
+	using namespace System::Threading;
+	using namespace System::Threading::Tasks;
 	using namespace ht4c;
 
 	TableMutator::~TableMutator( ) {
@@ -47,6 +53,11 @@ namespace Hypertable {
 			if( tableMutator ) {
 				delete tableMutator;
 				tableMutator = 0;
+				HypertableEventSource::MutatorClosed();
+			}
+			Common::Cells* _cells = static_cast<Common::Cells*>( Interlocked::Exchange(cellsBuffer, IntPtr::Zero).ToPointer() );
+			if( _cells ) {
+				delete _cells;
 			}
 		} 
 		HT4N_RETHROW
@@ -79,26 +90,30 @@ namespace Hypertable {
 
 		if( cells == nullptr ) throw gcnew ArgumentNullException( L"cells" );
 		Common::Cells* _cells = 0;
+		size_t bytes = 0;
+		cli::array<Byte>^ buffer = nullptr;
 		HT4N_TRY {
 			ICollection<Cell^>^ cells_collection = dynamic_cast<ICollection<Cell^>^>( cells );
-			_cells = Common::Cells::create( cells_collection != nullptr ? cells_collection->Count : 1024 );
+			_cells = AcquireCells( cells_collection != nullptr ? cells_collection->Count : 1024 );
 			for each( Cell^ cell in cells ) {
 				if( cell != nullptr && cell->Key != nullptr ) {
 					Key^ key = cell->Key;
 					if( createRowKey || String::IsNullOrEmpty(key->Row) ) {
 						key->Row = CM2U8::ToString( Common::KeyBuilder().c_str() );
 					}
-					UInt32 len = cell->Value != nullptr ? cell->Value->Length : 0;
-					pin_ptr<Byte> pv = len ? &cell->Value[0] : nullptr;
-					_cells->add( CM2U8(key->Row), CM2U8(key->ColumnFamily), CM2U8(key->ColumnQualifier), key->Timestamp, pv, len, (Byte)cell->Flag );
+					int encodedLength = Encode( key, cell->Value, buffer );
+					bytes += Add( _cells, key, cell->Value, cell->Flag, buffer, encodedLength );
+					bytes += CM2U8::Utf8Length( key->Row ) + CM2U8::Utf8Length( key->ColumnFamily ) + CM2U8::Utf8Length( key->ColumnQualifier );
 				}
 			}
+			HypertableEventSource::Written( *_cells );
 			msclr::lock sync( syncRoot );
 			tableMutator->set( *_cells );
 		}
 		HT4N_RETHROW
 		finally {
-			if( _cells ) delete _cells;
+			if( _cells ) ReleaseCells( _cells, bytes );
+			ValueCodecMap::Release( buffer );
 		}
 	}
 
@@ -120,6 +135,7 @@ namespace Hypertable {
 		HT4N_TRY {
 			msclr::lock sync( syncRoot );
 			tableMutator->del( CM2U8(key->Row), CM2U8(key->ColumnFamily), CM2U8(key->ColumnQualifier), key->Timestamp );
+			HypertableEventSource::Written( key, 0 );
 		} 
 		HT4N_RETHROW
 	}
@@ -128,33 +144,42 @@ namespace Hypertable {
 		HT4N_THROW_OBJECTDISPOSED( );
 
 		if( keys == nullptr ) throw gcnew ArgumentNullException( L"keys" );
+		Common::Cells* _cells = 0;
 		HT4N_TRY {
-			msclr::lock sync( syncRoot );
+			ICollection<Key^>^ keys_collection = dynamic_cast<ICollection<Key^>^>( keys );
+			_cells = AcquireCells( keys_collection != nullptr ? Math::Min(keys_collection->Count, DeleteBatchSize) : 1024 );
 			for each( Key^ key in keys ) {
 				if( key != nullptr ) {
-					tableMutator->del( CM2U8(key->Row), CM2U8(key->ColumnFamily), CM2U8(key->ColumnQualifier), key->Timestamp );
+					AddDelete( _cells, key );
 				}
 			}
-		} 
+			SetDeletes( _cells, true );
+		}
 		HT4N_RETHROW
+		finally {
+			if( _cells ) ReleaseCells( _cells, 0 );
+		}
 	}
 
 	void TableMutator::Delete( IEnumerable<Cell^>^ cells ) {
 		HT4N_THROW_OBJECTDISPOSED( );
 
 		if( cells == nullptr ) throw gcnew ArgumentNullException( L"cells" );
+		Common::Cells* _cells = 0;
 		HT4N_TRY {
-			msclr::lock sync( syncRoot );
+			ICollection<Cell^>^ cells_collection = dynamic_cast<ICollection<Cell^>^>( cells );
+			_cells = AcquireCells( cells_collection != nullptr ? Math::Min(cells_collection->Count, DeleteBatchSize) : 1024 );
 			for each( Cell^ cell in cells ) {
-				if( cell != nullptr ) {
-					Key^ key = cell->Key;
-					if( key != nullptr ) {
-						tableMutator->del( CM2U8(key->Row), CM2U8(key->ColumnFamily), CM2U8(key->ColumnQualifier), key->Timestamp );
-					}
+				if( cell != nullptr && cell->Key != nullptr ) {
+					AddDelete( _cells, cell->Key );
 				}
 			}
-		} 
+			SetDeletes( _cells, true );
+		}
 		HT4N_RETHROW
+		finally {
+			if( _cells ) ReleaseCells( _cells, 0 );
+		}
 	}
 
 	void TableMutator::Flush( ) {
@@ -162,39 +187,144 @@ namespace Hypertable {
 
 		HT4N_TRY {
 			msclr::lock sync( syncRoot );
+			Int64 started = HypertableEventSource::Start();
 			tableMutator->flush();
+			HypertableEventSource::Flushed( started );
 		} 
 		HT4N_RETHROW
 	}
 
-	TableMutator::TableMutator( Common::TableMutator* _tableMutator )
+	Task^ TableMutator::SetAsync( IEnumerable<Cell^>^ cells ) {
+		return SetAsync( cells, CancellationToken::None );
+	}
+
+	Task^ TableMutator::SetAsync( IEnumerable<Cell^>^ cells, CancellationToken cancellationToken ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		if( cells == nullptr ) throw gcnew ArgumentNullException( L"cells" );
+		// the native mutator completes synchronously
+		return Task::Factory->StartNew( gcnew Action<Object^>(this, &TableMutator::SetCells), cells, cancellationToken, TaskCreationOptions::DenyChildAttach, TaskScheduler::Default );
+	}
+
+	Task^ TableMutator::FlushAsync( ) {
+		return FlushAsync( CancellationToken::None );
+	}
+
+	Task^ TableMutator::FlushAsync( CancellationToken cancellationToken ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		return Task::Factory->StartNew( gcnew Action(this, &TableMutator::Flush), cancellationToken, TaskCreationOptions::DenyChildAttach, TaskScheduler::Default );
+	}
+
+	void TableMutator::SetCells( Object^ state ) {
+		Set( safe_cast<IEnumerable<Cell^>^>(state) );
+	}
+
+	TableMutator::TableMutator( Common::TableMutator* _tableMutator, UInt32 _maxBufferedCells, ValueCodecMap^ _valueCodecs )
 	: tableMutator( _tableMutator )
 	, syncRoot( gcnew Object() )
+	, statistics( gcnew MutatorStatistics() )
+	, valueCodecs( _valueCodecs )
 	, disposed( false )
+	, cellsBuffer( IntPtr::Zero )
+	, maxBufferedCells( _maxBufferedCells )
 	{
 		if( tableMutator == 0 ) throw gcnew ArgumentNullException(L"tableMutator");
+		HypertableEventSource::MutatorOpened();
 	}
 
 	void TableMutator::Set( Key^ key, cli::array<Byte>^ value, CellFlag cellFlag, bool createRowKey ) {
 		if( key == nullptr ) throw gcnew ArgumentNullException( L"key" );
+		cli::array<Byte>^ buffer = nullptr;
 		HT4N_TRY {
 			UInt32 len = value != nullptr ? value->Length : 0;
+			pin_ptr<Byte> pv = len ? &value[0] : nullptr;
+			IValueCodec^ codec = valueCodecs != nullptr && len ? valueCodecs->Get( key->ColumnFamily ) : nullptr;
+			int encodedLength = codec != nullptr ? ValueCodecMap::Encode( codec, pv, len, buffer ) : 0;
+			pin_ptr<Byte> pb = encodedLength ? &buffer[0] : nullptr;
+			const Byte* v = encodedLength ? static_cast<Byte*>( pb ) : static_cast<Byte*>( pv );
+			if( encodedLength ) {
+				len = encodedLength;
+			}
 			if( createRowKey || String::IsNullOrEmpty(key->Row) ) {
 				std::string row;
 				{
 					msclr::lock sync( syncRoot );
-					pin_ptr<Byte> pv = len ? &value[0] : nullptr;
-					tableMutator->set( CM2U8(key->ColumnFamily), CM2U8(key->ColumnQualifier), key->Timestamp, pv, len, row );
+					tableMutator->set( CM2U8(key->ColumnFamily), CM2U8(key->ColumnQualifier), key->Timestamp, v, len, row );
 				}
 				key->Row = CM2U8::ToString( row.c_str() );
 			}
 			else {
 				msclr::lock sync( syncRoot );
-				pin_ptr<Byte> pv = len ? &value[0] : nullptr;
-				tableMutator->set( CM2U8(key->Row), CM2U8(key->ColumnFamily), CM2U8(key->ColumnQualifier), key->Timestamp, pv, len, (uint8_t)cellFlag );
+				tableMutator->set( CM2U8(key->Row), CM2U8(key->ColumnFamily), CM2U8(key->ColumnQualifier), key->Timestamp, v, len, (uint8_t)cellFlag );
 			}
+			HypertableEventSource::Written( key, len );
 		}
 		HT4N_RETHROW
+		finally {
+			ValueCodecMap::Release( buffer );
+		}
+	}
+
+	UInt32 TableMutator::Add( Common::Cells* _cells, Key^ key, cli::array<Byte>^ value, CellFlag cellFlag, cli::array<Byte>^ buffer, int encodedLength ) {
+		// encoded values are copied by the cells, the buffer is reused for the next cell
+		if( encodedLength ) {
+			pin_ptr<Byte> pb = &buffer[0];
+			_cells->add( CM2U8(key->Row), CM2U8(key->ColumnFamily), CM2U8(key->ColumnQualifier), key->Timestamp, pb, encodedLength, (Byte)cellFlag );
+			return encodedLength;
+		}
+		UInt32 len = value != nullptr ? value->Length : 0;
+		pin_ptr<Byte> pv = len ? &value[0] : nullptr;
+		_cells->add( CM2U8(key->Row), CM2U8(key->ColumnFamily), CM2U8(key->ColumnQualifier), key->Timestamp, pv, len, (Byte)cellFlag );
+		return len;
+	}
+
+	int TableMutator::Encode( Key^ key, cli::array<Byte>^ value, cli::array<Byte>^% buffer ) {
+		// returns the encoded length, zero if the value is stored as is
+		UInt32 len = value != nullptr ? value->Length : 0;
+		IValueCodec^ codec = valueCodecs != nullptr && len ? valueCodecs->Get( key->ColumnFamily ) : nullptr;
+		if( codec == nullptr ) {
+			return 0;
+		}
+		pin_ptr<Byte> pv = &value[0];
+		return ValueCodecMap::Encode( codec, pv, len, buffer );
+	}
+
+	void TableMutator::AddDelete( Common::Cells* _cells, Key^ key ) {
+		_cells->add( CM2U8(key->Row), CM2U8(key->ColumnFamily), CM2U8(key->ColumnQualifier), key->Timestamp, 0, 0, (Byte)Cell::DeleteFlagFromKey(key) );
+		SetDeletes( _cells, false );
+	}
+
+	void TableMutator::SetDeletes( Common::Cells* _cells, bool force ) {
+		if( _cells->size() >= static_cast<size_t>(DeleteBatchSize) || (force && _cells->size() > 0) ) {
+			HypertableEventSource::Written( *_cells );
+			{
+				msclr::lock sync( syncRoot );
+				tableMutator->set( *_cells );
+			}
+			_cells->clear();
+		}
+	}
+
+	Common::Cells* TableMutator::AcquireCells( int capacity ) {
+		Common::Cells* _cells = static_cast<Common::Cells*>( Interlocked::Exchange(cellsBuffer, IntPtr::Zero).ToPointer() );
+		if( !_cells ) {
+			_cells = Common::Cells::create( capacity );
+			statistics->AddCellBuffer();
+		}
+		return _cells;
+	}
+
+	void TableMutator::ReleaseCells( Common::Cells* _cells, size_t bytes ) {
+		// retain the cell buffer for the next batch unless it has grown beyond the high-water marks,
+		// delete batches pass no bytes, they hold keys only and are bounded by DeleteBatchSize
+		if( !disposed && maxBufferedCells > 0 && _cells->size() <= maxBufferedCells && bytes <= MaxBufferedBytes ) {
+			_cells->clear();
+			if( Interlocked::CompareExchange(cellsBuffer, IntPtr(_cells), IntPtr::Zero) == IntPtr::Zero ) {
+				return;
+			}
+		}
+		delete _cells;
 	}
 
 }
\ No newline at end of file
@@ -30,6 +30,7 @@
 
 namespace ht4c { namespace Common {
 	class TableMutator;
+	class Cells;
 } }
 
 namespace Hypertable {
@@ -38,6 +39,8 @@ namespace Hypertable {
 
 	ref class Key;
 	ref class Cell;
+	ref class MutatorStatistics;
+	ref class ValueCodecMap;
 
 	/// <summary>
 	/// Represents a table mutator.
@@ -65,6 +68,12 @@ namespace Hypertable {
 				}
 			}
 
+			property MutatorStatistics^ Statistics {
+				virtual MutatorStatistics^ get( ) {
+					return statistics;
+				}
+			}
+
 			virtual void Set( Key^ key, cli::array<Byte>^ value );
 			virtual void Set( Key^ key, cli::array<Byte>^ value, bool createRowKey );
 			virtual void Set( Cell^ cell );
@@ -76,20 +85,42 @@ namespace Hypertable {
 			virtual void Delete( IEnumerable<Key^>^ keys );
 			virtual void Delete( IEnumerable<Cell^>^ cells );
 			virtual void Flush();
+			virtual System::Threading::Tasks::Task^ SetAsync( IEnumerable<Cell^>^ cells );
+			virtual System::Threading::Tasks::Task^ SetAsync( IEnumerable<Cell^>^ cells, System::Threading::CancellationToken cancellationToken );
+			virtual System::Threading::Tasks::Task^ FlushAsync( );
+			virtual System::Threading::Tasks::Task^ FlushAsync( System::Threading::CancellationToken cancellationToken );
 
 			#pragma endregion
 
 		internal:
 
-			TableMutator( Common::TableMutator* tableMutator );
+			TableMutator( Common::TableMutator* tableMutator, UInt32 maxBufferedCells, ValueCodecMap^ valueCodecs );
 
 		protected:
 
 			void Set( Key^ key, cli::array<Byte>^ value, CellFlag cellFlag, bool createRowKey );
+			Common::Cells* AcquireCells( int capacity );
+			void ReleaseCells( Common::Cells* cells, size_t bytes );
+			UInt32 Add( Common::Cells* cells, Key^ key, cli::array<Byte>^ value, CellFlag cellFlag, cli::array<Byte>^ buffer, int encodedLength );
+			int Encode( Key^ key, cli::array<Byte>^ value, cli::array<Byte>^% buffer );
 
 			Object^ syncRoot;
 			Common::TableMutator* tableMutator;
+			MutatorStatistics^ statistics;
+			ValueCodecMap^ valueCodecs;
 			bool disposed;
+
+		private:
+
+			void SetCells( Object^ state );
+			void AddDelete( Common::Cells* cells, Key^ key );
+			void SetDeletes( Common::Cells* cells, bool force );
+
+			literal int DeleteBatchSize = 8 * 1024;
+			literal UInt32 MaxBufferedBytes = 4 * 1024 * 1024;
+
+			IntPtr cellsBuffer;
+			const UInt32 maxBufferedCells;
 	};
 
 }
\ No newline at end of file
@@ -26,7 +26,14 @@
 #include "Cell.h"
 #include "BufferedCell.h"
 #include "PooledCell.h"
+#include "ScanBlock.h"
+#include "CellView.h"
 #include "ScanSpec.h"
+#include "StringCache.h"
+#include "ScannerStatistics.h"
+#include "ValueCodecMap.h"
+#include "IValueCodec.h"
+#include "HypertableEventSource.h"
 #include "Exception.h"
 
 #include "ht4c.Common/TableScanner.h"
@@ -34,6 +41,7 @@
 
 namespace Hypertable {
 	using namespace System;
+	using namespace System::Buffers;
 	using namespace ht4c;
 
 	ref class TableScannerEnumerator sealed : public IEnumerator<Cell^> {
@@ -93,6 +101,7 @@ namespace Hypertable {
 			if( tableScanner ) {
 				delete tableScanner;
 				tableScanner = 0;
+				HypertableEventSource::ScannerClosed();
 			}
 		} 
 		HT4N_RETHROW
@@ -106,7 +115,8 @@ namespace Hypertable {
 			Common::Cell* _cell;
 			msclr::lock sync( syncRoot );
 			if( tableScanner->next(_cell) ) {
-				cell->From( *_cell );
+				cell->From( *_cell, stringCache, valueCodecs );
+				HypertableEventSource::Scanned( *_cell );
 				return true;
 			}
 			return false;
@@ -122,7 +132,8 @@ namespace Hypertable {
 			Common::Cell* _cell;
 			msclr::lock sync(syncRoot);
 			if( tableScanner->next(_cell) ) {
-				cell->From( *_cell );
+				cell->From( *_cell, stringCache, valueCodecs );
+				HypertableEventSource::Scanned( *_cell );
 				return true;
 			}
 			return false;
@@ -138,7 +149,8 @@ namespace Hypertable {
 			Common::Cell* _cell;
 			msclr::lock sync(syncRoot);
 			if (tableScanner->next(_cell)) {
-				cell->From(*_cell);
+				cell->From( *_cell, stringCache, valueCodecs );
+				HypertableEventSource::Scanned( *_cell );
 				return true;
 			}
 			return false;
@@ -146,10 +158,103 @@ namespace Hypertable {
 			HT4N_RETHROW
 	}
 
+	bool TableScanner::MoveBatch( cli::array<BufferedCell^>^ cells, int% count ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		if( cells == nullptr ) throw gcnew ArgumentNullException( L"cells" );
+		count = 0;
+		HT4N_TRY {
+			Common::Cell* _cell;
+			int n = 0;
+			msclr::lock sync( syncRoot );
+			for( ; n < cells->Length && tableScanner->next(_cell); ++n ) {
+				BufferedCell^ cell = cells[n];
+				if( cell == nullptr ) {
+					cells[n] = cell = gcnew BufferedCell( 0 );
+				}
+				cell->From( *_cell, stringCache, valueCodecs );
+				HypertableEventSource::Scanned( *_cell );
+			}
+			count = n;
+			return n > 0;
+		}
+		HT4N_RETHROW
+	}
+
+	bool TableScanner::Move( ScanBlock^ block ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		if( block == nullptr ) throw gcnew ArgumentNullException( L"block" );
+		block->Clear();
+		HT4N_TRY {
+			Common::Cell* _cell;
+			msclr::lock sync( syncRoot );
+			while( !block->IsFull && tableScanner->next(_cell) ) {
+				block->Add( *_cell );
+				HypertableEventSource::Scanned( *_cell );
+			}
+			return block->Count > 0;
+		}
+		HT4N_RETHROW
+	}
+
 	bool TableScanner::Next( Cell^% cell ) {
 		return MoveNext( cell );
 	}
 
+	bool TableScanner::Visit( CellVisitor^ visitor ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		if( visitor == nullptr ) throw gcnew ArgumentNullException( L"visitor" );
+		cli::array<Byte>^ buffer = nullptr;
+		HT4N_TRY {
+			Common::Cell* _cell;
+			msclr::lock sync( syncRoot );
+			if( tableScanner->next(_cell) ) {
+				HypertableEventSource::Scanned( *_cell );
+				return Visit( *_cell, visitor, buffer );
+			}
+			return false;
+		}
+		HT4N_RETHROW
+		finally {
+			if( buffer != nullptr ) {
+				ArrayPool<Byte>::Shared->Return( buffer );
+			}
+		}
+	}
+
+	bool TableScanner::VisitBatch( CellVisitor^ visitor, int maxCount, int% count ) {
+		HT4N_THROW_OBJECTDISPOSED( );
+
+		if( visitor == nullptr ) throw gcnew ArgumentNullException( L"visitor" );
+		if( maxCount <= 0 ) throw gcnew ArgumentException( L"Invalid parameter maxCount (maxCount must be greater than zero)", L"maxCount" );
+		count = 0;
+		cli::array<Byte>^ buffer = nullptr;
+		HT4N_TRY {
+			Common::Cell* _cell;
+			int n = 0;
+			bool more = true;
+			msclr::lock sync( syncRoot );
+			while( n < maxCount && (more = tableScanner->next(_cell)) ) {
+				HypertableEventSource::Scanned( *_cell );
+				++n;
+				if( !Visit(*_cell, visitor, buffer) ) {
+					more = false;
+					break;
+				}
+			}
+			count = n;
+			return more;
+		}
+		HT4N_RETHROW
+		finally {
+			if( buffer != nullptr ) {
+				ArrayPool<Byte>::Shared->Return( buffer );
+			}
+		}
+	}
+
 	IEnumerator<Cell^>^ TableScanner::generic_GetEnumerator( ) {
 		HT4N_THROW_OBJECTDISPOSED( );
 
@@ -159,10 +264,20 @@ namespace Hypertable {
 	TableScanner::TableScanner( Common::TableScanner* _tableScanner, Hypertable::ScanSpec^ _scanSpec )
 	: tableScanner( _tableScanner )
 	, scanSpec( _scanSpec )
+	, statistics( gcnew ScannerStatistics(0) )
+	, stringCache( nullptr )
+	, columnFamilyCache( nullptr )
 	, syncRoot( gcnew Object() )
 	, disposed( false )
 	{
 		if( tableScanner == 0 ) throw gcnew ArgumentNullException( L"tableScanner" );
+		HypertableEventSource::ScannerOpened();
+		if( scanSpec != nullptr && (scanSpec->Flags & ScannerFlags::InternStrings) == ScannerFlags::InternStrings ) {
+			stringCache = gcnew StringCache();
+		}
+		if( scanSpec != nullptr ) {
+			valueCodecs = ValueCodecMap::Create( scanSpec->ValueCodecs );
+		}
 	}
 
 	bool TableScanner::MoveNext( Cell^% cell ) {
@@ -172,7 +287,9 @@ namespace Hypertable {
 			Common::Cell* _cell;
 			msclr::lock sync( syncRoot );
 			if( tableScanner->next(_cell) ) {
-				cell = gcnew Cell( _cell );
+				cell = gcnew Cell();
+				cell->From( *_cell, stringCache, valueCodecs );
+				HypertableEventSource::Scanned( *_cell );
 				return true;
 			}
 			cell = nullptr;
@@ -188,11 +305,54 @@ namespace Hypertable {
 			Common::Cell* cell;
 			msclr::lock sync(syncRoot);
 			if (tableScanner->next(cell)) {
-				return action(gcnew Key(*cell), IntPtr(const_cast<ht4c::Common::uint8_t*>(cell->value())), static_cast<int>(cell->valueLength()));
+				HypertableEventSource::Scanned(*cell);
+				Key^ key = gcnew Key(*cell, stringCache);
+				int decodedLength;
+				IValueCodec^ codec = valueCodecs != nullptr && cell->valueLength() ? valueCodecs->GetEncoded(key->ColumnFamily, cell->value(), static_cast<int>(cell->valueLength()), decodedLength) : nullptr;
+				if (codec != nullptr) {
+					// decode into a pooled buffer, the value pointer is only valid during the action
+					cli::array<Byte>^ buffer = ArrayPool<Byte>::Shared->Rent(decodedLength);
+					try {
+						pin_ptr<Byte> pb = &buffer[0];
+						ValueCodecMap::Decode(codec, cell->value(), static_cast<int>(cell->valueLength()), pb, decodedLength);
+						return action(key, IntPtr(pb), decodedLength);
+					}
+					finally {
+						ArrayPool<Byte>::Shared->Return(buffer);
+					}
+				}
+				return action(key, IntPtr(const_cast<ht4c::Common::uint8_t*>(cell->value())), static_cast<int>(cell->valueLength()));
 			}
 			return false;
 		}
 		HT4N_RETHROW
 	}
 
+	bool TableScanner::Visit( const Common::Cell& cell, CellVisitor^ visitor, cli::array<Byte>^% buffer ) {
+		int length = static_cast<int>( cell.valueLength() );
+		IValueCodec^ codec = nullptr;
+		int decodedLength;
+		if( valueCodecs != nullptr && length > 0 ) {
+			// the column families are interned, the codec lookup does not allocate
+			if( columnFamilyCache == nullptr ) {
+				columnFamilyCache = gcnew StringCache();
+			}
+			codec = valueCodecs->GetEncoded( columnFamilyCache->Get(cell.columnFamily()), cell.value(), length, decodedLength );
+		}
+		if( codec != nullptr ) {
+			// decode into a pooled buffer which is retained for the remaining cells of the batch
+			if( buffer == nullptr || buffer->Length < decodedLength ) {
+				if( buffer != nullptr ) {
+					ArrayPool<Byte>::Shared->Return( buffer );
+					buffer = nullptr;
+				}
+				buffer = ArrayPool<Byte>::Shared->Rent( decodedLength );
+			}
+			pin_ptr<Byte> pb = &buffer[0];
+			ValueCodecMap::Decode( codec, cell.value(), length, pb, decodedLength );
+			return visitor( CellView(cell, IntPtr(pb), decodedLength) );
+		}
+		return visitor( CellView(cell, IntPtr(const_cast<Common::uint8_t*>(cell.value())), length) );
+	}
+
 }
\ No newline at end of file
@@ -41,7 +41,11 @@ namespace Hypertable {
 	ref class Cell;
 	ref class BufferedCell;
 	ref class PooledCell;
+	ref class ScanBlock;
 	ref class ScanSpec;
+	ref class StringCache;
+	ref class ScannerStatistics;
+	ref class ValueCodecMap;
 
 	/// <summary>
 	/// Represents a table scanner.
@@ -75,11 +79,21 @@ namespace Hypertable {
 				}
 			}
 
+			property ScannerStatistics^ Statistics {
+				virtual ScannerStatistics^ get( ) {
+					return statistics;
+				}
+			}
+
 			virtual bool Move( Cell^ cell );
 			virtual bool Move( BufferedCell^ cell );
 			virtual bool Move( PooledCell^ cell );
+			virtual bool MoveBatch( cli::array<BufferedCell^>^ cells, [Out] int% count );
+			virtual bool Move( ScanBlock^ block );
 			virtual bool Next( [Out] Cell^% cell );
 			virtual bool Next( Func<Key^, IntPtr, int, bool>^ action );
+			virtual bool Visit( CellVisitor^ visitor );
+			virtual bool VisitBatch( CellVisitor^ visitor, int maxCount, [Out] int% count );
 
 			virtual IEnumerator<Cell^>^ generic_GetEnumerator( ) = IEnumerable<Cell^>::GetEnumerator;
 
@@ -97,8 +111,14 @@ namespace Hypertable {
 
 		private:
 
+			bool Visit( const Common::Cell& cell, CellVisitor^ visitor, cli::array<Byte>^% buffer );
+
 			Common::TableScanner* tableScanner;
 			Hypertable::ScanSpec^ scanSpec;
+			ScannerStatistics^ statistics;
+			StringCache^ stringCache;
+			StringCache^ columnFamilyCache;
+			ValueCodecMap^ valueCodecs;
 			Object^ syncRoot;
 			bool disposed;
 	};
@@ -0,0 +1,48 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#include "stdafx.h"
+
+#include "Utf8Transcoding.h"
+#include "CM2U8.h"
+
+namespace Hypertable {
+	using namespace System;
+
+	cli::array<String^>^ Utf8Transcoding::Decode( cli::array<Byte>^ buffer, cli::array<int>^ lengths, bool win32 ) {
+		if( buffer == nullptr ) throw gcnew ArgumentNullException( L"buffer" );
+		if( lengths == nullptr ) throw gcnew ArgumentNullException( L"lengths" );
+
+		cli::array<String^>^ strings = gcnew cli::array<String^>( lengths->Length );
+		pin_ptr<Byte> pb = buffer->Length ? &buffer[0] : nullptr;
+		const char* p = reinterpret_cast<const char*>( static_cast<Byte*>(pb) );
+		const char* end = p + buffer->Length;
+		for( int n = 0; n < lengths->Length; ++n ) {
+			int len = lengths[n];
+			if( len < 0 || len > end - p ) throw gcnew ArgumentException( L"Invalid parameter lengths (exceeds buffer)", L"lengths" );
+			strings[n] = !len ? String::Empty : win32 ? CM2U8::ToStringWin32( p, len ) : CM2U8::ToString( p, len );
+			p += len;
+		}
+		return strings;
+	}
+
+}
\ No newline at end of file
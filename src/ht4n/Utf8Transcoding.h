@@ -0,0 +1,52 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#pragma once
+
+#ifndef __cplusplus_cli
+#error "requires /clr"
+#endif
+
+namespace Hypertable {
+	using namespace System;
+
+	/// <summary>
+	/// Decodes utf8 buffers with either the SSE2 transcoder or the Win32 conversion.
+	/// </summary>
+	/// <remarks>
+	/// Allows to compare both decoders on the same buffers, not used by the client itself.
+	/// </remarks>
+	ref class Utf8Transcoding abstract sealed {
+
+		internal:
+
+			/// <summary>
+			/// Decodes the consecutive utf8 strings of the buffer specified.
+			/// </summary>
+			/// <param name="buffer">Utf8 buffer.</param>
+			/// <param name="lengths">Byte lengths of the consecutive strings.</param>
+			/// <param name="win32">true to use the Win32 conversion, false to use the SSE2 transcoder.</param>
+			/// <returns>Decoded strings.</returns>
+			static cli::array<String^>^ Decode( cli::array<Byte>^ buffer, cli::array<int>^ lengths, bool win32 );
+	};
+
+}
\ No newline at end of file
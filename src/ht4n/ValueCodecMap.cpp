@@ -0,0 +1,184 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#include "stdafx.h"
+
+#include "ValueCodecMap.h"
+#include "IValueCodec.h"
+
+namespace Hypertable {
+	using namespace System;
+	using namespace System::IO;
+	using namespace System::Buffers;
+	using namespace System::Collections::Generic;
+
+	/// <summary>
+	/// Reads escaped raw values, which start with the header magic, verbatim.
+	/// </summary>
+	ref class EscapedValueCodec sealed : public IValueCodec {
+
+		public:
+
+			property Byte Id {
+				virtual Byte get( ) {
+					return 0;
+				}
+			}
+
+			virtual int GetMaxEncodedLength( int length ) {
+				return length;
+			}
+
+			virtual int GetMaxDecodedLength( int length ) {
+				return length;
+			}
+
+			virtual int Encode( IntPtr source, int length, IntPtr target, int capacity ) {
+				if( length > capacity ) {
+					return 0;
+				}
+				memcpy( target.ToPointer(), source.ToPointer(), length );
+				return length;
+			}
+
+			virtual int Decode( IntPtr source, int length, IntPtr target, int decodedLength ) {
+				if( length != decodedLength ) {
+					return -1;
+				}
+				memcpy( target.ToPointer(), source.ToPointer(), length );
+				return length;
+			}
+
+			static initonly EscapedValueCodec^ Instance = gcnew EscapedValueCodec();
+	};
+
+	ValueCodecMap^ ValueCodecMap::Create( IDictionary<String^, IValueCodec^>^ valueCodecs ) {
+		if( valueCodecs == nullptr || valueCodecs->Count == 0 ) {
+			return nullptr;
+		}
+		Dictionary<String^, IValueCodec^>^ codecs = gcnew Dictionary<String^, IValueCodec^>( valueCodecs->Count );
+		for each( KeyValuePair<String^, IValueCodec^> item in valueCodecs ) {
+			if( String::IsNullOrEmpty(item.Key) ) throw gcnew ArgumentException( L"Invalid value codec column family (null or empty)", L"valueCodecs" );
+			if( item.Value != nullptr ) {
+				if( item.Value->Id == 0 ) throw gcnew ArgumentException( L"Invalid value codec identifier (0 reserved)", L"valueCodecs" );
+				codecs->Add( item.Key, item.Value );
+			}
+		}
+		return codecs->Count > 0 ? gcnew ValueCodecMap( codecs ) : nullptr;
+	}
+
+	IValueCodec^ ValueCodecMap::Get( String^ columnFamily ) {
+		IValueCodec^ codec;
+		return columnFamily != nullptr && codecs->TryGetValue( columnFamily, codec ) ? codec : nullptr;
+	}
+
+	int ValueCodecMap::Encode( IValueCodec^ codec, const uint8_t* value, int length, cli::array<Byte>^% buffer ) {
+		// raw values starting with the header magic would be misread as encoded, they get escaped
+		const bool escape = length >= 3 && value[0] == 0x00 && value[1] == 'H' && value[2] == 'Z';
+		if( length < MinLength ) {
+			return escape ? Escape( value, length, buffer ) : 0;
+		}
+		Rent( buffer, HeaderSize + codec->GetMaxEncodedLength(length) );
+		pin_ptr<Byte> pb = &buffer[0];
+		uint8_t* p = pb;
+		const int encodedLength = codec->Encode( IntPtr(const_cast<uint8_t*>(value)), length, IntPtr(p + HeaderSize), buffer->Length - HeaderSize );
+		if( encodedLength <= 0 || HeaderSize + encodedLength >= length ) {
+			// not worth it, pass the value verbatim
+			return escape ? Escape( value, length, buffer ) : 0;
+		}
+		WriteHeader( p, codec->Id, length );
+		return HeaderSize + encodedLength;
+	}
+
+	IValueCodec^ ValueCodecMap::GetEncoded( String^ columnFamily, const uint8_t* value, int length, int% decodedLength ) {
+		decodedLength = length;
+		if( length <= HeaderSize || value[0] != 0x00 || value[1] != 'H' || value[2] != 'Z' || !codecs->ContainsKey(columnFamily) ) {
+			return nullptr;
+		}
+		const int len = value[4] | (value[5] << 8) | (value[6] << 16) | (value[7] << 24);
+		if( value[3] == 0 ) {
+			// escaped raw value
+			if( len != length - HeaderSize ) {
+				return nullptr;
+			}
+			decodedLength = len;
+			return EscapedValueCodec::Instance;
+		}
+		IValueCodec^ codec = codecsById[value[3]];
+		// the header length is used for allocation, values which cannot have been encoded are read verbatim
+		if( codec == nullptr || len < MinLength || len > codec->GetMaxDecodedLength(length - HeaderSize) ) {
+			return nullptr;
+		}
+		decodedLength = len;
+		return codec;
+	}
+
+	void ValueCodecMap::Decode( IValueCodec^ codec, const uint8_t* value, int length, uint8_t* target, int decodedLength ) {
+		if( codec->Decode(IntPtr(const_cast<uint8_t*>(value + HeaderSize)), length - HeaderSize, IntPtr(target), decodedLength) != decodedLength ) {
+			throw gcnew InvalidDataException( String::Format(L"Invalid encoded cell value (codec {0})", codec->Id) );
+		}
+	}
+
+	int ValueCodecMap::Escape( const uint8_t* value, int length, cli::array<Byte>^% buffer ) {
+		Rent( buffer, HeaderSize + length );
+		pin_ptr<Byte> pb = &buffer[0];
+		uint8_t* p = pb;
+		WriteHeader( p, 0, length );
+		memcpy( p + HeaderSize, value, length );
+		return HeaderSize + length;
+	}
+
+	void ValueCodecMap::WriteHeader( uint8_t* p, Byte id, int length ) {
+		p[0] = 0x00;
+		p[1] = 'H';
+		p[2] = 'Z';
+		p[3] = id;
+		p[4] = static_cast<uint8_t>( length );
+		p[5] = static_cast<uint8_t>( length >> 8 );
+		p[6] = static_cast<uint8_t>( length >> 16 );
+		p[7] = static_cast<uint8_t>( length >> 24 );
+	}
+
+	void ValueCodecMap::Rent( cli::array<Byte>^% buffer, int capacity ) {
+		if( buffer == nullptr || buffer->Length < capacity ) {
+			Release( buffer );
+			buffer = ArrayPool<Byte>::Shared->Rent( capacity );
+		}
+	}
+
+	void ValueCodecMap::Release( cli::array<Byte>^% buffer ) {
+		if( buffer != nullptr ) {
+			ArrayPool<Byte>::Shared->Return( buffer );
+			buffer = nullptr;
+		}
+	}
+
+	ValueCodecMap::ValueCodecMap( Dictionary<String^, IValueCodec^>^ _codecs )
+	: codecs( _codecs )
+	, codecsById( gcnew cli::array<IValueCodec^>(256) )
+	{
+		for each( IValueCodec^ codec in codecs->Values ) {
+			codecsById[codec->Id] = codec;
+		}
+	}
+
+}
\ No newline at end of file
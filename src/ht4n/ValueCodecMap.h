@@ -0,0 +1,95 @@
+/** -*- C++ -*-
+ * Copyright (C) 2010-2016 Thalmann Software & Consulting, http://www.softdev.ch
+ *
+ * This file is part of ht4n.
+ *
+ * ht4n is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or any later version.
+ *
+ * Hypertable is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+
+#pragma once
+
+#ifndef __cplusplus_cli
+#error "requires /clr"
+#endif
+
+namespace Hypertable {
+	using namespace System;
+	using namespace System::Collections::Generic;
+
+	interface class IValueCodec;
+
+	/// <summary>
+	/// Maps column families to value codecs, encodes and decodes the value header.
+	/// </summary>
+	/// <remarks>
+	/// Encoded values are prefixed by an 8 byte header, 0x00 'H' 'Z', the codec identifier
+	/// and the decoded length (little endian). Raw values starting with 0x00 'H' 'Z' are escaped
+	/// by the reserved codec identifier zero. Values without a valid header, values of column
+	/// families without a codec, values encoded by an unknown codec and values with a decoded
+	/// length exceeding the maximum decoded length of the codec are read verbatim.
+	/// </remarks>
+	ref class ValueCodecMap sealed {
+
+		internal:
+
+			/// <summary>
+			/// Creates a value codec map, returns null if no value codec has been specified.
+			/// </summary>
+			static ValueCodecMap^ Create( IDictionary<String^, IValueCodec^>^ valueCodecs );
+
+			/// <summary>
+			/// Returns the value codec for the column family specified, null if values are passed verbatim.
+			/// </summary>
+			IValueCodec^ Get( String^ columnFamily );
+
+			/// <summary>
+			/// Encodes the value into the pooled buffer specified, returns the encoded length including
+			/// the header or zero if the value should be passed verbatim.
+			/// </summary>
+			static int Encode( IValueCodec^ codec, const uint8_t* value, int length, cli::array<Byte>^% buffer );
+
+			/// <summary>
+			/// Returns the value codec if the value has been encoded, otherwise null.
+			/// </summary>
+			IValueCodec^ GetEncoded( String^ columnFamily, const uint8_t* value, int length, int% decodedLength );
+
+			/// <summary>
+			/// Decodes the value into the target specified.
+			/// </summary>
+			static void Decode( IValueCodec^ codec, const uint8_t* value, int length, uint8_t* target, int decodedLength );
+
+			/// <summary>
+			/// Returns the pooled buffer.
+			/// </summary>
+			static void Release( cli::array<Byte>^% buffer );
+
+			literal int HeaderSize = 8;
+			literal int MinLength = 64;
+
+		private:
+
+			ValueCodecMap( Dictionary<String^, IValueCodec^>^ codecs );
+
+			static int Escape( const uint8_t* value, int length, cli::array<Byte>^% buffer );
+			static void WriteHeader( uint8_t* p, Byte id, int length );
+			static void Rent( cli::array<Byte>^% buffer, int capacity );
+
+			Dictionary<String^, IValueCodec^>^ codecs;
+			cli::array<IValueCodec^>^ codecsById;
+	};
+
+}
\ No newline at end of file